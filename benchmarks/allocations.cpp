@@ -0,0 +1,39 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+//==============================================================================================================================
+// 
+// The global allocation functions are replaced in this translation unit, so that compilers do not inline them into the
+// benchmarks and do not match memory allocated by operator new against memory freed by std::free.
+// 
+std::atomic<size_t> g_allocationsCount(0);
+std::atomic<size_t> g_allocatedBytes  (0);
+
+
+//==============================================================================================================================
+void *operator new(size_t _size)
+{
+    g_allocationsCount.fetch_add(1,     std::memory_order_relaxed);
+    g_allocatedBytes  .fetch_add(_size, std::memory_order_relaxed);
+
+    if (void *pointer = std::malloc(_size != 0 ? _size : 1))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+
+//==============================================================================================================================
+void operator delete(void *_pointer) noexcept
+{
+    std::free(_pointer);
+}
+
+
+//==============================================================================================================================
+void operator delete(void *_pointer, size_t) noexcept
+{
+    std::free(_pointer);
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+
+//==============================================================================================================================
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+//==============================================================================================================================
+const size_t ROUNDS_COUNT = 5;
+
+
+//==============================================================================================================================
+// 
+// Counters of allocations made by the global operator new, which is replaced in allocations.cpp.
+// 
+extern std::atomic<size_t> g_allocationsCount;
+extern std::atomic<size_t> g_allocatedBytes;
+
+
+//==============================================================================================================================
+struct Allocations
+{
+    size_t count;
+    size_t bytes;
+};
+
+
+//==============================================================================================================================
+// 
+// Sink that pointers to results are stored into, so that compilers do not discard computing them.
+// 
+void const * volatile g_sink = nullptr;
+
+
+//==============================================================================================================================
+void do_not_optimize(void const *_pointer)
+{
+    g_sink = _pointer;
+}
+
+
+//==============================================================================================================================
+template <typename _Operation>
+double measure(size_t _iterations, _Operation &&_operation)
+{
+    double best = std::numeric_limits<double>::max();
+
+    for (size_t i = 0; i != _iterations / 10 + 1; ++i)
+        _operation();
+
+    for (size_t round = 0; round != ROUNDS_COUNT; ++round)
+    {
+        auto const start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i != _iterations; ++i)
+            _operation();
+
+        auto const duration = std::chrono::steady_clock::now() - start;
+
+        best = std::min(best, std::chrono::duration<double, std::nano>(duration).count() / _iterations);
+    }
+
+    return best;
+}
+
+
+//==============================================================================================================================
+template <typename _Operation>
+Allocations count_allocations(_Operation &&_operation)
+{
+    size_t const count = g_allocationsCount.load();
+    size_t const bytes = g_allocatedBytes  .load();
+
+    _operation();
+
+    return Allocations({ g_allocationsCount.load() - count, g_allocatedBytes.load() - bytes });
+}
+
+
+//==============================================================================================================================
+// 
+// Format of the reported results: aligned text for reading, CSV or JSON Lines for tracking results across versions.
+// 
+enum class Format
+{
+    TEXT,
+    CSV,
+    JSON,
+};
+
+
+//==============================================================================================================================
+// 
+// Options given by the command line.
+// 
+struct Options
+{
+    Format                         format    = Format::TEXT;
+    std::string                    filter;                    // Runs only benchmarks whose names contain it.
+    std::map<std::string, double>  baseline;                  // Results of a previous run by their names and units.
+    double                         tolerance = 10.0;          // Percent a result may exceed its baseline by.
+};
+
+Options g_options;
+
+
+//==============================================================================================================================
+// 
+// Results that exceed their baselines by more than the tolerance.
+// 
+std::vector<std::string> g_regressions;
+
+
+//==============================================================================================================================
+// 
+// Returns the string quoted for CSV and JSON. Names of results contain no quotes or backslashes.
+// 
+std::string quoted(std::string const &_string)
+{
+    return "\"" + _string + "\"";
+}
+
+
+//==============================================================================================================================
+// 
+// Reads results of a previous run written in CSV format. Returns false if the file cannot be read.
+// 
+bool load_baseline(std::string const &_path, std::map<std::string, double> &_baseline)
+{
+    std::ifstream file(_path);
+
+    if (!file)
+        return false;
+
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        std::size_t const nameEnd  = line.find("\",", 1);
+        std::size_t const valueEnd = line.find(',', nameEnd + 2);
+
+        if (line.empty() || line[0] != '"' || nameEnd == std::string::npos || valueEnd == std::string::npos)
+            continue;
+
+        std::string unit = line.substr(valueEnd + 1);
+
+        unit.erase(std::remove(unit.begin(), unit.end(), '"' ), unit.end());
+        unit.erase(std::remove(unit.begin(), unit.end(), '\r'), unit.end());
+
+        std::string const value = line.substr(nameEnd + 2, valueEnd - nameEnd - 2);
+
+        _baseline[line.substr(1, nameEnd - 1) + " " + unit] = std::atof(value.c_str());
+    }
+
+    return true;
+}
+
+
+//==============================================================================================================================
+// 
+// Parses the command line:
+// 
+//     benchmarks [--format=text|csv|json] [--filter=<name>] [--baseline=<file.csv>] [--tolerance=<percent>]
+// 
+// Returns false if it is invalid.
+// 
+bool parse_options(int _argc, char *_argv[])
+{
+    for (int i = 1; i != _argc; ++i)
+    {
+        std::string const argument = _argv[i];
+        std::size_t const equals   = argument.find('=');
+        std::string const key      = argument.substr(0, equals);
+        std::string const value    = equals != std::string::npos ? argument.substr(equals + 1) : std::string();
+
+        if (key == "--format" && (value == "text" || value == "csv" || value == "json"))
+            g_options.format = value == "text" ? Format::TEXT : value == "csv" ? Format::CSV : Format::JSON;
+        else if (key == "--filter")
+            g_options.filter = value;
+        else if (key == "--baseline" && load_baseline(value, g_options.baseline))
+            continue;
+        else if (key == "--tolerance" && !value.empty())
+            g_options.tolerance = std::atof(value.c_str());
+        else
+            return false;
+    }
+
+    return true;
+}
+
+
+//==============================================================================================================================
+// 
+// Checks whether the benchmark is selected by the filter.
+// 
+bool selected(std::string const &_benchmark)
+{
+    return _benchmark.find(g_options.filter) != std::string::npos;
+}
+
+
+//==============================================================================================================================
+// 
+// Compares the result with its baseline. Times and allocations are costs, so only results higher than their baselines
+// are regressions.
+// 
+void check(std::string const &_name, double _value, std::string const &_unit)
+{
+    auto const baseline = g_options.baseline.find(_name + " " + _unit);
+
+    if (baseline == g_options.baseline.end() || _value <= baseline->second * (1.0 + g_options.tolerance / 100.0))
+        return;
+
+    std::ostringstream regression;
+
+    regression << _name << ": " << std::fixed << std::setprecision(2) << _value << " " << _unit << ", baseline "
+               << baseline->second << " " << _unit;
+
+    g_regressions.push_back(regression.str());
+}
+
+
+//==============================================================================================================================
+// 
+// Reports the result. Costs, such as times and allocations, are compared with their baselines.
+// 
+void report(std::string const &_name, double _value, std::string const &_unit = "ns", bool _cost = true)
+{
+    switch (g_options.format)
+    {
+    case Format::TEXT:
+        std::cout << std::left << std::setw(84) << _name << std::right << std::setw(14) << std::fixed
+                  << std::setprecision(2) << _value << " " << _unit << std::endl;
+        break;
+
+    case Format::CSV:
+        std::cout << quoted(_name) << "," << std::fixed << std::setprecision(2) << _value << "," << quoted(_unit)
+                  << std::endl;
+        break;
+
+    case Format::JSON:
+        std::cout << "{\"name\": " << quoted(_name) << ", \"value\": " << std::fixed << std::setprecision(2) << _value
+                  << ", \"unit\": " << quoted(_unit) << "}" << std::endl;
+        break;
+    }
+
+    if (_cost)
+        check(_name, _value, _unit);
+}
+
+
+//==============================================================================================================================
+void report(std::string const &_name, Allocations const &_allocations)
+{
+    report(_name + ", allocations", static_cast<double>(_allocations.count), "");
+    report(_name + ", allocated",   static_cast<double>(_allocations.bytes), "bytes");
+}
+
+
+//==============================================================================================================================
+// 
+// Prints the regressions found and returns the exit code of the benchmarks: 0 if there are none, 1 otherwise.
+// 
+int finish()
+{
+    for (std::string const &regression : g_regressions)
+        std::cerr << "regression: " << regression << std::endl;
+
+    return g_regressions.empty() ? 0 : 1;
+}
@@ -0,0 +1,1701 @@
+#include <array>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cws/events.hpp>
+#include "benchmark.hpp"
+
+
+//==============================================================================================================================
+struct Tick
+{
+    size_t value;
+};
+
+
+//==============================================================================================================================
+class Counter
+{
+public:
+    //==========================================================================================================================
+    void on_tick(Tick const &_tick)
+    {
+        sum_ += _tick.value;
+    }
+
+    //==========================================================================================================================
+    size_t const *sum() const
+    {
+        return &sum_;
+    }
+
+private:
+    size_t sum_ = 0;
+};
+
+
+//==============================================================================================================================
+template <size_t _Index>
+struct Event
+{
+};
+
+
+//==============================================================================================================================
+template <size_t _Index>
+void on_event(Event<_Index> const &)
+{
+}
+
+
+//==============================================================================================================================
+const size_t EVENTS_COUNT = 40;
+
+typedef std::make_index_sequence<EVENTS_COUNT>  events_indices_t;
+
+
+//==============================================================================================================================
+template <typename _Backend, typename _Indices>
+struct WideDispatcher;
+
+
+//==============================================================================================================================
+template <typename _Backend, size_t ..._Indices>
+struct WideDispatcher<_Backend, std::index_sequence<_Indices...>>
+{
+    typedef typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>,
+                                                   cws::events::TypesList<Event<_Indices>...>>::type  type;
+};
+
+
+//==============================================================================================================================
+template <typename _Dispatcher, size_t ..._Indices>
+void subscribe(_Dispatcher &_dispatcher, std::index_sequence<_Indices...>)
+{
+    int const expand[] = { (_dispatcher.template add_listener<Event<_Indices>>(&on_event<_Indices>), 0)... };
+
+    (void)expand;
+}
+
+
+//==============================================================================================================================
+typedef cws::events::Dispatcher<Tick>  Signals2Dispatcher;
+
+typedef cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>,
+                                      cws::events::TypesList<Tick>>::type  FlatDispatcher;
+
+typedef cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                      cws::events::BackendType<cws::events::backend::Snapshot>,
+                                      cws::events::TypesList<Tick>>::type  SnapshotDispatcher;
+
+
+//==============================================================================================================================
+template <typename _Dispatcher>
+double dispatch_time(size_t _listenersCount)
+{
+    _Dispatcher          dispatcher;
+    std::vector<Counter> counters(_listenersCount);
+
+    for (auto &counter : counters)
+        dispatcher.template add_listener<Tick>(boost::bind(&Counter::on_tick, &counter, boost::placeholders::_1));
+
+    Tick tick = { 1 };
+
+    double const time = measure(std::max<size_t>(1000000 / std::max<size_t>(_listenersCount, 1), 1000), [&dispatcher, &tick]()
+    {
+        dispatcher.dispatch(tick);
+    });
+
+    do_not_optimize(counters.data());
+
+    return time;
+}
+
+
+//==============================================================================================================================
+void benchmark_backends()
+{
+    for (size_t listenersCount : { 0, 1, 8, 64, 1024 })
+    {
+        std::string const suffix = " (" + std::to_string(listenersCount) + " listeners)";
+
+        report("dispatch, signals2 backend" + suffix, dispatch_time<Signals2Dispatcher>(listenersCount));
+        report("dispatch, flat backend"     + suffix, dispatch_time<FlatDispatcher    >(listenersCount));
+        report("dispatch, snapshot backend" + suffix, dispatch_time<SnapshotDispatcher>(listenersCount));
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Dispatches to listeners tracking their objects managed by std::shared_ptr.
+// 
+template <typename _Dispatcher>
+double dispatch_tracked_time(size_t _listenersCount)
+{
+    _Dispatcher                           dispatcher;
+    std::vector<std::shared_ptr<Counter>> counters;
+
+    for (size_t i = 0; i != _listenersCount; ++i)
+    {
+        counters.push_back(std::make_shared<Counter>());
+        dispatcher.template add_listener<Tick>(&Counter::on_tick, counters.back());
+    }
+
+    Tick tick = { 1 };
+
+    double const time = measure(std::max<size_t>(1000000 / _listenersCount, 1000), [&dispatcher, &tick]()
+    {
+        dispatcher.dispatch(tick);
+    });
+
+    do_not_optimize(counters.front()->sum());
+
+    return time;
+}
+
+
+//==============================================================================================================================
+// 
+// Dispatches to listeners whose lifetime is controlled by ScopedListener.
+// 
+template <typename _Dispatcher>
+double dispatch_scoped_time(size_t _listenersCount)
+{
+    _Dispatcher                                dispatcher;
+    cws::events::ScopedListener<_Dispatcher>   scopedListener(dispatcher);
+    std::vector<Counter>                       counters(_listenersCount);
+
+    for (auto &counter : counters)
+        scopedListener.template add_listener<Tick>(boost::bind(&Counter::on_tick, &counter, boost::placeholders::_1));
+
+    Tick tick = { 1 };
+
+    double const time = measure(std::max<size_t>(1000000 / _listenersCount, 1000), [&dispatcher, &tick]()
+    {
+        dispatcher.dispatch(tick);
+    });
+
+    do_not_optimize(counters.front().sum());
+
+    return time;
+}
+
+
+//==============================================================================================================================
+void benchmark_lifetime()
+{
+    for (size_t listenersCount : { 1, 64 })
+    {
+        std::string const suffix = " (" + std::to_string(listenersCount) + " listeners)";
+
+        report("dispatch, tracked shared objects, signals2 backend" + suffix,
+               dispatch_tracked_time<Signals2Dispatcher>(listenersCount));
+        report("dispatch, scoped listener, signals2 backend"        + suffix,
+               dispatch_scoped_time<Signals2Dispatcher>(listenersCount));
+        report("dispatch, tracked shared objects, flat backend"     + suffix,
+               dispatch_tracked_time<FlatDispatcher>(listenersCount));
+        report("dispatch, scoped listener, flat backend"            + suffix,
+               dispatch_scoped_time<FlatDispatcher>(listenersCount));
+    }
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void benchmark_construction(std::string const &_backend)
+{
+    typedef typename WideDispatcher<_Backend, events_indices_t>::type  dispatcher_t;
+
+    std::string const prefix = "construct and destroy, " + _backend + " backend, " + std::to_string(EVENTS_COUNT) + " events";
+
+    auto const construct = []()
+    {
+        dispatcher_t dispatcher;
+
+        do_not_optimize(&dispatcher);
+    };
+
+    auto const subscribeTwo = []()
+    {
+        dispatcher_t dispatcher;
+
+        subscribe(dispatcher, std::index_sequence<0, EVENTS_COUNT - 1>());
+    };
+
+    auto const subscribeAll = []()
+    {
+        dispatcher_t dispatcher;
+
+        subscribe(dispatcher, events_indices_t());
+    };
+
+    report(prefix + ", no listeners",    measure(1000000, construct));
+    report(prefix + ", no listeners",    count_allocations(construct));
+    report(prefix + ", 2 subscribed",    measure(100000, subscribeTwo));
+    report(prefix + ", 2 subscribed",    count_allocations(subscribeTwo));
+    report(prefix + ", all subscribed",  measure(10000, subscribeAll));
+    report(prefix + ", all subscribed",  count_allocations(subscribeAll));
+
+    dispatcher_t first;
+    dispatcher_t second;
+
+    subscribe(first,  events_indices_t());
+    subscribe(second, events_indices_t());
+
+    auto const move = [&first]()
+    {
+        dispatcher_t moved(std::move(first));
+
+        first = std::move(moved);
+    };
+
+    auto const swap = [&first, &second]()
+    {
+        first.swap(second);
+    };
+
+    std::string const suffix = ", " + _backend + " backend, " + std::to_string(EVENTS_COUNT) + " events, all subscribed";
+
+    report("move there and back" + suffix, measure(1000000, move));
+    report("move there and back" + suffix, count_allocations(move));
+    report("swap"                + suffix, measure(1000000, swap));
+}
+
+
+//==============================================================================================================================
+// 
+// Subscribes and unsubscribes the specified number of distinct listeners, returns time per listener.
+// 
+template <typename _Dispatcher>
+double churn_time_by_listener(size_t _listenersCount)
+{
+    std::vector<Counter> counters(_listenersCount);
+
+    return measure(1, [&counters]()
+    {
+        _Dispatcher dispatcher;
+
+        for (auto &counter : counters)
+            dispatcher.template add_listener<Tick>(boost::bind(&Counter::on_tick, &counter, boost::placeholders::_1));
+
+        for (auto &counter : counters)
+            dispatcher.template remove_listener<Tick>(boost::bind(&Counter::on_tick, &counter, boost::placeholders::_1));
+    }) / _listenersCount;
+}
+
+
+//==============================================================================================================================
+template <typename _Dispatcher>
+double churn_time_by_connection(size_t _listenersCount)
+{
+    std::vector<Counter>                              counters(_listenersCount);
+    std::vector<typename _Dispatcher::connection_t>  connections(_listenersCount);
+
+    return measure(1, [&counters, &connections]()
+    {
+        _Dispatcher dispatcher;
+
+        for (size_t i = 0; i != counters.size(); ++i)
+        {
+            connections[i] = dispatcher.template connect<Tick>(boost::bind(&Counter::on_tick, &counters[i],
+                                                                           boost::placeholders::_1));
+        }
+
+        for (auto const &connection : connections)
+            dispatcher.template remove_listener<Tick>(connection);
+    }) / _listenersCount;
+}
+
+
+//==============================================================================================================================
+void benchmark_churn()
+{
+    for (size_t listenersCount : { 100, 1000, 10000 })
+    {
+        std::string const suffix = " (" + std::to_string(listenersCount) + " listeners)";
+
+        report("subscribe and unsubscribe by listener, signals2 backend"   + suffix,
+               churn_time_by_listener<Signals2Dispatcher>(listenersCount));
+        report("subscribe and unsubscribe by listener, flat backend"       + suffix,
+               churn_time_by_listener<FlatDispatcher>(listenersCount));
+        report("subscribe and unsubscribe by connection, signals2 backend" + suffix,
+               churn_time_by_connection<Signals2Dispatcher>(listenersCount));
+        report("subscribe and unsubscribe by connection, flat backend"     + suffix,
+               churn_time_by_connection<FlatDispatcher>(listenersCount));
+    }
+}
+
+
+//==============================================================================================================================
+struct Tock
+{
+    size_t value;
+};
+
+
+//==============================================================================================================================
+// 
+// Dispatches the specified number of events of two alternating types, returns time per event.
+// 
+template <typename _Dispatcher>
+double immediate_dispatch_time(size_t _eventsCount)
+{
+    _Dispatcher dispatcher;
+    Counter     counter;
+
+    dispatcher.template add_listener<Tick>(boost::bind(&Counter::on_tick, &counter, boost::placeholders::_1));
+    dispatcher.template connect<Tock>([&counter](Tock const &_tock) { counter.on_tick(Tick{ _tock.value }); });
+
+    double const time = measure(100, [&dispatcher, _eventsCount]()
+    {
+        for (size_t i = 0; i != _eventsCount; ++i)
+        {
+            if (i % 2 == 0)
+                dispatcher.dispatch(Tick{ i });
+            else
+                dispatcher.dispatch(Tock{ i });
+        }
+    }) / _eventsCount;
+
+    do_not_optimize(counter.sum());
+
+    return time;
+}
+
+
+//==============================================================================================================================
+// 
+// Enqueues the specified number of events of two alternating types and processes them, returns time per event.
+// 
+template <typename _Dispatcher>
+double deferred_dispatch_time(size_t _eventsCount)
+{
+    _Dispatcher dispatcher;
+    Counter     counter;
+
+    dispatcher.template add_listener<Tick>(boost::bind(&Counter::on_tick, &counter, boost::placeholders::_1));
+    dispatcher.template connect<Tock>([&counter](Tock const &_tock) { counter.on_tick(Tick{ _tock.value }); });
+
+    auto const enqueueAndProcess = [&dispatcher, _eventsCount]()
+    {
+        for (size_t i = 0; i != _eventsCount; ++i)
+        {
+            if (i % 2 == 0)
+                dispatcher.enqueue(Tick{ i });
+            else
+                dispatcher.enqueue(Tock{ i });
+        }
+
+        dispatcher.process();
+    };
+
+    double const time = measure(100, enqueueAndProcess) / _eventsCount;
+
+    report("enqueue and process, flat backend, std::mutex (" + std::to_string(_eventsCount) + " events)",
+           count_allocations(enqueueAndProcess));
+
+    do_not_optimize(counter.sum());
+
+    return time;
+}
+
+
+//==============================================================================================================================
+// 
+// Position of an entity, where only the latest one matters.
+// 
+struct Position
+{
+    size_t entity;
+    size_t value;
+};
+
+
+//==============================================================================================================================
+struct CoalescedPosition
+{
+    size_t entity;
+    size_t value;
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct Coalescing<CoalescedPosition> :
+            CoalescedBy<size_t>
+        {
+            static size_t key(CoalescedPosition const &_position)
+            {
+                return _position.entity;
+            }
+        };
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Enqueues the specified number of positions of 64 entities and processes them, returns time per enqueued event.
+// 
+template <typename _Position>
+double coalescing_time(size_t _eventsCount)
+{
+    typedef typename cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                                   cws::events::BackendType<cws::events::backend::Flat>,
+                                                   cws::events::TypesList<_Position>>::type  dispatcher_t;
+
+    size_t const ENTITIES_COUNT = 64;
+
+    dispatcher_t dispatcher;
+    Counter      counter;
+
+    dispatcher.template connect<_Position>([&counter](_Position const &_position)
+    {
+        counter.on_tick(Tick{ _position.value });
+    });
+
+    double const time = measure(100, [&dispatcher, _eventsCount, ENTITIES_COUNT]()
+    {
+        for (size_t i = 0; i != _eventsCount; ++i)
+            dispatcher.enqueue(_Position{ i % ENTITIES_COUNT, i });
+
+        dispatcher.process();
+    }) / _eventsCount;
+
+    do_not_optimize(counter.sum());
+
+    return time;
+}
+
+
+//==============================================================================================================================
+void benchmark_queue()
+{
+    typedef cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                          cws::events::BackendType<cws::events::backend::Flat>,
+                                          cws::events::TypesList<Tick, Tock>>::type  dispatcher_t;
+
+    for (size_t eventsCount : { 16, 1024 })
+    {
+        std::string const suffix = ", flat backend, std::mutex (" + std::to_string(eventsCount) + " events)";
+
+        report("dispatch immediately"   + suffix, immediate_dispatch_time<dispatcher_t>(eventsCount));
+        report("enqueue and process"    + suffix, deferred_dispatch_time <dispatcher_t>(eventsCount));
+    }
+
+    for (size_t eventsCount : { 1024, 16384 })
+    {
+        std::string const suffix = ", flat backend, std::mutex (" + std::to_string(eventsCount) + " events, 64 keys)";
+
+        report("enqueue and process"            + suffix, coalescing_time<Position         >(eventsCount));
+        report("enqueue and process, coalesced" + suffix, coalescing_time<CoalescedPosition>(eventsCount));
+    }
+}
+
+
+//==============================================================================================================================
+typedef cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                      cws::events::TypesList<Tick>>::type  LockingSignals2Dispatcher;
+
+typedef cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                      cws::events::BackendType<cws::events::backend::Flat>,
+                                      cws::events::TypesList<Tick>>::type  LockingFlatDispatcher;
+
+typedef cws::events::dispatcher::Type<cws::events::MutexType<std::shared_timed_mutex>,
+                                      cws::events::BackendType<cws::events::backend::Flat>,
+                                      cws::events::TypesList<Tick>>::type  SharedLockingFlatDispatcher;
+
+
+//==============================================================================================================================
+// 
+// Listener that can be invoked by several threads at once.
+// 
+void on_shared_tick(Tick const &_tick)
+{
+    static thread_local size_t sum = 0;
+
+    sum += _tick.value;
+
+    do_not_optimize(&sum);
+}
+
+
+//==============================================================================================================================
+// 
+// Dispatches from several threads at once to the same listeners. Returns the time per dispatch of all threads together,
+// which stays the same as threads are added while dispatches do not contend.
+// 
+template <typename _Dispatcher>
+double concurrent_dispatch_time(size_t _threadsCount)
+{
+    size_t const LISTENERS_COUNT  = 8;
+    size_t const DISPATCHES_COUNT = 100000 / _threadsCount;
+
+    _Dispatcher dispatcher;
+
+    for (size_t i = 0; i != LISTENERS_COUNT; ++i)
+        dispatcher.template connect<Tick>(&on_shared_tick);
+
+    return measure(1, [&dispatcher, _threadsCount, DISPATCHES_COUNT]()
+    {
+        std::vector<std::thread> threads;
+
+        for (size_t i = 0; i != _threadsCount; ++i)
+        {
+            threads.emplace_back([&dispatcher, DISPATCHES_COUNT]()
+            {
+                Tick tick = { 1 };
+
+                for (size_t j = 0; j != DISPATCHES_COUNT; ++j)
+                    dispatcher.dispatch(tick);
+            });
+        }
+
+        for (auto &thread : threads)
+            thread.join();
+    }) / (DISPATCHES_COUNT * _threadsCount);
+}
+
+
+//==============================================================================================================================
+void benchmark_threads()
+{
+    report("hardware threads", static_cast<double>(std::thread::hardware_concurrency()), "", false);
+
+    for (size_t threadsCount : { 1, 2, 4, 8, 16, 32, 64 })
+    {
+        std::string const suffix = " (" + std::to_string(threadsCount) + " threads, 8 listeners)";
+
+        report("concurrent dispatch, signals2 backend, std::mutex" + suffix,
+               concurrent_dispatch_time<LockingSignals2Dispatcher>(threadsCount));
+        report("concurrent dispatch, flat backend, std::mutex"     + suffix,
+               concurrent_dispatch_time<LockingFlatDispatcher    >(threadsCount));
+        report("concurrent dispatch, flat backend, std::shared_timed_mutex" + suffix,
+               concurrent_dispatch_time<SharedLockingFlatDispatcher>(threadsCount));
+        report("concurrent dispatch, snapshot backend, std::mutex" + suffix,
+               concurrent_dispatch_time<SnapshotDispatcher       >(threadsCount));
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Event carrying the time it was posted, so that the listener can measure the latency of its delivery.
+// 
+struct Stamp
+{
+    std::chrono::steady_clock::time_point posted;
+};
+
+
+//==============================================================================================================================
+std::atomic<std::uint64_t> g_stampsCount  (0);
+std::atomic<std::uint64_t> g_stampsLatency(0);
+
+
+//==============================================================================================================================
+void on_stamp(Stamp const &_stamp)
+{
+    auto const latency = std::chrono::steady_clock::now() - _stamp.posted;
+
+    g_stampsCount  .fetch_add(1, std::memory_order_relaxed);
+    g_stampsLatency.fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count()),
+                              std::memory_order_relaxed);
+}
+
+
+//==============================================================================================================================
+typedef cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                      cws::events::BackendType<cws::events::backend::Flat>,
+                                      cws::events::TypesList<Stamp>>::type  LockingStampDispatcher;
+
+typedef cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>,
+                                      cws::events::TypesList<Stamp>>::type  StampDispatcher;
+
+
+//==============================================================================================================================
+// 
+// Delivers events from the producer threads to a listener and returns the time per event of all threads together. The
+// average latency from posting an event to invoking the listener is returned by the parameter.
+// 
+// Producers either dispatch events by a dispatcher locking std::mutex, as tutorial_thread_safe.cpp does, or post them to a
+// channel drained by a consumer thread.
+// 
+template <typename _Overflow>
+double delivery_time(size_t _producersCount, bool _channel, double &_latency)
+{
+    size_t const EVENTS_COUNT = 100000 / _producersCount * _producersCount;
+
+    LockingStampDispatcher                                 lockingDispatcher;
+    StampDispatcher                                        dispatcher;
+    cws::events::Channel<StampDispatcher, _Overflow>       channel(dispatcher, 1024);
+
+    lockingDispatcher.add_listener<Stamp>(&on_stamp);
+    dispatcher       .add_listener<Stamp>(&on_stamp);
+
+    g_stampsCount  .store(0);
+    g_stampsLatency.store(0);
+
+    double const time = measure(1, [&lockingDispatcher, &channel, _producersCount, _channel, EVENTS_COUNT]()
+    {
+        std::atomic<size_t>       running(_producersCount);
+        std::vector<std::thread>  producers;
+
+        for (size_t i = 0; i != _producersCount; ++i)
+        {
+            producers.emplace_back([&lockingDispatcher, &channel, &running, _channel, EVENTS_COUNT, _producersCount]()
+            {
+                for (size_t j = 0; j != EVENTS_COUNT / _producersCount; ++j)
+                {
+                    if (_channel)
+                        channel.try_post(Stamp{ std::chrono::steady_clock::now() });
+                    else
+                        lockingDispatcher.dispatch(Stamp{ std::chrono::steady_clock::now() });
+                }
+
+                --running;
+            });
+        }
+
+        while (_channel && running.load() != 0)
+        {
+            if (channel.drain() == 0)
+                std::this_thread::yield();
+        }
+
+        for (auto &producer : producers)
+            producer.join();
+
+        channel.drain();
+    }) / EVENTS_COUNT;
+
+    _latency = static_cast<double>(g_stampsLatency.load()) /
+               static_cast<double>(std::max<std::uint64_t>(g_stampsCount.load(), 1));
+
+    return time;
+}
+
+
+//==============================================================================================================================
+// 
+// Run it on several cores to see the contention of producers.
+// 
+void benchmark_channel()
+{
+    report("hardware threads", static_cast<double>(std::thread::hardware_concurrency()), "", false);
+
+    for (size_t producersCount : { 1, 2, 4 })
+    {
+        std::string const suffix = ", flat backend (" + std::to_string(producersCount) + " producers)";
+
+        double latency = 0;
+
+        report("deliver by dispatch, std::mutex" + suffix,
+               delivery_time<cws::events::overflow::Block>(producersCount, false, latency));
+        report("deliver by dispatch, std::mutex, latency" + suffix, latency);
+        report("deliver by channel, overflow::Block" + suffix,
+               delivery_time<cws::events::overflow::Block>(producersCount, true, latency));
+        report("deliver by channel, overflow::Block, latency" + suffix, latency);
+        report("deliver by channel, overflow::DropOldest" + suffix,
+               delivery_time<cws::events::overflow::DropOldest>(producersCount, true, latency));
+        report("deliver by channel, overflow::DropOldest, latency" + suffix, latency);
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Streams events from one producer thread through a channel to a consumer thread draining them in batches, and returns the
+// time per event.
+// 
+template <typename _Producers>
+double pipeline_time(size_t _batch)
+{
+    size_t const EVENTS_COUNT = 1000000;
+
+    FlatDispatcher dispatcher;
+    Counter        counter;
+
+    dispatcher.add_listener<Tick>(boost::bind(&Counter::on_tick, &counter, boost::placeholders::_1));
+
+    cws::events::Channel<FlatDispatcher, cws::events::overflow::Block, _Producers> channel(dispatcher, 4096);
+
+    double const time = measure(1, [&channel, _batch, EVENTS_COUNT]()
+    {
+        std::thread producer([&channel, EVENTS_COUNT]()
+        {
+            for (size_t i = 0; i != EVENTS_COUNT; ++i)
+                channel.try_post(Tick{ i });
+        });
+
+        for (size_t drained = 0; drained != EVENTS_COUNT; )
+        {
+            size_t const count = channel.drain(_batch);
+
+            if (count == 0)
+                std::this_thread::yield();
+
+            drained += count;
+        }
+
+        producer.join();
+    }) / EVENTS_COUNT;
+
+    do_not_optimize(counter.sum());
+
+    return time;
+}
+
+
+//==============================================================================================================================
+// 
+// Run it on two cores to see the throughput of a pipeline without compare-and-swap.
+// 
+void benchmark_pipeline()
+{
+    report("hardware threads", static_cast<double>(std::thread::hardware_concurrency()), "", false);
+
+    for (size_t batch : { 1, 64, 1024 })
+    {
+        std::string const suffix = ", flat backend (batch " + std::to_string(batch) + ")";
+
+        double const multiple = pipeline_time<cws::events::producers::Multiple>(batch);
+        double const single   = pipeline_time<cws::events::producers::Single  >(batch);
+
+        report("pipeline, producers::Multiple" + suffix, multiple);
+        report("pipeline, producers::Multiple, throughput" + suffix, 1000 / multiple, "M/s", false);
+        report("pipeline, producers::Single" + suffix, single);
+        report("pipeline, producers::Single, throughput" + suffix, 1000 / single, "M/s", false);
+    }
+}
+
+
+//==============================================================================================================================
+typedef cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                      cws::events::BackendType<cws::events::backend::Snapshot>,
+                                      cws::events::ExecutorType<cws::events::executor::Pool>,
+                                      cws::events::TypesList<Tick>>::type  PoolDispatcher;
+
+
+//==============================================================================================================================
+// 
+// Listener that takes about the given number of microseconds.
+// 
+template <size_t _Microseconds>
+void on_slow_tick(Tick const &_tick)
+{
+    auto const finish = std::chrono::steady_clock::now() + std::chrono::microseconds(_Microseconds);
+
+    while (std::chrono::steady_clock::now() < finish)
+        on_shared_tick(_tick);
+}
+
+
+//==============================================================================================================================
+// 
+// Returns the time the dispatching thread spends per event, and reports the time per event until all listeners are done.
+// 
+template <size_t _Microseconds>
+double async_dispatch_time(size_t _eventsCount)
+{
+    PoolDispatcher dispatcher;
+
+    dispatcher.template connect<Tick>(&on_slow_tick<_Microseconds>);
+
+    std::vector<std::future<void>> futures;
+
+    futures.reserve(_eventsCount);
+
+    double submitted = std::numeric_limits<double>::max();
+
+    double const completed = measure(1, [&dispatcher, &futures, &submitted, _eventsCount]()
+    {
+        auto const start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i != _eventsCount; ++i)
+            futures.push_back(dispatcher.dispatch_async(Tick{ i }));
+
+        submitted = std::min(submitted,
+                             std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+
+        for (auto &future : futures)
+            future.get();
+
+        futures.clear();
+    }) / _eventsCount;
+
+    report("dispatch_async until completed, snapshot backend, executor::Pool (" + std::to_string(_Microseconds) +
+           " us listener)", completed);
+
+    return submitted / _eventsCount;
+}
+
+
+//==============================================================================================================================
+template <size_t _Microseconds>
+double sync_dispatch_time(size_t _eventsCount)
+{
+    SnapshotDispatcher dispatcher;
+
+    dispatcher.template connect<Tick>(&on_slow_tick<_Microseconds>);
+
+    return measure(1, [&dispatcher, _eventsCount]()
+    {
+        for (size_t i = 0; i != _eventsCount; ++i)
+            dispatcher.dispatch(Tick{ i });
+    }) / _eventsCount;
+}
+
+
+//==============================================================================================================================
+void benchmark_async()
+{
+    size_t const EVENTS_COUNT = 1000;
+
+    report("dispatch, snapshot backend (0 us listener)", sync_dispatch_time<0>(EVENTS_COUNT));
+    report("dispatch_async submission, snapshot backend, executor::Pool (0 us listener)", async_dispatch_time<0>(EVENTS_COUNT));
+
+    report("dispatch, snapshot backend (10 us listener)", sync_dispatch_time<10>(EVENTS_COUNT));
+    report("dispatch_async submission, snapshot backend, executor::Pool (10 us listener)",
+           async_dispatch_time<10>(EVENTS_COUNT));
+}
+
+
+//==============================================================================================================================
+template <size_t _Microseconds, typename _Dispatcher>
+double parallel_dispatch_time(size_t _listenersCount, bool _parallel)
+{
+    _Dispatcher dispatcher;
+
+    for (size_t i = 0; i != _listenersCount; ++i)
+        dispatcher.template connect<Tick>(&on_slow_tick<_Microseconds>);
+
+    return measure(10, [&dispatcher, _parallel]()
+    {
+        if (_parallel)
+            dispatcher.dispatch_parallel(Tick{ 1 });
+        else
+            dispatcher.dispatch(Tick{ 1 });
+    });
+}
+
+
+//==============================================================================================================================
+// 
+// Run it under taskset or a similar tool to see the scaling by the number of cores.
+// 
+void benchmark_parallel()
+{
+    report("hardware threads", static_cast<double>(std::thread::hardware_concurrency()), "", false);
+
+    for (size_t listenersCount : { 1, 4, 16, 64, 256 })
+    {
+        std::string const suffix = ", snapshot backend, executor::Pool (" + std::to_string(listenersCount) +
+                                   " listeners, 10 us each)";
+
+        report("dispatch"          + suffix, parallel_dispatch_time<10, PoolDispatcher>(listenersCount, false));
+        report("dispatch_parallel" + suffix, parallel_dispatch_time<10, PoolDispatcher>(listenersCount, true ));
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Returns the time per event of dispatching a packet of ticks one by one or as a batch.
+// 
+template <typename _Dispatcher>
+double batch_dispatch_time(size_t _eventsCount, bool _batch)
+{
+    size_t const LISTENERS_COUNT = 4;
+
+    _Dispatcher       dispatcher;
+    std::vector<Tick> ticks(_eventsCount, Tick{ 1 });
+
+    for (size_t i = 0; i != LISTENERS_COUNT; ++i)
+        dispatcher.template connect<Tick>(&on_shared_tick);
+
+    return measure(100, [&dispatcher, &ticks, _batch]()
+    {
+        if (_batch)
+        {
+            dispatcher.dispatch_batch(ticks.data(), ticks.data() + ticks.size());
+        }
+        else
+        {
+            for (Tick const &tick : ticks)
+                dispatcher.dispatch(tick);
+        }
+    }) / _eventsCount;
+}
+
+
+//==============================================================================================================================
+void benchmark_batch()
+{
+    size_t const EVENTS_COUNT = 1000;
+
+    std::string const suffix = " (" + std::to_string(EVENTS_COUNT) + " events, 4 listeners)";
+
+    report("dispatch loop, signals2 backend, std::mutex" + suffix,
+           batch_dispatch_time<LockingSignals2Dispatcher>(EVENTS_COUNT, false));
+    report("dispatch_batch, signals2 backend, std::mutex" + suffix,
+           batch_dispatch_time<LockingSignals2Dispatcher>(EVENTS_COUNT, true ));
+    report("dispatch loop, flat backend, std::mutex" + suffix,
+           batch_dispatch_time<LockingFlatDispatcher    >(EVENTS_COUNT, false));
+    report("dispatch_batch, flat backend, std::mutex" + suffix,
+           batch_dispatch_time<LockingFlatDispatcher    >(EVENTS_COUNT, true ));
+    report("dispatch loop, snapshot backend, std::mutex" + suffix,
+           batch_dispatch_time<SnapshotDispatcher       >(EVENTS_COUNT, false));
+    report("dispatch_batch, snapshot backend, std::mutex" + suffix,
+           batch_dispatch_time<SnapshotDispatcher       >(EVENTS_COUNT, true ));
+}
+
+
+//==============================================================================================================================
+struct Message
+{
+    std::string text;
+};
+
+
+//==============================================================================================================================
+// 
+// Returns the time of dispatching a formatted message to no listeners, constructing it eagerly or lazily.
+// 
+template <typename _Backend>
+double lazy_dispatch_time(bool _lazy)
+{
+    typename cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>, cws::events::BackendType<_Backend>,
+                                           cws::events::TypesList<Message>>::type  dispatcher;
+
+    size_t value = 0;
+
+    auto const format = [&value]() { return Message{ "value: " + std::to_string(++value) + " of many values" }; };
+
+    return measure(100000, [&dispatcher, &format, _lazy]()
+    {
+        if (_lazy)
+            dispatcher.template dispatch_lazy<Message>(format);
+        else
+            dispatcher.dispatch(format());
+    });
+}
+
+
+//==============================================================================================================================
+void benchmark_lazy()
+{
+    std::string const suffix = ", std::mutex (0 listeners)";
+
+    report("dispatch formatted, signals2 backend"      + suffix, lazy_dispatch_time<cws::events::backend::Signals2>(false));
+    report("dispatch_lazy formatted, signals2 backend" + suffix, lazy_dispatch_time<cws::events::backend::Signals2>(true ));
+    report("dispatch formatted, flat backend"          + suffix, lazy_dispatch_time<cws::events::backend::Flat    >(false));
+    report("dispatch_lazy formatted, flat backend"     + suffix, lazy_dispatch_time<cws::events::backend::Flat    >(true ));
+    report("dispatch formatted, snapshot backend"      + suffix, lazy_dispatch_time<cws::events::backend::Snapshot>(false));
+    report("dispatch_lazy formatted, snapshot backend" + suffix, lazy_dispatch_time<cws::events::backend::Snapshot>(true ));
+}
+
+
+//==============================================================================================================================
+size_t g_staticSum = 0;
+
+
+//==============================================================================================================================
+// 
+// Hashes the tick into the sum, so that the compiler cannot fold the calls into a closed form.
+// 
+template <size_t _Factor>
+void on_static_tick(Tick const &_tick)
+{
+    g_staticSum = g_staticSum * 31 + _tick.value * _Factor;
+}
+
+
+//==============================================================================================================================
+typedef cws::events::StaticDispatcher<cws::events::TypesList<Tick>,
+                                      cws::events::static_listener::Function<void (*)(Tick const &), &on_static_tick<1>>,
+                                      cws::events::static_listener::Function<void (*)(Tick const &), &on_static_tick<2>>,
+                                      cws::events::static_listener::Function<void (*)(Tick const &), &on_static_tick<3>>,
+                                      cws::events::static_listener::Function<void (*)(Tick const &), &on_static_tick<4>>>
+    StaticTickDispatcher;
+
+
+//==============================================================================================================================
+// 
+// Returns the time per event of dispatching ticks to 4 listeners in the specified way.
+// 
+template <typename _Dispatch>
+double static_dispatch_time(_Dispatch &&_dispatch)
+{
+    size_t const EVENTS_COUNT = 1000;
+
+    double const time = measure(1000, [&_dispatch, EVENTS_COUNT]()
+    {
+        for (size_t i = 0; i != EVENTS_COUNT; ++i)
+            _dispatch(Tick{ i });
+    }) / EVENTS_COUNT;
+
+    do_not_optimize(&g_staticSum);
+
+    return time;
+}
+
+
+//==============================================================================================================================
+void benchmark_static()
+{
+    StaticTickDispatcher staticDispatcher;
+    FlatDispatcher       flatDispatcher;
+
+    flatDispatcher.add_listener<Tick>(&on_static_tick<1>);
+    flatDispatcher.add_listener<Tick>(&on_static_tick<2>);
+    flatDispatcher.add_listener<Tick>(&on_static_tick<3>);
+    flatDispatcher.add_listener<Tick>(&on_static_tick<4>);
+
+    report("hand-written calls (4 listeners)", static_dispatch_time([](Tick const &_tick)
+    {
+        on_static_tick<1>(_tick);
+        on_static_tick<2>(_tick);
+        on_static_tick<3>(_tick);
+        on_static_tick<4>(_tick);
+    }));
+
+    report("dispatch, static dispatcher (4 listeners)", static_dispatch_time([&staticDispatcher](Tick const &_tick)
+    {
+        staticDispatcher.dispatch(_tick);
+    }));
+
+    report("dispatch, flat backend (4 listeners)", static_dispatch_time([&flatDispatcher](Tick const &_tick)
+    {
+        flatDispatcher.dispatch(_tick);
+    }));
+}
+
+
+//==============================================================================================================================
+// 
+// Subscribes member functions of the counters by boost::bind or as delegates.
+// 
+template <typename _Dispatcher>
+void subscribe_counters(_Dispatcher &_dispatcher, std::vector<Counter> &_counters, bool _delegates)
+{
+    for (auto &counter : _counters)
+    {
+        if (_delegates)
+            _dispatcher.template add_listener<Tick>(&Counter::on_tick, &counter);
+        else
+            _dispatcher.template add_listener<Tick>(boost::bind(&Counter::on_tick, &counter, boost::placeholders::_1));
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Returns the time of subscribing member functions of the specified number of objects.
+// 
+template <typename _Dispatcher>
+double member_subscribe_time(size_t _listenersCount, bool _delegates)
+{
+    std::vector<Counter> counters(_listenersCount);
+
+    return measure(100, [&counters, _delegates]()
+    {
+        _Dispatcher dispatcher;
+
+        subscribe_counters(dispatcher, counters, _delegates);
+    });
+}
+
+
+//==============================================================================================================================
+// 
+// Returns the time of dispatching an event to member functions of the specified number of objects.
+// 
+template <typename _Dispatcher>
+double member_dispatch_time(size_t _listenersCount, bool _delegates)
+{
+    _Dispatcher          dispatcher;
+    std::vector<Counter> counters(_listenersCount);
+
+    subscribe_counters(dispatcher, counters, _delegates);
+
+    Tick tick = { 1 };
+
+    double const time = measure(10000, [&dispatcher, &tick]()
+    {
+        dispatcher.dispatch(tick);
+    });
+
+    do_not_optimize(counters.front().sum());
+
+    return time;
+}
+
+
+//==============================================================================================================================
+template <typename _Dispatcher>
+void benchmark_delegates(std::string const &_backend)
+{
+    size_t const LISTENERS_COUNT = 100;
+
+    std::string const suffix = ", " + _backend + " backend (" + std::to_string(LISTENERS_COUNT) + " listeners)";
+
+    report("add_listener boost::bind" + suffix, member_subscribe_time<_Dispatcher>(LISTENERS_COUNT, false));
+    report("add_listener delegate"    + suffix, member_subscribe_time<_Dispatcher>(LISTENERS_COUNT, true ));
+    report("dispatch to boost::bind"  + suffix, member_dispatch_time <_Dispatcher>(LISTENERS_COUNT, false));
+    report("dispatch to delegate"     + suffix, member_dispatch_time <_Dispatcher>(LISTENERS_COUNT, true ));
+}
+
+
+//==============================================================================================================================
+size_t g_ticksSum = 0;
+
+
+//==============================================================================================================================
+void on_tick(Tick const &_tick)
+{
+    g_ticksSum += _tick.value;
+}
+
+
+//==============================================================================================================================
+// 
+// Returns the time of dispatching an event to the specified number of free functions.
+// 
+template <typename _Dispatcher>
+double function_dispatch_time(size_t _listenersCount)
+{
+    _Dispatcher dispatcher;
+
+    for (size_t i = 0; i != _listenersCount; ++i)
+        dispatcher.template connect<Tick>(&on_tick);
+
+    Tick tick = { 1 };
+
+    double const time = measure(10000, [&dispatcher, &tick]()
+    {
+        dispatcher.dispatch(tick);
+    });
+
+    do_not_optimize(&g_ticksSum);
+
+    return time;
+}
+
+
+//==============================================================================================================================
+template <typename _Dispatcher>
+void benchmark_listener_kinds(std::string const &_backend)
+{
+    size_t const LISTENERS_COUNT = 100;
+
+    std::string const suffix = ", " + _backend + " backend (" + std::to_string(LISTENERS_COUNT) + " listeners)";
+
+    report("dispatch to free function"          + suffix, function_dispatch_time<_Dispatcher>(LISTENERS_COUNT));
+    report("dispatch to boost::bind member"     + suffix, member_dispatch_time  <_Dispatcher>(LISTENERS_COUNT, false));
+    report("dispatch to delegate member"        + suffix, member_dispatch_time  <_Dispatcher>(LISTENERS_COUNT, true ));
+    report("dispatch to tracked shared objects" + suffix, dispatch_tracked_time <_Dispatcher>(LISTENERS_COUNT));
+}
+
+
+//==============================================================================================================================
+// 
+// Dispatching by a single thread, which never waits for the mutex but still locks it.
+// 
+void benchmark_mutexes()
+{
+    for (size_t listenersCount : { 1, 64 })
+    {
+        std::string const suffix = " (" + std::to_string(listenersCount) + " listeners)";
+
+        report("dispatch, signals2 backend, dummy_mutex"          + suffix,
+               dispatch_time<Signals2Dispatcher         >(listenersCount));
+        report("dispatch, signals2 backend, std::mutex"           + suffix,
+               dispatch_time<LockingSignals2Dispatcher  >(listenersCount));
+        report("dispatch, flat backend, dummy_mutex"              + suffix,
+               dispatch_time<FlatDispatcher             >(listenersCount));
+        report("dispatch, flat backend, std::mutex"               + suffix,
+               dispatch_time<LockingFlatDispatcher      >(listenersCount));
+        report("dispatch, flat backend, std::shared_timed_mutex"  + suffix,
+               dispatch_time<SharedLockingFlatDispatcher>(listenersCount));
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Returns the time of subscribing lambdas capturing 48 bytes and the time of dispatching an event to them.
+// 
+template <typename _Dispatcher>
+std::pair<double, double> storage_times(size_t _listenersCount)
+{
+    std::array<size_t, 5> state = { { 1, 2, 3, 4, 5 } };
+    size_t                sum   = 0;
+
+    auto const listener = [state, &sum](Tick const &_tick)
+    {
+        sum += _tick.value * state[_tick.value % state.size()];
+    };
+
+    double const subscribeTime = measure(100, [&listener, _listenersCount]()
+    {
+        _Dispatcher dispatcher;
+
+        for (size_t i = 0; i != _listenersCount; ++i)
+            dispatcher.template connect<Tick>(listener);
+    });
+
+    _Dispatcher dispatcher;
+
+    for (size_t i = 0; i != _listenersCount; ++i)
+        dispatcher.template connect<Tick>(listener);
+
+    Tick tick = { 1 };
+
+    double const dispatchTime = measure(10000, [&dispatcher, &tick]()
+    {
+        dispatcher.dispatch(tick);
+    });
+
+    do_not_optimize(&sum);
+
+    return std::make_pair(subscribeTime, dispatchTime);
+}
+
+
+//==============================================================================================================================
+void benchmark_storage()
+{
+    typedef cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>, cws::events::StorageType<64>,
+                                          cws::events::TypesList<Tick>>::type  WideFlatDispatcher;
+
+    size_t const LISTENERS_COUNT = 100;
+
+    std::string const suffix = " (" + std::to_string(LISTENERS_COUNT) + " lambdas capturing 48 bytes)";
+
+    auto const narrow = storage_times<FlatDispatcher    >(LISTENERS_COUNT);
+    auto const wide   = storage_times<WideFlatDispatcher>(LISTENERS_COUNT);
+
+    report("connect, flat backend, default storage"  + suffix, narrow.first );
+    report("connect, flat backend, 64-byte storage"  + suffix, wide.first   );
+    report("dispatch, flat backend, default storage" + suffix, narrow.second);
+    report("dispatch, flat backend, 64-byte storage" + suffix, wide.second  );
+}
+
+
+//==============================================================================================================================
+// 
+// Priorities of example_priority_type.cpp, the second one with a declared range.
+// 
+enum class Priority
+{
+    LOW,
+    HIGH
+};
+
+
+//==============================================================================================================================
+enum class BucketedPriority
+{
+    LOW,
+    HIGH
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct PriorityRange<BucketedPriority> :
+            PriorityBounds<BucketedPriority, BucketedPriority::LOW, BucketedPriority::HIGH>
+        {
+        };
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Returns the time of subscribing listeners to the front, to the back, and with both priorities in turn, and the time of
+// dispatching an event to them.
+// 
+template <typename _Backend, typename _Priority>
+std::pair<double, double> priority_times(size_t _listenersCount)
+{
+    typedef typename cws::events::dispatcher::Type<cws::events::PriorityType<_Priority, std::greater<_Priority>>,
+                                                   cws::events::BackendType<_Backend>,
+                                                   cws::events::TypesList<Tick>>::type  dispatcher_t;
+
+    size_t sum = 0;
+
+    auto const listener = [&sum](Tick const &_tick)
+    {
+        sum += _tick.value;
+    };
+
+    auto const subscribe = [&listener, _listenersCount](dispatcher_t &_dispatcher)
+    {
+        for (size_t i = 0; i != _listenersCount; ++i)
+        {
+            switch (i % 4)
+            {
+            case 0:
+                _dispatcher.template connect<Tick>(listener, cws::events::Order::FRONT);
+                break;
+            case 1:
+                _dispatcher.template connect<Tick>(listener);
+                break;
+            case 2:
+                _dispatcher.template connect<Tick>(_Priority::LOW, listener);
+                break;
+            default:
+                _dispatcher.template connect<Tick>(_Priority::HIGH, listener, cws::events::Order::FRONT);
+                break;
+            }
+        }
+    };
+
+    double const subscribeTime = measure(100, [&subscribe]()
+    {
+        dispatcher_t dispatcher;
+
+        subscribe(dispatcher);
+    });
+
+    dispatcher_t dispatcher;
+
+    subscribe(dispatcher);
+
+    Tick tick = { 1 };
+
+    double const dispatchTime = measure(10000, [&dispatcher, &tick]()
+    {
+        dispatcher.dispatch(tick);
+    });
+
+    do_not_optimize(&sum);
+
+    return std::make_pair(subscribeTime, dispatchTime);
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void benchmark_priorities(std::string const &_backend)
+{
+    size_t const LISTENERS_COUNT = 100;
+
+    std::string const suffix = ", " + _backend + " backend (" + std::to_string(LISTENERS_COUNT) + " listeners)";
+
+    auto const compared = priority_times<_Backend, Priority        >(LISTENERS_COUNT);
+    auto const bucketed = priority_times<_Backend, BucketedPriority>(LISTENERS_COUNT);
+
+    report("connect, compared enum priorities" + suffix, compared.first );
+    report("connect, bucketed enum priorities" + suffix, bucketed.first );
+    report("dispatch, compared enum priorities" + suffix, compared.second);
+    report("dispatch, bucketed enum priorities" + suffix, bucketed.second);
+}
+
+
+//==============================================================================================================================
+struct Quote
+{
+    size_t symbol;
+    size_t value;
+};
+
+
+//==============================================================================================================================
+struct RoutedQuote
+{
+    size_t symbol;
+    size_t value;
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct Routing<RoutedQuote> :
+            RoutedBy<size_t>
+        {
+            static size_t key(RoutedQuote const &_quote)
+            {
+                return _quote.symbol;
+            }
+        };
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Subscribes a listener of a symbol, which filters quotes itself.
+// 
+template <typename _Dispatcher>
+void subscribe_symbol(_Dispatcher &_dispatcher, size_t _symbol, size_t &_sum, Quote *)
+{
+    _dispatcher.template connect<Quote>([&_sum, _symbol](Quote const &_quote)
+    {
+        if (_quote.symbol == _symbol)
+            _sum += _quote.value;
+    });
+}
+
+
+//==============================================================================================================================
+// 
+// Subscribes a listener to the topic of a symbol.
+// 
+template <typename _Dispatcher>
+void subscribe_symbol(_Dispatcher &_dispatcher, size_t _symbol, size_t &_sum, RoutedQuote *)
+{
+    _dispatcher.template connect<RoutedQuote>(cws::events::topic(_symbol), [&_sum](RoutedQuote const &_quote)
+    {
+        _sum += _quote.value;
+    });
+}
+
+
+//==============================================================================================================================
+// 
+// Returns the time of dispatching a quote of one symbol to listeners of the specified number of symbols.
+// 
+template <typename _Backend, typename _Quote>
+double topic_dispatch_time(size_t _symbolsCount)
+{
+    typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>,
+                                           cws::events::TypesList<_Quote>>::type  dispatcher;
+
+    size_t sum = 0;
+
+    for (size_t symbol = 0; symbol != _symbolsCount; ++symbol)
+        subscribe_symbol(dispatcher, symbol, sum, static_cast<_Quote *>(nullptr));
+
+    _Quote quote = { 0, 0 };
+
+    double const time = measure(10000, [&dispatcher, &quote, _symbolsCount]()
+    {
+        quote.symbol = ++quote.value % _symbolsCount;
+        dispatcher.dispatch(quote);
+    });
+
+    do_not_optimize(&sum);
+
+    return time;
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void benchmark_topics(std::string const &_backend)
+{
+    for (size_t symbolsCount : { 100, 10000 })
+    {
+        std::string const suffix = ", " + _backend + " backend (" + std::to_string(symbolsCount) + " symbols)";
+
+        report("dispatch, filtering listeners" + suffix, topic_dispatch_time<_Backend, Quote      >(symbolsCount));
+        report("dispatch, topic listeners"     + suffix, topic_dispatch_time<_Backend, RoutedQuote>(symbolsCount));
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Events of a hierarchy derived from Tick, which are dispatched to the listeners of Tick too.
+// 
+struct FailedTick :
+    Tick
+{
+};
+
+
+//==============================================================================================================================
+struct TimedOutTick :
+    FailedTick
+{
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct Hierarchy<FailedTick> :
+            DerivedFrom<Tick>
+        {
+        };
+
+        template <>
+        struct Hierarchy<TimedOutTick> :
+            DerivedFrom<FailedTick>
+        {
+        };
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Returns the time of dispatching an event of the type _Tick by a dispatcher of the hierarchy of ticks, which has a listener
+// of Tick and, if requested, a listener of each derived type.
+// 
+template <typename _Backend, typename _Tick>
+double hierarchy_dispatch_time(bool _derivedListeners)
+{
+    typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>,
+                                           cws::events::TypesList<Tick, FailedTick, TimedOutTick>>::type  dispatcher;
+
+    dispatcher.template connect<Tick>(&on_shared_tick);
+
+    if (_derivedListeners)
+    {
+        dispatcher.template connect<FailedTick  >(&on_shared_tick);
+        dispatcher.template connect<TimedOutTick>(&on_shared_tick);
+    }
+
+    _Tick tick;
+    tick.value = 0;
+
+    return measure(1000000, [&dispatcher, &tick]()
+    {
+        ++tick.value;
+        dispatcher.dispatch(tick);
+    });
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void benchmark_hierarchy(std::string const &_backend)
+{
+    std::string const suffix = ", " + _backend + " backend";
+
+    report("dispatch, base event"                     + suffix, hierarchy_dispatch_time<_Backend, Tick        >(false));
+    report("dispatch, derived event to base listener" + suffix, hierarchy_dispatch_time<_Backend, TimedOutTick>(false));
+    report("dispatch, derived event to all listeners" + suffix, hierarchy_dispatch_time<_Backend, TimedOutTick>(true));
+}
+
+
+//==============================================================================================================================
+// 
+// Returns the time of dispatching an event to listeners by a dispatcher collecting the specified statistics.
+// 
+template <typename _Backend, typename _Stats>
+double stats_dispatch_time(size_t _listenersCount)
+{
+    typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>, cws::events::StatsType<_Stats>,
+                                           cws::events::TypesList<Tick>>::type  dispatcher;
+
+    for (size_t i = 0; i != _listenersCount; ++i)
+        dispatcher.template connect<Tick>(on_shared_tick);
+
+    Tick tick = { 0 };
+
+    return measure(1000000, [&dispatcher, &tick]()
+    {
+        ++tick.value;
+        dispatcher.dispatch(tick);
+    });
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void benchmark_stats(std::string const &_backend)
+{
+    size_t const LISTENERS_COUNT = 4;
+
+    std::string const suffix = ", " + _backend + " backend (" + std::to_string(LISTENERS_COUNT) + " listeners)";
+
+    report("dispatch, stats disabled" + suffix, stats_dispatch_time<_Backend, cws::events::stats::Disabled>(LISTENERS_COUNT));
+    report("dispatch, stats enabled"  + suffix, stats_dispatch_time<_Backend, cws::events::stats::Enabled >(LISTENERS_COUNT));
+    report("dispatch, stats profiled" + suffix, stats_dispatch_time<_Backend, cws::events::stats::Profiled>(LISTENERS_COUNT));
+}
+
+
+//==============================================================================================================================
+// 
+// Benchmarks by their names, which the --filter option selects.
+// 
+struct Benchmark
+{
+    char const  *name;
+    void       (*run)();
+};
+
+
+//==============================================================================================================================
+Benchmark const BENCHMARKS[] =
+{
+    { "backends",              []() { benchmark_backends(); } },
+    { "lifetime",              []() { benchmark_lifetime(); } },
+    { "construction/signals2", []() { benchmark_construction<cws::events::backend::Signals2>("signals2"); } },
+    { "construction/flat",     []() { benchmark_construction<cws::events::backend::Flat    >("flat"); } },
+    { "churn",                 []() { benchmark_churn(); } },
+    { "queue",                 []() { benchmark_queue(); } },
+    { "threads",               []() { benchmark_threads(); } },
+    { "mutexes",               []() { benchmark_mutexes(); } },
+    { "channel",               []() { benchmark_channel(); } },
+    { "pipeline",              []() { benchmark_pipeline(); } },
+    { "batch",                 []() { benchmark_batch(); } },
+    { "lazy",                  []() { benchmark_lazy(); } },
+    { "static",                []() { benchmark_static(); } },
+    { "delegates/signals2",    []() { benchmark_delegates<Signals2Dispatcher>("signals2"); } },
+    { "delegates/flat",        []() { benchmark_delegates<FlatDispatcher    >("flat"); } },
+    { "delegates/snapshot",    []() { benchmark_delegates<SnapshotDispatcher>("snapshot"); } },
+    { "listeners/signals2",    []() { benchmark_listener_kinds<Signals2Dispatcher>("signals2"); } },
+    { "listeners/flat",        []() { benchmark_listener_kinds<FlatDispatcher    >("flat"); } },
+    { "storage",               []() { benchmark_storage(); } },
+    { "priorities/signals2",   []() { benchmark_priorities<cws::events::backend::Signals2>("signals2"); } },
+    { "priorities/flat",       []() { benchmark_priorities<cws::events::backend::Flat    >("flat"); } },
+    { "priorities/snapshot",   []() { benchmark_priorities<cws::events::backend::Snapshot>("snapshot"); } },
+    { "topics/flat",           []() { benchmark_topics<cws::events::backend::Flat    >("flat"); } },
+    { "topics/snapshot",       []() { benchmark_topics<cws::events::backend::Snapshot>("snapshot"); } },
+    { "hierarchy/signals2",    []() { benchmark_hierarchy<cws::events::backend::Signals2>("signals2"); } },
+    { "hierarchy/flat",        []() { benchmark_hierarchy<cws::events::backend::Flat    >("flat"); } },
+    { "hierarchy/snapshot",    []() { benchmark_hierarchy<cws::events::backend::Snapshot>("snapshot"); } },
+    { "stats/signals2",        []() { benchmark_stats<cws::events::backend::Signals2>("signals2"); } },
+    { "stats/flat",            []() { benchmark_stats<cws::events::backend::Flat    >("flat"); } },
+    { "stats/snapshot",        []() { benchmark_stats<cws::events::backend::Snapshot>("snapshot"); } },
+    { "async",                 []() { benchmark_async(); } },
+    { "parallel",              []() { benchmark_parallel(); } },
+};
+
+
+//==============================================================================================================================
+int main(int _argc, char *_argv[])
+{
+    if (!parse_options(_argc, _argv))
+    {
+        std::cerr << "usage: benchmarks [--format=text|csv|json] [--filter=<name>] [--baseline=<file.csv>] "
+                     "[--tolerance=<percent>]" << std::endl;
+
+        return 2;
+    }
+
+    for (Benchmark const &benchmark : BENCHMARKS)
+    {
+        if (selected(benchmark.name))
+            benchmark.run();
+    }
+
+    return finish();
+}
@@ -13,9 +13,14 @@
 
 
 //==============================================================================================================================
+#include "events/batch.hpp"
+#include "events/channel.hpp"
+#include "events/delegate.hpp"
 #include "events/details.hpp"
 #include "events/dispatcher.hpp"
 #include "events/dispatcher/type.hpp"
+#include "events/scoped_listener.hpp"
+#include "events/static_dispatcher.hpp"
 
 
 //!
@@ -36,6 +41,12 @@
 //! using build toolchain you need.Also, you need to build.cpp files from ./examples/... so each app and corresponding.txt file
 //! will be located in the tests' working directory.
 //! 
+//! Benchmarks are located in ./benchmarks/benchmarks.cpp. Build it with optimizations enabled and run to measure the library's
+//! hot paths. Run it with --format=csv or --format=json to write results in CSV or JSON Lines for tracking them across
+//! versions, with --filter=<name> to run only some benchmarks, and with --baseline=<file.csv> to compare results with a
+//! previous run: the program lists results exceeding their baselines by more than --tolerance=<percent> (10 by default)
+//! and exits with code 1.
+//! 
 //! @par Supported C++ Standards
 //! C++14
 //! 
@@ -62,8 +73,9 @@
 //! listeners that are managed by boost::shared_ptr and std::shared_ptr classes when the shared object expires.
 //! 
 //! @par Attention
-//! cws::events::Dispatcher class is a boost::signals2 wrapper. It is necessary to have boost libraries installed on your
-//! machine to use this class.
+//! By default, cws::events::Dispatcher class is a boost::signals2 wrapper. It is necessary to have boost libraries installed
+//! on your machine to use this class. A faster backend storing listeners in a contiguous array can be selected with
+//! BackendType.
 //! 
 //! @par Tutorial
 //! @ref tutorial_start_page
@@ -112,6 +124,60 @@
 //! By default, a Dispatcher is not thread-safe. The dispatcher can be used in a multi-threaded environment. Learn more:
 //! @ref tutorial_thread_safe_page
 //! 
+//! Events can also be enqueued with the enqueue or emplace method and dispatched later, in the order they were enqueued, by
+//! the process or process_for method. A thread-safe dispatcher lets any thread enqueue events while one thread processes
+//! them.
+//! 
+//! An event type can be declared coalesced by specializing Coalescing with a key extractor. Then an enqueued event replaces
+//! the pending event with the same key instead of being appended, so that listeners are invoked once per distinct key
+//! for each processing.
+//! 
+//! An event type can be declared routed by specializing Routing with a key extractor. Then listeners subscribe to a topic,
+//! the events with a particular key, by passing topic(key) to add_listener or connect, and a dispatched event invokes
+//! only the listeners of its key together with the listeners subscribed without a topic. backend::Flat and
+//! backend::Snapshot find the listeners of a key by its hash instead of visiting every listener.
+//! 
+//! An event type can declare its base event types by specializing Hierarchy. Then a dispatched event invokes the listeners
+//! of its type and then the listeners of its bases, so that a listener of a base type receives all events derived from it.
+//! The types that an event fans out to are computed at compile time.
+//! 
+//! Channel class delivers events from many threads to one consumer thread without locking: producers post events by the
+//! try_post method into bounded rings, and the consumer dispatches them to the dispatcher's listeners by the drain method,
+//! so the dispatcher needs no mutex. The overflow policy decides whether a producer posting to a full channel waits, or
+//! which event is dropped. A pipeline of one producer thread and one consumer thread can use producers::Single policy,
+//! which posts and drains events without compare-and-swap.
+//! 
+//! The dispatch_async method hands dispatching over to the executor specified by ExecutorType, for example to the built-in
+//! thread pool executor::Pool, and reports completion through a future or a callback.
+//! 
+//! The dispatch_parallel method invokes CPU-heavy listeners of the same priority concurrently by the executor, and finishes
+//! each priority before the next one starts.
+//! 
+//! The dispatch_batch method dispatches a contiguous sequence of events taking the listeners once, and, if Batch of the event
+//! type is one of the dispatcher's events, passes the whole sequence to its listeners.
+//! 
+//! The has_listeners method cheaply checks whether an event has listeners, and the dispatch_lazy method constructs an event
+//! by a factory only if it has.
+//! 
+//! When listeners are known at compile time, StaticDispatcher takes them as template parameters and dispatches events by
+//! direct calls, without memory allocation and locking.
+//! 
+//! The flat and snapshot backends store each listener in place if it fits into the storage specified by StorageType, so
+//! that subscribing lambdas capturing more state needs no memory allocation. Move-only listeners can be subscribed with the
+//! connect method.
+//! 
+//! Memory of the dispatcher, such as arrays of listeners and blocks of the events queue, is allocated by the allocator
+//! specified by AllocatorType, for example one allocating from a memory arena, which is passed to the dispatcher's
+//! constructor.
+//! 
+//! When the range of a priority type is declared by PriorityRange, the flat and snapshot backends order listeners by integer
+//! buckets of the priorities instead of calling the comparator.
+//! 
+//! A dispatcher instantiated with StatsType<stats::Enabled> counts dispatches, listener invocations, and subscriptions of
+//! each event, and records durations of dispatching in a histogram, which the stats method returns. With
+//! StatsType<stats::Profiled> it also times each invocation of each listener, and the top_listeners method returns the
+//! listeners that took the longest, labeled by stats::label function.
+//! 
 
 //! 
 //! @page tutorial_custom_class_page Custom Class As Events Dispatcher
@@ -128,8 +194,9 @@
 
 //! 
 //! @page tutorial_listeners_page Events Listeners
-//! To subscribe a member function to the event, we use boost::bind that wrap a pointer to the member function and a pointer
-//! to an object of the class function is a member into a function object.
+//! To subscribe a member function to the event, we pass a pointer to the member function and a pointer to an object of the
+//! class the function is a member of. They are stored as a Delegate, which needs no memory allocation and is compared with
+//! other listeners in constant time.
 //! 
 //! @par Code
 //! @include{lineno} tutorial_listeners.cpp
@@ -137,7 +204,11 @@
 //! @par Output
 //! @include tutorial_listeners.txt
 //! 
-//! Function object must have overloaded operator ==. \n
+//! A member function can be wrapped into a function object by boost::bind as well. Function object must have overloaded
+//! operator ==. \n
+//! 
+//! Function objects without operator ==, such as lambdas, can be subscribed with the connect method. It returns a connection
+//! that is passed to the remove_listener method to unsubscribe the listener in constant time.
 //! 
 //! Instead of a pointer to an object, std::shared_ptr or boost::shared_ptr can be used. Learn more:
 //! @ref tutorial_shared_listeners
@@ -156,6 +227,10 @@
 //! 
 //! In this case, the listener will automatically unsubscribe when the shared object expires.
 //! 
+//! Tracking a shared object costs locking its weak pointer every time the event is dispatching. An object can own its
+//! subscriptions by a ScopedListener member instead, which unsubscribes all listeners subscribed through it when the object
+//! is destroyed.
+//! 
 
 //! 
 //! @page tutorial_priority_page Listeners' Priority
@@ -201,5 +276,10 @@
 //! @par Possible output
 //! @include tutorial_thread_safe.txt
 //! 
-//! A mutex can be of any default-constructible type with public methods lock() and unlock().
+//! A mutex can be of any default-constructible type with public methods lock() and unlock(). A shared-lockable mutex, such as
+//! std::shared_timed_mutex, lets backend::Flat dispatch events from several threads at once under a shared lock.
+//! 
+//! When events are dispatched by many threads at once and listeners are rarely subscribed or unsubscribed, backend::Snapshot
+//! can be specified through BackendType structure. Its dispatching takes no lock, so that dispatching threads never wait for
+//! each other, while subscribing and unsubscribing are serialized by the mutex and copy listeners of the event.
 //! 
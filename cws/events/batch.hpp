@@ -0,0 +1,129 @@
+// cws::events::Batch class refers to a contiguous sequence of events dispatched at once.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+//! 
+//! @file
+//! 
+#pragma once
+
+
+//==============================================================================================================================
+#include <cstddef>
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Refers to a contiguous sequence of events dispatched by dispatch_batch function.
+        //! 
+        //! Batch class does not own the events. When Batch<_Event> is listed in the dispatcher's events, dispatch_batch
+        //! function dispatches the batch itself as an event after the events of the batch, so that its listeners can process
+        //! all events at once.
+        //! 
+        //! @tparam _Event The type of events.
+        //! 
+        //! @remark Batch class is copyable. The events must outlive Batch object.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_dispatch_batch.cpp
+        //! 
+        //! @par Output
+        //! @include example_dispatch_batch.txt
+        //! 
+        template <typename _Event>
+        class Batch
+        {
+        public:
+            //==================================================================================================================
+            typedef _Event          value_type;  //!< Event type.
+            typedef _Event const *  iterator;    //!< Iterator type.
+
+            //==================================================================================================================
+            //! @brief Instantiates empty batch.
+            Batch() noexcept
+                : first_(nullptr)
+                , last_ (nullptr)
+            {
+            }
+
+            //==================================================================================================================
+            //! @brief Instantiates batch referring to events of [_first, _last) range.
+            Batch(_Event const *_first, _Event const *_last) noexcept
+                : first_(_first)
+                , last_ (_last)
+            {
+            }
+
+            //==================================================================================================================
+            //! @brief Returns iterator to the first event.
+            iterator begin() const noexcept
+            {
+                return first_;
+            }
+
+            //==================================================================================================================
+            //! @brief Returns iterator past the last event.
+            iterator end() const noexcept
+            {
+                return last_;
+            }
+
+            //==================================================================================================================
+            //! @brief Returns pointer to the first event.
+            _Event const *data() const noexcept
+            {
+                return first_;
+            }
+
+            //==================================================================================================================
+            //! @brief Returns the number of events.
+            std::size_t size() const noexcept
+            {
+                return static_cast<std::size_t>(last_ - first_);
+            }
+
+            //==================================================================================================================
+            //! @brief Checks whether the batch has no events.
+            bool empty() const noexcept
+            {
+                return first_ == last_;
+            }
+
+            //==================================================================================================================
+            //! @brief Returns the event at the specified position.
+            _Event const &operator[](std::size_t _index) const noexcept
+            {
+                return first_[_index];
+            }
+
+        private:
+            _Event const *first_;
+            _Event const *last_;
+        };
+
+    }  // namespace events
+
+}  // namespace cws
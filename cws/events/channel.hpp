@@ -0,0 +1,272 @@
+// cws::events::Channel class delivers events posted by any thread to the listeners of a dispatcher in the consumer thread.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+//! 
+//! @file
+//! 
+#pragma once
+
+
+//==============================================================================================================================
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+
+//==============================================================================================================================
+#include "details.hpp"
+#include "overflow.hpp"
+#include "producers.hpp"
+#include "dispatcher/list.hpp"
+#include "dispatcher/ring.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        template <typename _Dispatcher,
+                  typename _Overflow  = overflow::Block,
+                  typename _Producers = producers::Multiple,
+                  typename            = typename _Dispatcher::events_t>
+        class Channel;
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Bounded lock-free channel delivering events from many producer threads to one consumer thread.
+        //! 
+        //! Channel class has a ring of preallocated cells for each event type of the dispatcher. Producers post events by
+        //! try_post function from any thread without locking, and the consumer thread dispatches them to the dispatcher's
+        //! listeners by drain function. Since only the consumer thread uses the dispatcher, it does not need a mutex.
+        //! 
+        //! @tparam _Dispatcher A type of Dispatcher class or a class derived from it.
+        //! @tparam _Overflow A policy from overflow namespace for events posted when the ring of their type is full. The
+        //! default is overflow::Block.
+        //! @tparam _Producers A policy from producers namespace for the number of threads posting events. The default is
+        //! producers::Multiple. With producers::Single, a pipeline of one producer thread and one consumer thread posts
+        //! and drains events without compare-and-swap.
+        //! 
+        //! @remark Channel class is non-copyable, non-moveable. The dispatcher must outlive the channel.
+        //! 
+        //! @remark Events must be nothrow move constructible and not over-aligned.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_channel.cpp
+        //! 
+        //! @par Output
+        //! @include example_channel.txt
+        //! 
+        template <typename _Dispatcher, typename _Overflow, typename _Producers, typename ..._Events>
+        class Channel<_Dispatcher, _Overflow, _Producers, TypesList<_Events...>> :
+            private dispatcher::Rings<_Producers, _Overflow, typename _Dispatcher::allocator_t, _Events...>
+        {
+            typedef dispatcher::Rings<_Producers, _Overflow, typename _Dispatcher::allocator_t, _Events...>  rings_t;
+
+            template <typename _Event>
+            using ring_t = typename dispatcher::RingType<_Producers,
+                                                         _Overflow,
+                                                         typename _Dispatcher::allocator_t,
+                                                         _Event>::type;
+
+        public:
+            //==================================================================================================================
+            typedef _Dispatcher  dispatcher_t;  //!< Dispatcher type.
+            typedef _Overflow    overflow_t;    //!< Overflow policy type.
+            typedef _Producers   producers_t;   //!< Producers policy type.
+
+            //==================================================================================================================
+            //! 
+            //! @brief Constructor.
+            //! 
+            //! Instantiates channel delivering events to listeners of the specified dispatcher. The rings are allocated by
+            //! the dispatcher's allocator.
+            //! 
+            //! @param[in] _dispatcher Reference to the dispatcher.
+            //! @param[in] _capacity Number of events of each type that the channel can hold. It is rounded up to a power
+            //! of two, but not less than two.
+            //! 
+            //! @par Complexity
+            //! Linear in the capacity multiplied by the number of event types.
+            //! 
+            Channel(_Dispatcher &_dispatcher, std::size_t _capacity)
+                : rings_t    (_dispatcher.get_allocator(), _capacity)
+                , dispatcher_(_dispatcher)
+            {
+            }
+
+            //==================================================================================================================
+            //! 
+            //! @{
+            //! 
+            //! @brief Posts event to the channel.
+            //! 
+            //! The event is moved into the ring of its type, so that the consumer thread dispatches it by drain function.
+            //! If the ring is full, the overflow policy of the channel decides what happens.
+            //! 
+            //! @tparam _Event The type of event.
+            //! 
+            //! @param[in] _event Event object.
+            //! 
+            //! @return false if the event is dropped by overflow::DropNewest policy, true otherwise.
+            //! 
+            //! @par Complexity
+            //! Constant, unless the producer waits for room by overflow::Block policy.
+            //! 
+            //! @par Exception safety
+            //! [1] This routine meets the strong exception guarantee, where any exception thrown by the copy constructor of
+            //! the event will cause the event to not be posted.\n
+            //! [2] Will not throw.
+            //! 
+            //! @remark Events can be posted by any thread, but by only one thread at a time with producers::Single policy.
+            //! Events of a type posted by a thread are dispatched in the order they are posted, unless some of them are
+            //! dropped.
+            //! 
+            //! @par Example
+            //! @include{lineno} example_channel.cpp
+            //! 
+            //! @par Output
+            //! @include example_channel.txt
+            //! 
+            template <typename _Event>
+            bool try_post(_Event const &_event)
+            {
+                _Event event(_event);
+
+                return try_post(std::move(event));
+            }
+
+            template <typename _Event, typename = typename std::enable_if<!std::is_reference<_Event>::value>::type>
+            bool try_post(_Event &&_event) noexcept
+            {
+                static_assert(dispatcher::IsOneOf<_Event, _Events...>::value, "The event is not in the events list.");
+
+                return ring_t<_Event>::push(std::move(_event));
+            }
+            //! 
+            //! @}
+            //! 
+
+            //==================================================================================================================
+            //! 
+            //! @{
+            //! 
+            //! @brief Dispatches posted events.
+            //! 
+            //! Dispatches events posted before the call to the dispatcher's listeners. Events of each type are dispatched in
+            //! the order they are posted, and types are drained in the order of the events list.
+            //! 
+            //! [1] Dispatches all of them.\n
+            //! [2] Dispatches not more than the specified number of them.
+            //! 
+            //! @param[in] _count [2] Maximum number of events to dispatch.
+            //! 
+            //! @return The number of dispatched events.
+            //! 
+            //! @par Complexity
+            //! Linear in the number of dispatched events plus listeners' complexity.
+            //! 
+            //! @par Exception safety
+            //! If an exception is thrown by a listener call, the event is removed from the channel, and events after it stay
+            //! in the channel.
+            //! 
+            //! @remark Only one thread at a time can drain the channel, and it must not be drained by listeners. An event
+            //! that is being posted, dropped, or overwritten when the consumer reaches it is left for the next call
+            //! together with the events of its type after it.
+            //! 
+            //! @remark With producers::Single policy, events are drained in batches, and the room of a batch is given back
+            //! to the producer when the batch is dispatched, so limiting the count of a call lets the producer refill the
+            //! channel sooner.
+            //! 
+            //! @par Example
+            //! @include{lineno} example_channel.cpp
+            //! 
+            //! @par Output
+            //! @include example_channel.txt
+            //! 
+            std::size_t drain()
+            {
+                return rings_t::pop(dispatcher_, std::numeric_limits<std::size_t>::max());
+            }
+
+            std::size_t drain(std::size_t _count)
+            {
+                return rings_t::pop(dispatcher_, _count);
+            }
+            //! 
+            //! @}
+            //! 
+
+            //==================================================================================================================
+            //! 
+            //! @brief Returns the number of events of each type that the channel can hold.
+            //! 
+            std::size_t capacity() const noexcept
+            {
+                return rings_t::capacity();
+            }
+
+            //==================================================================================================================
+            //! 
+            //! @{
+            //! 
+            //! @brief Returns the number of events dropped because the channel was full.
+            //! 
+            //! [1] Events of all types.\n
+            //! [2] Events of the specified type.
+            //! 
+            //! @tparam _Event [2] The type of event.
+            //! 
+            //! @return The number of events rejected by overflow::DropNewest, dropped by overflow::DropOldest, or
+            //! overwritten by overflow::Overwrite policy since the channel was constructed.
+            //! 
+            std::uint64_t dropped() const noexcept
+            {
+                return rings_t::dropped();
+            }
+
+            template <typename _Event>
+            std::uint64_t dropped() const noexcept
+            {
+                static_assert(dispatcher::IsOneOf<_Event, _Events...>::value, "The event is not in the events list.");
+
+                return ring_t<_Event>::dropped();
+            }
+            //! 
+            //! @}
+            //! 
+
+        private:
+            Channel           (Channel const &) = delete;
+            Channel &operator=(Channel const &) = delete;
+
+        private:
+            _Dispatcher &dispatcher_;
+        };
+
+    }  // namespace events
+
+}  // namespace cws
@@ -0,0 +1,220 @@
+// cws::events::Delegate class is a trivially copyable listener invoking a member function of an object or a function.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+//! 
+//! @file
+//! 
+#pragma once
+
+
+//==============================================================================================================================
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+
+//==============================================================================================================================
+#include <boost/bind/bind.hpp>
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+            template <typename _Event, std::size_t _Size, typename _Allocator>
+            class Listener;
+        }
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Listener that invokes a member function of an object or a function.
+        //! 
+        //! Delegate class stores a pointer to object with a pointer to its member function, or a pointer to function. Unlike
+        //! a function object made by boost::bind, it is trivially copyable, so that flat and snapshot backends store it in
+        //! place without memory allocation, and it is compared with another delegate in constant time. The add_listener and
+        //! remove_listener functions taking a pointer to member function and a pointer to object use Delegate class.
+        //! 
+        //! @tparam _Event The type of event that the delegate listens to.
+        //! 
+        //! @remark Delegates are equal when they invoke the same member function of the same object, or the same function.
+        //! The object must outlive the subscription.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_delegate.cpp
+        //! 
+        //! @par Output
+        //! @include example_delegate.txt
+        //! 
+        template <typename _Event>
+        class Delegate
+        {
+            // 
+            // A pointer to member function of an incomplete class has the largest size of pointers to member functions.
+            // 
+            struct Unknown;
+
+            typedef void (Unknown::*method_t)();
+
+            typedef typename std::aligned_storage<sizeof(method_t), alignof(method_t)>::type  storage_t;
+            typedef void (*invoke_t)(void const *, _Event const &);
+
+            // 
+            // Calls the invoker without calling the delegate, so that the listener makes a single indirect call.
+            // 
+            template <typename, std::size_t, typename>
+            friend class dispatcher::Listener;
+
+        public:
+            //==================================================================================================================
+            //! 
+            //! @brief Instantiates delegate invoking the member function of the object.
+            //! 
+            //! @param[in] _method A pointer to member function that can be called with the event.
+            //! @param[in] _object A pointer to object of the class whose _method is a member or of a class derived from it.
+            //! 
+            template <typename _Method, typename _Class, typename _Object, typename =
+                decltype((std::declval<_Object *>()->*std::declval<_Method _Class::*>())(std::declval<_Event const &>()))>
+            Delegate(_Method _Class::*_method, _Object *_object) noexcept
+                : object_ (const_cast<_Class *>(static_cast<_Class const *>(_object)))
+                , invoke_ (&invoke_method<_Class, _Method _Class::*>)
+                , storage_()
+            {
+                static_assert(sizeof(_method) <= sizeof(storage_t), "The pointer to member function is too large.");
+
+                std::memcpy(&storage_, &_method, sizeof(_method));
+            }
+
+            //==================================================================================================================
+            //! 
+            //! @brief Instantiates delegate invoking the function.
+            //! 
+            //! @param[in] _function A pointer to function that can be called with the event.
+            //! 
+            template <typename _Function, typename = typename std::enable_if<std::is_function<_Function>::value,
+                decltype(std::declval<_Function *>()(std::declval<_Event const &>()))>::type>
+            Delegate(_Function *_function) noexcept
+                : object_ (nullptr)
+                , invoke_ (&invoke_function<_Function *>)
+                , storage_()
+            {
+                static_assert(sizeof(_function) <= sizeof(storage_t), "The pointer to function is too large.");
+
+                std::memcpy(&storage_, &_function, sizeof(_function));
+            }
+
+            //==================================================================================================================
+            //! @brief Invokes the member function or the function.
+            void operator()(_Event const &_event) const
+            {
+                invoke_(this, _event);
+            }
+
+            //==================================================================================================================
+            //! @brief Checks whether delegates invoke the same member function of the same object, or the same function.
+            friend bool operator==(Delegate const &_left, Delegate const &_right) noexcept
+            {
+                return _left.object_ == _right.object_ && _left.invoke_ == _right.invoke_ &&
+                       std::memcmp(&_left.storage_, &_right.storage_, sizeof(storage_t)) == 0;
+            }
+
+            //==================================================================================================================
+            //! @brief Checks whether delegates differ.
+            friend bool operator!=(Delegate const &_left, Delegate const &_right) noexcept
+            {
+                return !(_left == _right);
+            }
+
+        private:
+            //==================================================================================================================
+            template <typename _Class, typename _Pointer>
+            static void invoke_method(void const *_delegate, _Event const &_event)
+            {
+                Delegate const &delegate = *static_cast<Delegate const *>(_delegate);
+
+                _Pointer method;
+
+                std::memcpy(&method, &delegate.storage_, sizeof(method));
+
+                (static_cast<_Class *>(delegate.object_)->*method)(_event);
+            }
+
+            //==================================================================================================================
+            template <typename _Pointer>
+            static void invoke_function(void const *_delegate, _Event const &_event)
+            {
+                _Pointer function;
+
+                std::memcpy(&function, &static_cast<Delegate const *>(_delegate)->storage_, sizeof(function));
+
+                function(_event);
+            }
+
+        private:
+            void      *object_;
+            invoke_t   invoke_;
+            storage_t  storage_;
+        };
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Binds the function to the object. A member function that can be called with the event is bound by Delegate
+            // class, other functions are bound by boost::bind.
+            // 
+            template <typename _Event, typename _Function, typename _Object>
+            inline Delegate<_Event> bind_object(_Function _function, _Object *_object, std::true_type)
+            {
+                return Delegate<_Event>(_function, _object);
+            }
+
+            //==================================================================================================================
+            template <typename _Event, typename _Function, typename _Object>
+            inline auto bind_object(_Function &&_function, _Object *_object, std::false_type)
+            {
+                return boost::bind(std::forward<_Function>(_function), _object, boost::placeholders::_1);
+            }
+
+            //==================================================================================================================
+            template <typename _Event, typename _Function, typename _Object>
+            inline auto bind_object(_Function &&_function, _Object *_object)
+            {
+                return bind_object<_Event>(std::forward<_Function>(_function), _object, std::integral_constant<bool,
+                    std::is_member_function_pointer<typename std::decay<_Function>::type>::value &&
+                    std::is_constructible<Delegate<_Event>, typename std::decay<_Function>::type, _Object *>::value>());
+            }
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
@@ -16,7 +16,11 @@
 
 
 //==============================================================================================================================
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 
 //==============================================================================================================================
@@ -24,6 +28,11 @@
 #include <boost/signals2/detail/slot_groups.hpp>
 
 
+//==============================================================================================================================
+#include "executor.hpp"
+#include "stats.hpp"
+
+
 //==============================================================================================================================
 namespace cws
 {
@@ -102,6 +111,220 @@ namespace cws
         };
 
 
+        //======================================================================================================================
+        //! 
+        //! @brief Declares the range of values of a priority type.
+        //! 
+        //! The primary template declares the priority type unbounded. Specialize PriorityRange for an enumeration or a small
+        //! integer type of priority deriving the specialization from PriorityBounds, so that backend::Flat and
+        //! backend::Snapshot order listeners by the index of a bucket of their priority instead of comparing priorities.
+        //! 
+        //! @tparam _Priority A type of priority that is used for specifying listeners' invocation order.
+        //! 
+        //! @remark The buckets follow the order that the comparator specifies for the values of the range. Subscribing
+        //! with a priority outside the range to backend::Flat or backend::Snapshot throws std::out_of_range, and the
+        //! listener is not subscribed.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_priority_range.cpp
+        //! 
+        //! @par Output
+        //! @include example_priority_range.txt
+        //! 
+        template <typename _Priority>
+        struct PriorityRange
+        {
+            static bool const bounded = false; //!< The priority type has no declared range.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Declares the range [_First, _Last] of values of a priority type.
+        //! 
+        //! Uses as a base of PriorityRange specializations.
+        //! 
+        //! @tparam _Priority An enumeration or an integer type of priority.
+        //! @tparam _First The least value of the range.
+        //! @tparam _Last The greatest value of the range.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        template <typename _Priority, _Priority _First, _Priority _Last>
+        struct PriorityBounds
+        {
+            static_assert(static_cast<long long>(_First) <= static_cast<long long>(_Last), "The range is empty.");
+
+            static bool      const bounded = true;   //!< The priority type has a declared range.
+            static _Priority const first   = _First; //!< The least value of the range.
+            static _Priority const last    = _Last;  //!< The greatest value of the range.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Declares whether enqueued events of a type are coalesced by a key.
+        //! 
+        //! The primary template declares events not coalesced. Specialize Coalescing for an event type deriving the
+        //! specialization from CoalescedBy and defining static function key, which extracts the key from an event, so that
+        //! an event enqueued while an event with the same key is pending replaces the pending one in place instead of
+        //! being appended. Listeners are then invoked once per distinct key for each processing.
+        //! 
+        //! @tparam _Event A type of event.
+        //! 
+        //! @remark The replacing event takes the place of the pending event in the queue. Events that process or
+        //! process_for function has started to dispatch are not pending any more, so an event with their key is appended.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_coalescing.cpp
+        //! 
+        //! @par Output
+        //! @include example_coalescing.txt
+        //! 
+        template <typename _Event>
+        struct Coalescing
+        {
+            static bool const coalesced = false; //!< Events of the type are not coalesced.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Declares events of a type coalesced by a key of the type _Key.
+        //! 
+        //! Uses as a base of Coalescing specializations.
+        //! 
+        //! @tparam _Key A type of key. It must be copy constructible, hashable by std::hash, and equality comparable.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        template <typename _Key>
+        struct CoalescedBy
+        {
+            typedef _Key  key_type; //!< Type of the key.
+
+            static bool const coalesced = true; //!< Events of the type are coalesced.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Declares whether events of a type are routed to listeners by a key.
+        //! 
+        //! The primary template declares events not routed. Specialize Routing for an event type deriving the
+        //! specialization from RoutedBy and defining static function key, which extracts the key from an event, so that
+        //! listeners can subscribe to a topic, the events with a particular key, by passing the key wrapped by topic
+        //! function. An event is dispatched to the listeners of its key and the listeners subscribed without a topic.
+        //! 
+        //! @tparam _Event A type of event.
+        //! 
+        //! @remark backend::Flat and backend::Snapshot index the listeners by hashes of their keys, so dispatching
+        //! invokes the matching listeners without visiting the others. backend::Signals2 tests the key of each event in
+        //! every listener subscribed to a topic, so statistics count those listeners as invoked.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_topics.cpp
+        //! 
+        //! @par Output
+        //! @include example_topics.txt
+        //! 
+        template <typename _Event>
+        struct Routing
+        {
+            static bool const routed = false; //!< Events of the type are not routed.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Declares events of a type routed by a key of the type _Key.
+        //! 
+        //! Uses as a base of Routing specializations.
+        //! 
+        //! @tparam _Key A type of key. It must be copy constructible, hashable by std::hash, and equality comparable.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        template <typename _Key>
+        struct RoutedBy
+        {
+            typedef _Key  key_type; //!< Type of the key.
+
+            static bool const routed = true; //!< Events of the type are routed.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Key of the events a listener subscribes to.
+        //! 
+        //! Uses as a parameter of add_listener, connect, and remove_listener functions of the dispatcher, which
+        //! distinguishes it from a priority. Created by topic function.
+        //! 
+        //! @tparam _Key A type convertible to the key type of the event's Routing specialization.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        template <typename _Key>
+        struct Topic
+        {
+            _Key key; //!< The key.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Makes the topic of the events with the specified key.
+        //! 
+        //! @param[in] _key The key.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        template <typename _Key>
+        inline Topic<typename std::decay<_Key>::type> topic(_Key &&_key)
+        {
+            return Topic<typename std::decay<_Key>::type>{ std::forward<_Key>(_key) };
+        }
+
+
         //======================================================================================================================
         //! 
         //! @brief Specifies the type of mutex that will be used to provide tread safety.
@@ -113,6 +336,11 @@ namespace cws
         //! @remark Default value is boost::signals2::dummy_mutex.This is a fake mutex for use in single-threaded programs,
         //! where locking a real mutex would be useless overhead.
         //! 
+        //! @remark If the mutex also has public lock_shared() and unlock_shared() methods, like std::shared_timed_mutex,
+        //! dispatching with backend::Flat takes a shared lock, so that events are dispatched by several threads at once.
+        //! Subscribing and unsubscribing take an exclusive lock. backend::Signals2 always locks the mutex exclusively, and
+        //! backend::Snapshot dispatches without locking.
+        //! 
         //! @par Header
         //! cws/events.hpp
         //! 
@@ -132,6 +360,233 @@ namespace cws
         };
 
 
+        //======================================================================================================================
+        //! 
+        //! @brief Backends that can be used to store and invoke listeners.
+        //! 
+        namespace backend
+        {
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Listeners are stored and invoked by boost::signals2::signal.
+            //! 
+            //! Supports all features of boost::signals2 including its slots' tracking. This is the default backend.
+            //! 
+            struct Signals2
+            {
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Listeners are stored in a priority-sorted contiguous array of small type-erased invokers.
+            //! 
+            //! Dispatching an event is a linear walk over the array without per-listener locking, connection bodies, and
+            //! combiner invocation.
+            //! 
+            //! @remark Listeners subscribed or unsubscribed while the event is dispatching will take effect from the next
+            //! dispatch of the event.
+            //! 
+            struct Flat
+            {
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Listeners are stored in immutable priority-sorted contiguous arrays dispatched without locking.
+            //! 
+            //! Dispatching an event takes no lock: it walks over the array published by the last subscribing or
+            //! unsubscribing, so that concurrent dispatches of the same event never contend. Subscribing and unsubscribing
+            //! are serialized by the dispatcher's mutex, copy the array and publish the copy. An outdated array is destroyed
+            //! when dispatches that could have started on it are finished.
+            //! 
+            //! @remark Listeners subscribed or unsubscribed while the event is dispatching will take effect from the next
+            //! dispatch of the event. Subscribing and unsubscribing are linear in the number of listeners of the event.
+            //! 
+            struct Snapshot
+            {
+            };
+
+        }  // namespace backend
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Specifies the backend that will be used to store and invoke listeners.
+        //! 
+        //! Uses as a template parameter of Dispatcher class and dispatcher::Type structure.
+        //! 
+        //! @tparam _Backend One of the backend::Signals2, backend::Flat, or backend::Snapshot types.
+        //! 
+        //! @remark Default value is backend::Signals2. Public interface and listeners' invocation order are the same for all
+        //! backends.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_backend_type.cpp
+        //! 
+        //! @par Output
+        //! @include example_backend_type.txt
+        //! 
+        template <typename _Backend = backend::Signals2>
+        struct BackendType
+        {
+            typedef _Backend  type; //!< Backend type provided through template parameter to instantiate struct.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Specifies the executor that will run listeners of asynchronously dispatched events.
+        //! 
+        //! Uses as a template parameter of Dispatcher class and dispatcher::Type structure.
+        //! 
+        //! @tparam _Executor executor::Inline, executor::Pool, or any type satisfying requirements described in executor
+        //! namespace.
+        //! 
+        //! @remark Default value is executor::Inline, which runs listeners in the thread calling dispatch_async function.
+        //! Listeners run by another executor are invoked concurrently with the rest of the dispatcher's users, so the
+        //! dispatcher must be thread-safe.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_dispatch_async.cpp
+        //! 
+        //! @par Possible output
+        //! @include example_dispatch_async.txt
+        //! 
+        template <typename _Executor = executor::Inline>
+        struct ExecutorType
+        {
+            typedef _Executor  type; //!< Executor type provided through template parameter to instantiate struct.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Specifies the size of storage for a listener of backend::Flat and backend::Snapshot backends.
+        //! 
+        //! Uses as a template parameter of Dispatcher class and dispatcher::Type structure.
+        //! 
+        //! A listener is stored in place if it fits into the storage, is nothrow-movable, and is copyable. Otherwise it is
+        //! allocated by the dispatcher's allocator once, and the allocation is shared by copies of the listener. Move-only
+        //! listeners, such as lambdas capturing std::unique_ptr, can be subscribed with the connect function, but they are
+        //! always allocated whatever their size, since both backends copy arrays of listeners: backend::Snapshot on every
+        //! modification, and backend::Flat on modifications while the event is dispatching.
+        //! 
+        //! @tparam _Size Size of the storage in bytes. It is at least the size of a pointer.
+        //! 
+        //! @remark Default value is the size of four pointers, which fits a Delegate. A larger storage avoids allocating
+        //! lambdas capturing more state at the cost of memory per listener. backend::Signals2 stores listeners in
+        //! boost::function, so the storage size is not used.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_storage_type.cpp
+        //! 
+        //! @par Output
+        //! @include example_storage_type.txt
+        //! 
+        template <std::size_t _Size = 4 * sizeof(void *)>
+        struct StorageType
+        {
+            static_assert(_Size >= sizeof(void *), "The storage must fit a pointer.");
+
+            static std::size_t const size = _Size; //!< Size provided through template parameter to instantiate struct.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Specifies the allocator of memory used by the dispatcher.
+        //! 
+        //! Uses as a template parameter of Dispatcher class and dispatcher::Type structure.
+        //! 
+        //! The allocator is rebound to allocate arrays of listeners and listeners not stored in place by backend::Flat and
+        //! backend::Snapshot, the signals of backend::Signals2, blocks of the events queue, and the state shared by
+        //! dispatch_parallel function. A stateful allocator, for example one referring to a memory arena, is passed to the
+        //! dispatcher's constructor.
+        //! 
+        //! @tparam _Allocator A type satisfying the standard Allocator requirements.
+        //! 
+        //! @remark Default value is std::allocator<char>. boost::signals2 allocates its connections and slots on the heap
+        //! regardless of the allocator. Executors allocate tasks of asynchronous dispatching themselves.
+        //! 
+        //! @remark Dispatchers are moved and swapped together with their allocators. Swapping dispatchers whose allocators
+        //! are not equal requires the allocator to propagate on container swap. A dispatcher used by several threads uses
+        //! its allocator concurrently.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_allocator_type.cpp
+        //! 
+        //! @par Output
+        //! @include example_allocator_type.txt
+        //! 
+        template <typename _Allocator = std::allocator<char>>
+        struct AllocatorType
+        {
+            typedef _Allocator  type; //!< Allocator type provided through template parameter to instantiate struct.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Specifies whether the dispatcher collects statistics of its events.
+        //! 
+        //! Uses as a template parameter of Dispatcher class and dispatcher::Type structure.
+        //! 
+        //! For each event of the dispatcher's events list, the dispatcher counts dispatches, listener invocations,
+        //! subscriptions, and unsubscriptions, and records the durations of dispatching in a log-linear histogram. The stats
+        //! function returns the statistics.
+        //! 
+        //! @tparam _Stats stats::Disabled or stats::Enabled.
+        //! 
+        //! @remark Default value is stats::Disabled, with which the dispatcher has no counters, does not read the clock, and
+        //! has no stats function.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_stats_type.cpp
+        //! 
+        //! @par Possible output
+        //! @include example_stats_type.txt
+        //! 
+        template <typename _Stats = stats::Disabled>
+        struct StatsType
+        {
+            typedef _Stats  type; //!< Statistics type provided through template parameter to instantiate struct.
+        };
+
+
         //======================================================================================================================
         //! 
         //! @brief Specifies dispatcher's events list.
@@ -157,6 +612,60 @@ namespace cws
         {
         };
 
+
+        //======================================================================================================================
+        //! 
+        //! @brief Declares the base event types of an event type.
+        //! 
+        //! The primary template declares no bases. Specialize Hierarchy for an event type deriving the specialization
+        //! from DerivedFrom, so that dispatching an event of the type invokes the listeners of the type and then the
+        //! listeners of its bases, their bases, and so on, which receive the event as a reference to their base type.
+        //! 
+        //! @tparam _Event A type of event.
+        //! 
+        //! @remark Event types that the event fans out to are computed at compile time, so dispatching involves no RTTI.
+        //! Each type is visited once even if it is a base of several bases, after all types of the hierarchy derived
+        //! from it. Bases that are not in the events list of the dispatcher are skipped, but their bases are not.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_hierarchy.cpp
+        //! 
+        //! @par Output
+        //! @include example_hierarchy.txt
+        //! 
+        template <typename _Event>
+        struct Hierarchy
+        {
+            typedef TypesList<>  bases_type; //!< The event type has no bases.
+        };
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Declares events of a type derived from the event types _Bases.
+        //! 
+        //! Used as a base of Hierarchy specializations.
+        //! 
+        //! @tparam ..._Bases Direct public base classes of the event type, in the order their listeners are invoked.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        template <typename ..._Bases>
+        struct DerivedFrom
+        {
+            typedef TypesList<_Bases...>  bases_type; //!< The base event types.
+        };
+
     }  // namespace events
 
 }  // namespace cws
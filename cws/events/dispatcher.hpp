@@ -47,6 +47,9 @@ namespace cws
         //! @remark By default, listeners' priority is of type int, and the method to determine the highest priority is
         //! std::less<int>.
         //! 
+        //! @remark Storage for listeners of an event is allocated when the first listener subscribes to the event. Events
+        //! without listeners take neither memory nor time to dispatch.
+        //! 
         //! @par Header
         //! cws/events.hpp
         //! 
@@ -70,7 +73,8 @@ namespace cws
             //! 
             //! @brief Default constructor.
             //! 
-            //! Instantiates object of Dispatcher class according to provided template parameters.
+            //! Instantiates object of Dispatcher class according to provided template parameters. No memory is allocated
+            //! until listeners subscribe to events.
             //! 
             //! @par Complexity
             //! Linear in the number of events.
@@ -144,16 +148,27 @@ namespace cws
         // 
         // To use customizable Dispatcher class in a convenient way use csw::events::dispatcher::Type structure.
         // 
-        template <typename _Mutex, typename _Priority, typename _Comparator, typename ..._Events>
-        class Dispatcher<MutexType<_Mutex>, PriorityType<_Priority, _Comparator>, TypesList<_Events...>> :
-            public dispatcher::base::Type<_Mutex, _Priority, _Comparator, _Events...>::type
+        template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend, typename _Executor,
+                  std::size_t _StorageSize, typename _Allocator, typename _Stats, typename ..._Events>
+        class Dispatcher<MutexType<_Mutex>, PriorityType<_Priority, _Comparator>, BackendType<_Backend>,
+                         ExecutorType<_Executor>, StorageType<_StorageSize>, AllocatorType<_Allocator>, StatsType<_Stats>,
+                         TypesList<_Events...>> :
+            public dispatcher::base::Type<_Mutex, _Priority, _Comparator, _Backend, _Executor, _StorageSize, _Allocator,
+                                          _Stats, _Events...>::type
         {
-            typedef typename dispatcher::base::Type<_Mutex, _Priority, _Comparator, _Events...>::type  base_t;
+            typedef typename dispatcher::base::Type<_Mutex, _Priority, _Comparator, _Backend, _Executor, _StorageSize,
+                                                    _Allocator, _Stats, _Events...>::type  base_t;
 
         public:
             //==================================================================================================================
             Dispatcher() = default;
 
+            //==================================================================================================================
+            explicit Dispatcher(_Allocator const &_allocator)
+                : base_t(_allocator)
+            {
+            }
+
             //==================================================================================================================
             Dispatcher(Dispatcher &&_source) noexcept
                 : base_t(std::move(_source))
@@ -0,0 +1,96 @@
+// cws::events::dispatcher::allocate_object function creates dispatcher's internal objects by the allocator of dispatcher.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <memory>
+#include <utility>
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // The allocator rebound to allocate objects of the specified type.
+            // 
+            template <typename _Type, typename _Allocator>
+            using Rebind = typename std::allocator_traits<_Allocator>::template rebind_alloc<_Type>;
+
+
+            //==================================================================================================================
+            // 
+            // Allocates and constructs an object by the allocator rebound to its type. The memory is deallocated if the
+            // constructor throws.
+            // 
+            template <typename _Type, typename _Allocator, typename ..._Args>
+            inline _Type *allocate_object(_Allocator const &_allocator, _Args &&..._args)
+            {
+                typedef Rebind<_Type, _Allocator>           allocator_t;
+                typedef std::allocator_traits<allocator_t>  traits_t;
+
+                allocator_t allocator(_allocator);
+
+                _Type *object = traits_t::allocate(allocator, 1);
+
+                try
+                {
+                    traits_t::construct(allocator, object, std::forward<_Args>(_args)...);
+                }
+                catch (...)
+                {
+                    traits_t::deallocate(allocator, object, 1);
+                    throw;
+                }
+
+                return object;
+            }
+
+
+            //==================================================================================================================
+            // 
+            // Destroys and deallocates an object created by allocate_object function, if any. The allocator is copied
+            // before the object is destroyed, so it can be a member of the object.
+            // 
+            template <typename _Type, typename _Allocator>
+            inline void deallocate_object(_Allocator const &_allocator, _Type *_object) noexcept
+            {
+                typedef Rebind<_Type, _Allocator>           allocator_t;
+                typedef std::allocator_traits<allocator_t>  traits_t;
+
+                if (_object == nullptr)
+                    return;
+
+                allocator_t allocator(_allocator);
+
+                traits_t::destroy(allocator, _object);
+                traits_t::deallocate(allocator, _object, 1);
+            }
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
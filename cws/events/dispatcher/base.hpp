@@ -13,7 +13,28 @@
 
 
 //==============================================================================================================================
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+//==============================================================================================================================
+#include "../batch.hpp"
+#include "../delegate.hpp"
+#include "fanout.hpp"
 #include "head.hpp"
+#include "lineage.hpp"
+#include "list.hpp"
+#include "meter.hpp"
+#include "queue.hpp"
 #include "tail.hpp"
 
 
@@ -36,18 +57,39 @@ namespace cws
             //! 
             //! @brief Specifies root class in cws::events::Dispatcher's scattered hierarchy.
             //! 
-            template <typename _Mutex, typename _Priority, typename _Comparator, typename ..._Events>
+            template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend, typename _Executor,
+                      std::size_t _StorageSize, typename _Allocator, typename _Stats, typename ..._Events>
             class Base :
-                public Tail<_Mutex, _Priority, _Comparator, _Events...>
+                public  Tail<_Mutex, _Priority, _Comparator, _Backend, _StorageSize, _Allocator, _Events...>,
+                private Meter<_Stats, typename ConnectionType<_Backend>::type, _Allocator, _Events...>
             {
-                typedef Tail<_Mutex, _Priority, _Comparator, _Events...>  tail_t;
-                typedef HeadType<_Mutex, _Priority, _Comparator>          head_type_t;
+                typedef Tail<_Mutex, _Priority, _Comparator, _Backend, _StorageSize, _Allocator, _Events...>  tail_t;
+                typedef HeadType<_Mutex, _Priority, _Comparator, _Backend, _StorageSize, _Allocator>          head_type_t;
+                typedef Meter<_Stats, typename head_type_t::connection_t, _Allocator, _Events...>            meter_t;
 
             public:
                 //==============================================================================================================
                 typedef _Mutex       mutex_t;       //!< Mutex type provided through template parameter to instantiate Dispatcher.
                 typedef _Priority    priority_t;    //!< Priority type provided through template parameter to instantiate Dispatcher.
                 typedef _Comparator  comparator_t;  //!< Comparator type provided through template parameter to instantiate Dispatcher.
+                typedef _Backend     backend_t;     //!< Backend type provided through template parameter to instantiate Dispatcher.
+                typedef _Executor    executor_t;    //!< Executor type provided through template parameter to instantiate Dispatcher.
+
+                //! Size of storage for a listener provided through StorageType to instantiate Dispatcher.
+                static std::size_t const storage_size = _StorageSize;
+
+                //! Allocator type provided through AllocatorType to instantiate Dispatcher.
+                typedef _Allocator  allocator_t;
+
+                //! Statistics type provided through StatsType to instantiate Dispatcher.
+                typedef _Stats  stats_t;
+
+                //! Events list provided through TypesList to instantiate Dispatcher.
+                typedef TypesList<_Events...>  events_t;
+
+                //! Type of connection identifying a subscribed listener. It is boost::signals2::connection for
+                //! backend::Signals2 and dispatcher::Connection for backend::Flat and backend::Snapshot.
+                typedef typename head_type_t::connection_t  connection_t;
 
                 //==============================================================================================================
                 //! 
@@ -74,10 +116,52 @@ namespace cws
                 void swap(Base &_source) noexcept
                 {
                     tail_t::swap(_source);
+                    meter_t::swap(_source);
+
+                    queue_.swap(_source.queue_);
+
+                    using std::swap;
+
+                    swap(executor_, _source.executor_);
+                }
+
+                //==============================================================================================================
+                //! 
+                //! @brief Returns the executor running listeners of asynchronously dispatched events.
+                //! 
+                //! @return Reference to the executor, which can be used to configure it.
+                //! 
+                //! @par Complexity
+                //! Constant.
+                //! 
+                //! @par Exception safety
+                //! Will not throw.
+                //! 
+                _Executor &executor() noexcept
+                {
+                    return executor_;
+                }
+
+                //==============================================================================================================
+                //! 
+                //! @brief Returns the allocator of memory used by the dispatcher.
+                //! 
+                //! @return Copy of the allocator passed to the constructor, or a default-constructed one.
+                //! 
+                //! @par Complexity
+                //! Constant.
+                //! 
+                //! @par Exception safety
+                //! Will not throw.
+                //! 
+                _Allocator get_allocator() const noexcept
+                {
+                    return queue_.get_allocator();
                 }
 
                 //==============================================================================================================
-                #define HEAD_T(_Event) typedef typename head_type_t::template type<_Event>  head_t; head_t
+                #define HEAD_T(_Event) head_type_t::template type<_Event>
+                #define SUBSCRIPTION_T(_Event) typename meter_t::template Subscription<_Event>
 
                 //==============================================================================================================
                 //! 
@@ -90,21 +174,30 @@ namespace cws
                 //! @tparam _Event A type of event that listener is subscribing to.
                 //! @tparam _Callable [1], [2] A type of function object or function.
                 //! @tparam _Function [3] - [6] A type of member function.
-                //! @tparam _Object [3] - [6] A class object whose _Function is a member.
+                //! @tparam _Object [3] - [8] A class object whose _Function or _Method is a member.
+                //! @tparam _Method [7], [8] A type of member function of _Class.
+                //! @tparam _Class [7], [8] A class whose _Method is a member. It is _Object or a base class of _Object.
                 //! 
                 //! @param[in] _priority A value that is used to determine listeners' invocation order.
                 //! @param[in] _callable [1], [2] A reference to function object or pointer/reference to a function that will
                 //! be invoked when an event occurs.
                 //! @param[in] _function [3] - [6] A pointer to a member function that will be invoked when an event occurs.
+                //! @param[in] _method [7], [8] A pointer to a member function that will be invoked when an event occurs.
                 //! @param[in] _object [3], [5] A constant reference to object of std::shared_ptr<_Object> type.\n
-                //! [4], [6] A constant reference to object of boost::shared_ptr<_Object> type.
+                //! [4], [6] A constant reference to object of boost::shared_ptr<_Object> type.\n
+                //! [7], [8] A pointer to object that must outlive the subscription.
                 //! @param[in] _order Specifies where the listener will be placed. The default value is Order::BACK.
                 //! 
-                //! @return No return value.
+                //! @return Connection identifying the subscribed listener. It can be used to unsubscribe the listener with
+                //! remove_listener function.
                 //! 
                 //! @par Complexity
-                //! The constant time when subscribing to an event without specifying priority value. Logarithmic in the number
-                //! of priority values when subscribing with a particular priority.
+                //! Linear in the number of listeners subscribed to the event, as the same listener subscribed earlier is
+                //! looked for and removed. In addition:\n
+                //! backend::Signals2: Logarithmic in the number of priority values when subscribing with a particular
+                //! priority.\n
+                //! backend::Flat: The listeners placed after the new one are shifted and reindexed.\n
+                //! backend::Snapshot: The listeners are copied into a new array.
                 //! 
                 //! @par Exception safety
                 //! This routine meets the strong exception guarantee, where any exception thrown will cause the listener to not
@@ -120,8 +213,9 @@ namespace cws
                 //! @remark Call this function with the same parameters several times cause removing the listener from the
                 //! dispatcher and adding it to the specified place.
                 //! 
-                //! @remark To subscribe member function as a listener using a pointer to object of the class whose function is
-                //! a member boost::bind must be used.
+                //! @remark [7], [8] A member function with a pointer to object is subscribed as Delegate, which is stored
+                //! without memory allocation and compared in constant time. Member functions of objects managed by shared
+                //! pointers are bound by Delegate too.
                 //! 
                 //! @par Example
                 //! @include{lineno} example_add_listener.cpp
@@ -130,41 +224,241 @@ namespace cws
                 //! @include example_add_listener.txt
                 //! 
                 template <typename _Event, typename _Callable>
-                void add_listener(_Callable &&_callable, Order _order = Order::BACK)
+                connection_t add_listener(_Callable &&_callable, Order _order = Order::BACK)
                 {
-                    HEAD_T(_Event)::add_listener(std::forward<_Callable>(_callable), _order);
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::add_listener(subscription.wrap(std::forward<_Callable>(_callable)), _order));
                 }
 
                 template <typename _Event, typename _Callable>
-                void add_listener(_Priority _priority, _Callable &&_callable, Order _order = Order::BACK)
+                connection_t add_listener(_Priority _priority, _Callable &&_callable, Order _order = Order::BACK)
                 {
-                    HEAD_T(_Event)::add_listener(_priority, std::forward<_Callable>(_callable), _order);
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::add_listener(_priority, subscription.wrap(std::forward<_Callable>(_callable)), _order));
                 }
 
                 template <typename _Event, typename _Function, typename _Object>
-                void add_listener(_Function &&_function, std::shared_ptr<_Object> const &_object, Order _order = Order::BACK)
+                connection_t add_listener(_Function &&_function, std::shared_ptr<_Object> const &_object,
+                                          Order _order = Order::BACK)
                 {
-                    HEAD_T(_Event)::add_listener(std::forward<_Function>(_function), _object, _order);
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::add_listener(std::forward<_Function>(_function), _object, _order));
                 }
 
                 template <typename _Event, typename _Function, typename _Object>
-                void add_listener(_Priority _priority, _Function &&_function, std::shared_ptr<_Object> const &_object,
-                                  Order _order = Order::BACK)
+                connection_t add_listener(_Priority _priority, _Function &&_function, std::shared_ptr<_Object> const &_object,
+                                          Order _order = Order::BACK)
                 {
-                    HEAD_T(_Event)::add_listener(_priority, std::forward<_Function>(_function), _object, _order);
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::add_listener(_priority, std::forward<_Function>(_function), _object, _order));
                 }
 
                 template <typename _Event, typename _Function, typename _Object>
-                void add_listener(_Function &&_function, boost::shared_ptr<_Object> const &_object, Order _order = Order::BACK)
+                connection_t add_listener(_Function &&_function, boost::shared_ptr<_Object> const &_object,
+                                          Order _order = Order::BACK)
                 {
-                    HEAD_T(_Event)::add_listener(std::forward<_Function>(_function), _object, _order);
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::add_listener(std::forward<_Function>(_function), _object, _order));
                 }
 
                 template <typename _Event, typename _Function, typename _Object>
-                void add_listener(_Priority _priority, _Function &&_function, boost::shared_ptr<_Object> const &_object,
-                                  Order _order = Order::BACK)
+                connection_t add_listener(_Priority _priority, _Function &&_function, boost::shared_ptr<_Object> const &_object,
+                                          Order _order = Order::BACK)
+                {
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::add_listener(_priority, std::forward<_Function>(_function), _object, _order));
+                }
+
+                template <typename _Event, typename _Method, typename _Class, typename _Object>
+                connection_t add_listener(_Method _Class::*_method, _Object *_object, Order _order = Order::BACK)
+                {
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::add_listener(subscription.wrap(Delegate<_Event>(_method, _object)), _order));
+                }
+
+                template <typename _Event, typename _Method, typename _Class, typename _Object>
+                connection_t add_listener(_Priority _priority, _Method _Class::*_method, _Object *_object,
+                                          Order _order = Order::BACK)
+                {
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::add_listener(_priority, subscription.wrap(Delegate<_Event>(_method, _object)), _order));
+                }
+                //! 
+                //! @}
+                //! 
+
+                //==============================================================================================================
+                //! 
+                //! @{
+                //! 
+                //! @brief Subscribes listener to the event without looking for the same listener subscribed earlier.
+                //! 
+                //! Takes type of event as a template parameter to subscribe listener.
+                //! 
+                //! @tparam _Event A type of event that listener is subscribing to.
+                //! @tparam _Callable A type of function object or function.
+                //! 
+                //! @param[in] _priority [2] A value that is used to determine listeners' invocation order.
+                //! @param[in] _callable A reference to function object or pointer/reference to a function that will be
+                //! invoked when an event occurs.
+                //! @param[in] _order Specifies where the listener will be placed. The default value is Order::BACK.
+                //! 
+                //! @return Connection identifying the subscribed listener. It can be used to unsubscribe the listener with
+                //! remove_listener function.
+                //! 
+                //! @par Complexity
+                //! backend::Signals2: Constant when subscribing without specifying priority value. Logarithmic in the number of
+                //! priority values when subscribing with a particular priority.\n
+                //! backend::Flat: Linear in the number of listeners subscribed to the event, as the listeners placed after the
+                //! new one are shifted and reindexed.\n
+                //! backend::Snapshot: Linear in the number of listeners subscribed to the event, as they are copied into a new
+                //! array.
+                //! 
+                //! @par Exception safety
+                //! This routine meets the strong exception guarantee, where any exception thrown will cause the listener to not
+                //! be subscribed to the event.
+                //! 
+                //! @remark Listener signature: void (_Event const &).
+                //! 
+                //! @remark Function object is not required to have overloaded operator ==. Call this function with the same
+                //! parameters several times cause subscribing the listener several times.
+                //! 
+                //! @remark Function object is not required to be copyable. A move-only function object, such as a lambda
+                //! capturing std::unique_ptr, is moved into the dispatcher.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_connect.cpp
+                //! 
+                //! @par Output
+                //! @include example_connect.txt
+                //! 
+                template <typename _Event, typename _Callable>
+                connection_t connect(_Callable &&_callable, Order _order = Order::BACK)
+                {
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::connect(subscription.wrap(std::forward<_Callable>(_callable)), _order));
+                }
+
+                template <typename _Event, typename _Callable>
+                connection_t connect(_Priority _priority, _Callable &&_callable, Order _order = Order::BACK)
+                {
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::connect(_priority, subscription.wrap(std::forward<_Callable>(_callable)), _order));
+                }
+                //! 
+                //! @}
+                //! 
+
+                //==============================================================================================================
+                //! 
+                //! @{
+                //! 
+                //! @brief Subscribes listener to the events with the key of the topic.
+                //! 
+                //! Takes type of event as a template parameter to subscribe listener. The event type must be routed by a
+                //! Routing specialization. The listener is invoked for dispatched events whose key equals the key of the topic,
+                //! in the invocation order together with the listeners of the event subscribed without a topic.
+                //! 
+                //! [1], [2] Removes the same listener subscribed to the topic earlier, as add_listener function does.\n
+                //! [3], [4] Does not look for the same listener subscribed earlier, as connect function does.
+                //! 
+                //! @tparam _Event A type of event that listener is subscribing to.
+                //! @tparam _Key A type of key convertible to the key type of the event's Routing specialization.
+                //! @tparam _Callable A type of function object or function.
+                //! 
+                //! @param[in] _topic The topic made by topic function from the key of events.
+                //! @param[in] _priority [2], [4] A value that is used to determine listeners' invocation order.
+                //! @param[in] _callable A reference to function object or pointer/reference to a function that will be
+                //! invoked when an event with the key occurs.
+                //! @param[in] _order Specifies where the listener will be placed. The default value is Order::BACK.
+                //! 
+                //! @return Connection identifying the subscribed listener. It can be used to unsubscribe the listener with
+                //! remove_listener function.
+                //! 
+                //! @par Complexity
+                //! Linear in the number of listeners subscribed to the event.
+                //! 
+                //! @par Exception safety
+                //! This routine meets the strong exception guarantee, where any exception thrown will cause the listener to not
+                //! be subscribed to the event.
+                //! 
+                //! @remark Listener signature: void (_Event const &).
+                //! 
+                //! @remark [1], [2] Function object must have overloaded operator ==. A listener subscribed to several topics,
+                //! or to a topic and without one, is subscribed separately for each of them.
+                //! 
+                //! @remark The topic wrapper distinguishes the key from a priority, which may be of the same type.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_topics.cpp
+                //! 
+                //! @par Output
+                //! @include example_topics.txt
+                //! 
+                template <typename _Event, typename _Key, typename _Callable>
+                connection_t add_listener(Topic<_Key> const &_topic, _Callable &&_callable, Order _order = Order::BACK)
+                {
+                    static_assert(Routing<_Event>::routed, "The event is not routed by a key.");
+
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::add_listener(_topic, subscription.wrap(std::forward<_Callable>(_callable)), _order));
+                }
+
+                template <typename _Event, typename _Key, typename _Callable>
+                connection_t add_listener(Topic<_Key> const &_topic, _Priority _priority, _Callable &&_callable,
+                                          Order _order = Order::BACK)
+                {
+                    static_assert(Routing<_Event>::routed, "The event is not routed by a key.");
+
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(HEAD_T(_Event)::add_listener(
+                        _topic, _priority, subscription.wrap(std::forward<_Callable>(_callable)), _order));
+                }
+
+                template <typename _Event, typename _Key, typename _Callable>
+                connection_t connect(Topic<_Key> const &_topic, _Callable &&_callable, Order _order = Order::BACK)
+                {
+                    static_assert(Routing<_Event>::routed, "The event is not routed by a key.");
+
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(
+                        HEAD_T(_Event)::connect(_topic, subscription.wrap(std::forward<_Callable>(_callable)), _order));
+                }
+
+                template <typename _Event, typename _Key, typename _Callable>
+                connection_t connect(Topic<_Key> const &_topic, _Priority _priority, _Callable &&_callable,
+                                     Order _order = Order::BACK)
                 {
-                    HEAD_T(_Event)::add_listener(_priority, std::forward<_Function>(_function), _object, _order);
+                    static_assert(Routing<_Event>::routed, "The event is not routed by a key.");
+
+                    SUBSCRIPTION_T(_Event) subscription(*this);
+
+                    return subscription.commit(HEAD_T(_Event)::connect(
+                        _topic, _priority, subscription.wrap(std::forward<_Callable>(_callable)), _order));
                 }
                 //! 
                 //! @}
@@ -176,47 +470,87 @@ namespace cws
                 //! @brief Unsubscribes listener from the event.
                 //! 
                 //! @tparam _Event A type of event that listener is unsubscribing.
-                //! @tparam _Callable [1] A type of function object or function.
+                //! @tparam _Callable [1], [6] A type of function object or function.
                 //! @tparam _Function [2] - [3] A type of member function.
-                //! @tparam _Object [2] - [3] A class object whose _Function is a member.
+                //! @tparam _Object [2], [3], [5] A class object whose _Function or _Method is a member.
+                //! @tparam _Method [5] A type of member function of _Class.
+                //! @tparam _Class [5] A class whose _Method is a member. It is _Object or a base class of _Object.
+                //! @tparam _Key [6] A type of key convertible to the key type of the event's Routing specialization.
                 //! 
-                //! @param[in] _callable [1] A reference to function object or pointer/reference to a function that was
+                //! @param[in] _topic [6] The topic that the listener was subscribed to.
+                //! @param[in] _callable [1], [6] A reference to function object or pointer/reference to a function that was
                 //! subscribed earlier.
                 //! @param[in] _function [2] - [3] A pointer to a member function that was subscribed earlier.
+                //! @param[in] _method [5] A pointer to a member function that was subscribed earlier.
                 //! @param[in] _object [2] A constant reference to object of std::shared_ptr<_Object> type.\n
-                //! [3] A constant reference to object of boost::shared_ptr<_Object> type.
+                //! [3] A constant reference to object of boost::shared_ptr<_Object> type.\n
+                //! [5] A pointer to object whose member function was subscribed earlier.
+                //! @param[in] _connection [4] A connection returned by add_listener or connect function of this dispatcher.
                 //! 
                 //! @return No return value.
                 //! 
                 //! @par Complexity
-                //! Linear in the number of listeners subscribed to the event.
+                //! [1] - [3], [5], [6] Linear in the number of listeners subscribed to the event.\n
+                //! [4] Constant. Linear in the number of listeners subscribed to the event with backend::Snapshot.
                 //! 
                 //! @par Exception safety
                 //! Will not throw unless a user destructor or equality operator == throws. If either throw, the listener may
                 //! stay not removed.
                 //! 
+                //! @remark [4] Does nothing if the listener identified by the connection has already been unsubscribed.
+                //! 
+                //! @remark [1] Removes the listener subscribed without a topic. [6] Removes the listener subscribed to the
+                //! topic.
+                //! 
                 //! @par Example
                 //! @include{lineno} example_remove_listener.cpp
                 //! 
                 //! @par Output
                 //! @include example_remove_listener.txt
                 //! 
-                template <typename _Event, typename _Callable>
+                template <typename _Event, typename _Callable, typename = typename std::enable_if<
+                    !std::is_same<typename std::decay<_Callable>::type, connection_t>::value>::type>
                 void remove_listener(_Callable &&_callable)
                 {
-                    HEAD_T(_Event)::remove_listener(std::forward<_Callable>(_callable));
+                    HEAD_T(_Event)::remove_listener(meter_t::match(std::forward<_Callable>(_callable)));
+                    unsubscribed<_Event>();
                 }
 
                 template <typename _Event, typename _Function, typename _Object>
                 void remove_listener(_Function &&_function, std::shared_ptr<_Object> const &_object)
                 {
                     HEAD_T(_Event)::remove_tracked_listener(std::forward<_Function>(_function), _object);
+                    unsubscribed<_Event>();
                 }
 
                 template <typename _Event, typename _Function, typename _Object>
                 void remove_listener(_Function &&_function, boost::shared_ptr<_Object> const &_object)
                 {
                     HEAD_T(_Event)::remove_tracked_listener(std::forward<_Function>(_function), _object);
+                    unsubscribed<_Event>();
+                }
+
+                template <typename _Event>
+                void remove_listener(connection_t const &_connection)
+                {
+                    HEAD_T(_Event)::disconnect(_connection);
+                    unsubscribed<_Event>();
+                }
+
+                template <typename _Event, typename _Method, typename _Class, typename _Object>
+                void remove_listener(_Method _Class::*_method, _Object *_object)
+                {
+                    HEAD_T(_Event)::remove_listener(meter_t::match(Delegate<_Event>(_method, _object)));
+                    unsubscribed<_Event>();
+                }
+
+                template <typename _Event, typename _Key, typename _Callable>
+                void remove_listener(Topic<_Key> const &_topic, _Callable &&_callable)
+                {
+                    static_assert(Routing<_Event>::routed, "The event is not routed by a key.");
+
+                    HEAD_T(_Event)::remove_listener(_topic, meter_t::match(std::forward<_Callable>(_callable)));
+                    unsubscribed<_Event>();
                 }
                 //! 
                 //! @}
@@ -256,12 +590,14 @@ namespace cws
                 void remove_listeners(_Priority _priority)
                 {
                     HEAD_T(_Event)::remove_listeners(_priority);
+                    unsubscribed<_Event>();
                 }
 
                 //==============================================================================================================
                 void remove_listeners()
                 {
                     tail_t::remove_listeners();
+                    meter_t::unsubscribed_all();
                 }
                 //! 
                 //! @}
@@ -290,6 +626,10 @@ namespace cws
                 //! @remark Keep in mind that in a multithreaded environment listeners' code is executing in the same thread
                 //! where this function is called.
                 //! 
+                //! @remark If the event type declares bases by a Hierarchy specialization, listeners of the bases that are in
+                //! the events list are invoked after listeners of the event type, as listeners of a base are invoked for
+                //! events of the base.
+                //! 
                 //! @par Example
                 //! @include{lineno} example_dispatch.cpp
                 //! 
@@ -299,27 +639,736 @@ namespace cws
                 template<typename _Event>
                 void dispatch(_Event const &_event)
                 {
-                    HEAD_T(_Event)::dispatch(_event);
+                    typename meter_t::Start const start = meter_t::start();
+
+                    std::size_t const invocations = dispatch_lineage(_event, lineage_t<_Event>());
+
+                    meter_t::template dispatched<_Event>(start, 1, invocations);
                 }
 
                 //==============================================================================================================
-                #undef HEAD_T
+                //! 
+                //! @brief Checks whether any listener is subscribed to the event.
+                //! 
+                //! @tparam _Event The type of event.
+                //! 
+                //! @return true if at least one listener is subscribed to the event, false otherwise.
+                //! 
+                //! @par Complexity
+                //! Constant.
+                //! 
+                //! @par Exception safety
+                //! Will not throw with backend::Flat and backend::Snapshot.
+                //! 
+                //! @remark If no listener has ever subscribed to the event, the check is a single atomic load. With
+                //! backend::Flat and backend::Snapshot it is always a single atomic load without locking, while
+                //! backend::Signals2 locks the signal's mutex once the signal exists.
+                //! 
+                //! @remark In a multithreaded environment the result can be outdated by the time it is used.
+                //! 
+                //! @remark Listeners of the bases of the event type declared by a Hierarchy specialization are checked too,
+                //! since they are invoked for the event.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_dispatch_lazy.cpp
+                //! 
+                //! @par Output
+                //! @include example_dispatch_lazy.txt
+                //! 
+                template <typename _Event>
+                bool has_listeners() const
+                {
+                    static_assert(IsOneOf<_Event, _Events...>::value, "The event is not in the events list.");
+
+                    return listened(lineage_t<_Event>());
+                }
 
-            protected:
                 //==============================================================================================================
-                Base() = default;
+                //! 
+                //! @brief Constructs event and invokes subscribed listeners only if any listener is subscribed.
+                //! 
+                //! Checks whether any listener is subscribed to the event as has_listeners function does. If so, invokes the
+                //! factory to construct event object and dispatches it as dispatch function does. Otherwise the factory is
+                //! not invoked.
+                //! 
+                //! @tparam _Event The type of event occurs.
+                //! @tparam _Factory A type of function object or function.
+                //! 
+                //! @param[in] _factory Function object or function without parameters returning event object, or an object
+                //! convertible to it.
+                //! 
+                //! @return
+                //! No return value.
+                //! 
+                //! @par Complexity
+                //! Constant if no listener is subscribed, otherwise the factory's complexity plus the complexity of dispatch
+                //! function.
+                //! 
+                //! @par Exception safety
+                //! If an exception is thrown by the factory, no listener is invoked. If an exception is thrown by a listener
+                //! call, all listeners after that will not be invoked.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_dispatch_lazy.cpp
+                //! 
+                //! @par Output
+                //! @include example_dispatch_lazy.txt
+                //! 
+                template <typename _Event, typename _Factory>
+                void dispatch_lazy(_Factory &&_factory)
+                {
+                    if (has_listeners<_Event>())
+                        dispatch(static_cast<_Event const &>(std::forward<_Factory>(_factory)()));
+                }
 
                 //==============================================================================================================
-                Base(Base &&_source) noexcept
-                    : tail_t(std::move(_source))
+                //! 
+                //! @{
+                //! 
+                //! @brief Invokes subscribed listeners for each event of a batch.
+                //! 
+                //! Dispatches events of the batch one by one as dispatch function does, but takes the listeners of the
+                //! event type once for the whole batch. Then, if Batch<_Event> is one of the dispatcher's events, dispatches
+                //! the batch itself to listeners of Batch<_Event>, which can process all events at once.
+                //! 
+                //! [1] Events are specified by a range of pointers.\n
+                //! [2] Events are specified by a batch.
+                //! 
+                //! @tparam _Event The type of events.
+                //! 
+                //! @param[in] _first [1] Pointer to the first event.
+                //! @param[in] _last [1] Pointer past the last event.
+                //! @param[in] _batch [2] Batch of events.
+                //! 
+                //! @return
+                //! No return value.
+                //! 
+                //! @par Complexity
+                //! Linear in the number of events multiplied by the number of listeners subscribed to the event type plus
+                //! listeners' complexity.
+                //! 
+                //! @par Exception safety
+                //! If an exception is thrown by a listener call, all listeners after that will not be invoked, including
+                //! listeners of the remaining events.
+                //! 
+                //! @remark With backend::Flat and backend::Snapshot, listeners subscribed or unsubscribed while the batch is
+                //! dispatching take effect from the next dispatch. backend::Signals2 walks its listeners for each event.
+                //! 
+                //! @remark If the event type declares bases by a Hierarchy specialization, each event is dispatched to the
+                //! listeners of the event type and its bases before the next one, and the listeners are taken for each event.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_dispatch_batch.cpp
+                //! 
+                //! @par Output
+                //! @include example_dispatch_batch.txt
+                //! 
+                template <typename _Event>
+                void dispatch_batch(_Event const *_first, _Event const *_last)
                 {
+                    dispatch_batch(Batch<_Event>(_first, _last));
                 }
 
-            private:
+                template <typename _Event>
+                void dispatch_batch(Batch<_Event> const &_batch)
+                {
+                    if (_batch.empty())
+                        return;
+
+                    typename meter_t::Start const start = meter_t::start();
+
+                    std::size_t const invocations = dispatch_batch_lineage(_batch, lineage_t<_Event>());
+
+                    meter_t::template dispatched<_Event>(start, _batch.size(), invocations);
+
+                    dispatch_whole(_batch, IsOneOf<Batch<_Event>, _Events...>());
+                }
+                //! 
+                //! @}
+                //! 
+
                 //==============================================================================================================
-                Base           (Base const  &_source) = delete;
-                Base &operator=(Base const  &_source) = delete;
-                Base &operator=(Base       &&_source) = delete;
+                //! 
+                //! @{
+                //! 
+                //! @brief Invokes subscribed listeners by the executor.
+                //! 
+                //! Submits dispatching of the event to the dispatcher's executor, which invokes subscribed listeners as
+                //! dispatch function does. The event object is copied [1, 3] or moved [2, 4] into the submitted task.
+                //! 
+                //! [1, 2] Completion is observed through the returned future.\n
+                //! [3, 4] Completion is observed through the callback invoked by the executor after the listeners.
+                //! 
+                //! @tparam _Event The type of event occurs.
+                //! @tparam _Completion [3, 4] A type of function object or function.
+                //! 
+                //! @param[in] _event Event object that will be passed as a parameter to subscribed listeners.
+                //! @param[in] _completion [3, 4] Function object or function with signature void (std::exception_ptr) that
+                //! is invoked with the exception thrown by a listener call, or with a null pointer if no exception is
+                //! thrown. It must not throw.
+                //! 
+                //! @return [1, 2] Future that becomes ready when the listeners are invoked. It holds the exception thrown by
+                //! a listener call if any.\n
+                //! [3, 4] No return value.
+                //! 
+                //! @par Complexity
+                //! The complexity of the executor's submission.
+                //! 
+                //! @par Exception safety
+                //! This routine meets the strong exception guarantee, where any exception thrown by the submission will cause
+                //! the event to not be dispatched.
+                //! 
+                //! @remark The dispatcher waits for submitted dispatches when it is destroyed, and must not be moved or
+                //! swapped while they are in progress. It must not be destroyed by the executor's thread that should run
+                //! them.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_dispatch_async.cpp
+                //! 
+                //! @par Possible output
+                //! @include example_dispatch_async.txt
+                //! 
+                template <typename _Event>
+                std::future<void> dispatch_async(_Event const &_event)
+                {
+                    return fulfill(_event);
+                }
+
+                template <typename _Event, typename = typename std::enable_if<!std::is_reference<_Event>::value>::type>
+                std::future<void> dispatch_async(_Event &&_event)
+                {
+                    return fulfill(std::move(_event));
+                }
+
+                template <typename _Event, typename _Completion>
+                void dispatch_async(_Event const &_event, _Completion &&_completion)
+                {
+                    submit(_event, std::forward<_Completion>(_completion));
+                }
+
+                template <typename _Event, typename _Completion,
+                          typename = typename std::enable_if<!std::is_reference<_Event>::value>::type>
+                void dispatch_async(_Event &&_event, _Completion &&_completion)
+                {
+                    submit(std::move(_event), std::forward<_Completion>(_completion));
+                }
+                //! 
+                //! @}
+                //! 
+
+                //==============================================================================================================
+                //! 
+                //! @brief Invokes subscribed listeners in parallel.
+                //! 
+                //! Invokes subscribed listeners group by group, where a group is made up of listeners subscribed with the
+                //! same priority, or in the same order without priority. All listeners of a group are invoked before the
+                //! next group in dispatch order starts, while listeners of the same group are split into chunks invoked
+                //! concurrently by the dispatcher's executor and the calling thread.
+                //! 
+                //! @tparam _Event The type of event occurs.
+                //! 
+                //! @param[in] _event Event object that will be passed as a parameter to subscribed listeners.
+                //! 
+                //! @return
+                //! No return value.
+                //! 
+                //! @par Complexity
+                //! Linear in the number of listeners of the event divided by the number of threads running them.
+                //! 
+                //! @par Exception safety
+                //! If a listener call throws, the remaining listeners of its group that have not started yet and the next
+                //! groups are not invoked, and the first exception is rethrown when the group completes.
+                //! 
+                //! @remark Parallel dispatching pays off when listeners are CPU-heavy, since each group of several listeners
+                //! is handed over to the executor. Listeners of a group must be safe to invoke concurrently.
+                //! 
+                //! @remark With backend::Signals2 or executor::Inline listeners are invoked sequentially.
+                //! 
+                //! @remark Listeners of the bases of the event type declared by a Hierarchy specialization make groups of
+                //! their own after the groups of the event type.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_dispatch_parallel.cpp
+                //! 
+                //! @par Output
+                //! @include example_dispatch_parallel.txt
+                //! 
+                template <typename _Event>
+                void dispatch_parallel(_Event const &_event)
+                {
+                    _Allocator const allocator = queue_.get_allocator();
+
+                    Fanout<_Executor, _Allocator> const fanout(executor_, allocator);
+
+                    typename meter_t::Start const start = meter_t::start();
+
+                    std::size_t const invocations = dispatch_lineage(_event, fanout, lineage_t<_Event>());
+
+                    meter_t::template dispatched<_Event>(start, 1, invocations);
+                }
+
+                //==============================================================================================================
+                //! 
+                //! @{
+                //! 
+                //! @brief Enqueues event to be dispatched later.
+                //! 
+                //! Copies [1] or moves [2] event object into the dispatcher's queue. Enqueued events are dispatched to
+                //! subscribed listeners by process and process_for functions in the order they were enqueued, whatever their
+                //! types.
+                //! 
+                //! @tparam _Event The type of event occurs.
+                //! 
+                //! @param[in] _event Event object that will be passed as a parameter to subscribed listeners.
+                //! 
+                //! @return
+                //! No return value.
+                //! 
+                //! @par Complexity
+                //! Constant.
+                //! 
+                //! @par Exception safety
+                //! This routine meets the strong exception guarantee, where any exception thrown will cause the event to not
+                //! be enqueued.
+                //! 
+                //! @remark Events are stored one after another in blocks of memory reused by the dispatcher, so that
+                //! enqueueing does not allocate memory per event. The event type must not be over-aligned.
+                //! 
+                //! @remark If the event type is coalesced by a specialization of Coalescing, the event replaces a pending
+                //! event with the same key by move assignment and keeps its place in the queue. Then the exception safety
+                //! is strong only if the move assignment does not throw.
+                //! 
+                //! @remark Events can be enqueued by any thread if the dispatcher is thread-safe.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_enqueue.cpp
+                //! 
+                //! @par Output
+                //! @include example_enqueue.txt
+                //! 
+                template <typename _Event>
+                void enqueue(_Event const &_event)
+                {
+                    queue_.template push<Base, _Event>(_event);
+                }
+
+                template <typename _Event, typename = typename std::enable_if<!std::is_reference<_Event>::value>::type>
+                void enqueue(_Event &&_event)
+                {
+                    queue_.template push<Base, _Event>(std::move(_event));
+                }
+                //! 
+                //! @}
+                //! 
+
+                //==============================================================================================================
+                //! 
+                //! @brief Constructs event in the queue to be dispatched later.
+                //! 
+                //! Constructs event object of the type _Event from the arguments right in the dispatcher's queue, so that the
+                //! event is neither copied nor moved before it is dispatched by process and process_for functions. An
+                //! aggregate event is initialized by the arguments.
+                //! 
+                //! @tparam _Event The type of event occurs.
+                //! @tparam ..._Args Types of the arguments.
+                //! 
+                //! @param[in] ..._args Arguments passed to the event's constructor.
+                //! 
+                //! @return
+                //! No return value.
+                //! 
+                //! @par Complexity
+                //! Constant.
+                //! 
+                //! @par Exception safety
+                //! This routine meets the strong exception guarantee, where any exception thrown will cause the event to not
+                //! be enqueued.
+                //! 
+                //! @remark The event is constructed under the dispatcher's lock. An event of a type coalesced by a
+                //! specialization of Coalescing is constructed before locking to extract its key, and is moved into the
+                //! queue or replaces a pending event with the same key, as enqueue function does.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_enqueue.cpp
+                //! 
+                //! @par Output
+                //! @include example_enqueue.txt
+                //! 
+                template <typename _Event, typename ..._Args>
+                void emplace(_Args &&..._args)
+                {
+                    queue_.template push<Base, _Event>(std::forward<_Args>(_args)...);
+                }
+
+                //==============================================================================================================
+                //! 
+                //! @{
+                //! 
+                //! @brief Dispatches enqueued events.
+                //! 
+                //! Dispatches events enqueued before the call to subscribed listeners in the order they were enqueued. Events
+                //! of a coalesced type are dispatched once per distinct key, with the value enqueued last.
+                //! 
+                //! [1] Dispatches all of them.\n
+                //! [2] Stops when the time budget is exhausted. Events that are not dispatched stay in the queue ahead of
+                //! events enqueued later.
+                //! 
+                //! @param[in] _budget [2] Time that dispatching is allowed to take. It is checked before each event, so a
+                //! listener that is already invoked is never interrupted.
+                //! 
+                //! @return The number of dispatched events.
+                //! 
+                //! @par Complexity
+                //! Linear in the number of dispatched events plus listeners' complexity.
+                //! 
+                //! @par Exception safety
+                //! If an exception is thrown by a listener call, the event is removed from the queue, and events after it stay
+                //! in the queue.
+                //! 
+                //! @remark Only one thread at a time can process the queue, and it must not be processed by listeners. Events
+                //! enqueued while the queue is processing will be dispatched by the next call.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_enqueue.cpp
+                //! 
+                //! @par Output
+                //! @include example_enqueue.txt
+                //! 
+                std::size_t process()
+                {
+                    return queue_.pop(*this, []() { return true; });
+                }
+
+                template <typename _Rep, typename _Period>
+                std::size_t process_for(std::chrono::duration<_Rep, _Period> const &_budget)
+                {
+                    auto const deadline = std::chrono::steady_clock::now() + _budget;
+
+                    return queue_.pop(*this, [&deadline]() { return std::chrono::steady_clock::now() < deadline; });
+                }
+                //! 
+                //! @}
+                //! 
+
+                //==============================================================================================================
+                //! 
+                //! @brief Returns statistics of the dispatcher's events.
+                //! 
+                //! Available if the dispatcher is instantiated with StatsType<stats::Enabled> or StatsType<stats::Profiled>.
+                //! 
+                //! @return Statistics of each event of the dispatcher's events list, in the order of the list, since the
+                //! dispatcher was constructed.
+                //! 
+                //! @par Complexity
+                //! Linear in the number of events.
+                //! 
+                //! @par Exception safety
+                //! If an exception is thrown, there are no changes in the dispatcher.
+                //! 
+                //! @remark Counters updated concurrently may be taken either before or after the update. Statistics of a
+                //! moved-from dispatcher are zero.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_stats_type.cpp
+                //! 
+                //! @par Possible output
+                //! @include example_stats_type.txt
+                //! 
+                std::vector<events::stats::EventStats> stats() const
+                {
+                    static_assert(_Stats::enabled, "Statistics are collected with StatsType<stats::Enabled>.");
+
+                    return meter_t::collect();
+                }
+
+                //==============================================================================================================
+                //! 
+                //! @brief Returns profiles of the slowest listeners.
+                //! 
+                //! Available if the dispatcher is instantiated with StatsType<stats::Profiled>.
+                //! 
+                //! @param[in] _count Maximum number of listeners to return.
+                //! 
+                //! @return Profiles of subscribed listeners sorted by the total duration of their invocations, longest
+                //! first.
+                //! 
+                //! @par Complexity
+                //! Linearithmic in the number of profiled listeners.
+                //! 
+                //! @par Exception safety
+                //! If an exception is thrown, there are no changes in the dispatcher.
+                //! 
+                //! @remark A removed or disconnected listener is reported, with no further invocations, until the backend
+                //! destroys it. Listeners subscribed with tracked objects are not profiled.
+                //! 
+                //! @par Example
+                //! @include{lineno} example_top_listeners.cpp
+                //! 
+                //! @par Possible output
+                //! @include example_top_listeners.txt
+                //! 
+                std::vector<events::stats::ListenerStats<connection_t>> top_listeners(std::size_t _count) const
+                {
+                    static_assert(_Stats::profiled, "Listeners are profiled with StatsType<stats::Profiled>.");
+
+                    return meter_t::top(_count);
+                }
+
+            private:
+                //==============================================================================================================
+                // 
+                // Event types that an event of the type is dispatched to, starting from the type itself.
+                // 
+                template <typename _Event>
+                using lineage_t = typename Lineage<_Event, _Events...>::type;
+
+                //==============================================================================================================
+                // 
+                // Dispatches the event to the listeners of each type of its lineage in turn, as a reference to the type.
+                // 
+                template <typename _Event, typename ..._Types>
+                std::size_t dispatch_lineage(_Event const &_event, TypesList<_Types...>)
+                {
+                    static_assert(IsOneOf<_Event, _Events...>::value, "The event is not in the events list.");
+
+                    std::size_t const invocations[] = { HEAD_T(_Types)::dispatch(static_cast<_Types const &>(_event))... };
+
+                    return sum(invocations);
+                }
+
+                //==============================================================================================================
+                // 
+                // A batch of events without bases takes the listeners once.
+                // 
+                template <typename _Event>
+                std::size_t dispatch_batch_lineage(Batch<_Event> const &_batch, TypesList<_Event>)
+                {
+                    return HEAD_T(_Event)::dispatch_batch(_batch.begin(), _batch.end());
+                }
+
+                //==============================================================================================================
+                // 
+                // Each event of a batch is dispatched to all types of its lineage before the next one.
+                // 
+                template <typename _Event, typename ..._Types>
+                std::size_t dispatch_batch_lineage(Batch<_Event> const &_batch, TypesList<_Types...>)
+                {
+                    std::size_t invocations = 0;
+
+                    for (_Event const &event : _batch)
+                        invocations += dispatch_lineage(event, TypesList<_Types...>());
+
+                    return invocations;
+                }
+
+                //==============================================================================================================
+                // 
+                // The listeners of each type of the lineage are fanned out after the listeners of the previous type.
+                // 
+                template <typename _Event, typename _Fanout, typename ..._Types>
+                std::size_t dispatch_lineage(_Event const &_event, _Fanout const &_fanout, TypesList<_Types...>)
+                {
+                    static_assert(IsOneOf<_Event, _Events...>::value, "The event is not in the events list.");
+
+                    std::size_t const invocations[] = {
+                        HEAD_T(_Types)::dispatch_parallel(static_cast<_Types const &>(_event), _fanout)... };
+
+                    return sum(invocations);
+                }
+
+                //==============================================================================================================
+                template <typename ..._Types>
+                bool listened(TypesList<_Types...>) const
+                {
+                    bool const listeners[] = { HEAD_T(_Types)::has_listeners()... };
+
+                    return std::find(std::begin(listeners), std::end(listeners), true) != std::end(listeners);
+                }
+
+                //==============================================================================================================
+                template <std::size_t _Count>
+                static std::size_t sum(std::size_t const (&_values)[_Count]) noexcept
+                {
+                    std::size_t result = 0;
+
+                    for (std::size_t value : _values)
+                        result += value;
+
+                    return result;
+                }
+
+                //==============================================================================================================
+                #undef SUBSCRIPTION_T
+                #undef HEAD_T
+
+            protected:
+                //==============================================================================================================
+                Base()
+                    : Base(_Allocator())
+                {
+                }
+
+                //==============================================================================================================
+                explicit Base(_Allocator const &_allocator)
+                    : tail_t     (_allocator)
+                    , meter_t    (_allocator)
+                    , queue_     (_allocator)
+                    , asyncCount_(0)
+                {
+                }
+
+                //==============================================================================================================
+                Base(Base &&_source) noexcept
+                    : tail_t     (std::move(_source))
+                    , meter_t    (std::move(_source))
+                    , queue_     (std::move(_source.queue_))
+                    , executor_  (std::move(_source.executor_))
+                    , asyncCount_(0)
+                {
+                }
+
+                //==============================================================================================================
+                // 
+                // Waits for dispatches submitted to the executor, since they use the dispatcher.
+                // 
+                ~Base()
+                {
+                    while (asyncCount_.load(std::memory_order_acquire) != 0)
+                        std::this_thread::yield();
+                }
+
+            private:
+                //==============================================================================================================
+                Base           (Base const  &_source) = delete;
+                Base &operator=(Base const  &_source) = delete;
+                Base &operator=(Base       &&_source) = delete;
+
+            private:
+                //==============================================================================================================
+                template <typename _Event>
+                std::future<void> fulfill(_Event &&_event)
+                {
+                    std::promise<void>      promise;
+                    std::future<void>       future = promise.get_future();
+
+                    submit(std::forward<_Event>(_event), Fulfilling(std::move(promise)));
+
+                    return future;
+                }
+
+                //==============================================================================================================
+                // 
+                // Submits dispatching of the event copied or moved into the task.
+                // 
+                template <typename _Event, typename _Completion>
+                void submit(_Event &&_event, _Completion &&_completion)
+                {
+                    typedef typename std::decay<_Event>::type  event_t;
+
+                    Submitting submitting(asyncCount_);
+
+                    executor_.execute([this, event = std::forward<_Event>(_event),
+                                       completion = std::forward<_Completion>(_completion)]() mutable
+                    {
+                        std::exception_ptr error;
+
+                        try
+                        {
+                            dispatch(static_cast<event_t const &>(event));
+                        }
+                        catch (...)
+                        {
+                            error = std::current_exception();
+                        }
+
+                        completion(error);
+
+                        asyncCount_.fetch_sub(1, std::memory_order_release);
+                    });
+
+                    submitting.commit();
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                void dispatch_whole(Batch<_Event> const &_batch, std::true_type)
+                {
+                    dispatch(_batch);
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                void dispatch_whole(Batch<_Event> const &, std::false_type)
+                {
+                }
+
+
+                //==============================================================================================================
+                template <typename _Event>
+                void unsubscribed() noexcept
+                {
+                    meter_t::template unsubscribed<_Event>();
+                }
+
+            private:
+                //==============================================================================================================
+                // 
+                // Fulfills the promise of asynchronous dispatching.
+                // 
+                class Fulfilling
+                {
+                public:
+                    explicit Fulfilling(std::promise<void> &&_promise) noexcept
+                        : promise_(std::move(_promise))
+                    {
+                    }
+
+                    void operator()(std::exception_ptr const &_error)
+                    {
+                        if (_error)
+                            promise_.set_exception(_error);
+                        else
+                            promise_.set_value();
+                    }
+
+                private:
+                    std::promise<void> promise_;
+                };
+
+                //==============================================================================================================
+                // 
+                // Counts the dispatch submitted to the executor, unless the submission throws.
+                // 
+                class Submitting
+                {
+                public:
+                    explicit Submitting(std::atomic<std::size_t> &_count) noexcept
+                        : count_    (_count)
+                        , committed_(false)
+                    {
+                        count_.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    ~Submitting()
+                    {
+                        if (!committed_)
+                            count_.fetch_sub(1, std::memory_order_relaxed);
+                    }
+
+                    void commit() noexcept
+                    {
+                        committed_ = true;
+                    }
+
+                private:
+                    std::atomic<std::size_t> &count_;
+                    bool                      committed_;
+                };
+
+            private:
+                Queue<_Mutex, _Allocator, _Events...>  queue_;
+                _Executor                              executor_;
+                std::atomic<std::size_t>               asyncCount_;  // Dispatches submitted to the executor and not done yet.
             };
 
         }  // namespace dispatcher
@@ -44,7 +44,9 @@ namespace cws
                 struct DefaultType
                 {
                     typedef Base<typename MutexType<>::type, typename PriorityType<>::priority_type,
-                                 typename PriorityType<>::comparator_type, _Events...>  type;
+                                 typename PriorityType<>::comparator_type, typename BackendType<>::type,
+                                 typename ExecutorType<>::type, StorageType<>::size, typename AllocatorType<>::type,
+                                 typename StatsType<>::type, _Events...>  type;
                 };
 
 
@@ -52,10 +54,12 @@ namespace cws
                 // 
                 // Specifies custom Dispatcher's base type.
                 // 
-                template <typename _Mutex, typename _Priority, typename _Comparator, typename ..._Events>
+                template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend, typename _Executor,
+                          std::size_t _StorageSize, typename _Allocator, typename _Stats, typename ..._Events>
                 struct Type
                 {
-                    typedef Base<_Mutex, _Priority, _Comparator, _Events...>  type;
+                    typedef Base<_Mutex, _Priority, _Comparator, _Backend, _Executor, _StorageSize, _Allocator, _Stats,
+                                 _Events...>  type;
                 };
 
             }  // base
@@ -0,0 +1,134 @@
+// cws::events::dispatcher::Connection class identifies a listener subscribed to an event of a dispatcher with flat backends.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+//! 
+//! @file
+//! 
+#pragma once
+
+
+//==============================================================================================================================
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend,
+                      std::size_t _StorageSize, typename _Allocator, typename _Event>
+            class FlatHead;
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Identifies a listener subscribed to an event of a dispatcher with backend::Flat or backend::Snapshot.
+            //! 
+            //! Returned by add_listener and connect functions and used to unsubscribe the listener with remove_listener
+            //! function without searching for it.
+            //! 
+            //! @remark Connection class is trivially copyable. A default-constructed connection does not identify any
+            //! listener. A connection of an unsubscribed listener never identifies another listener.
+            //! 
+            //! @remark A connection is valid only with the event and the dispatcher that issued it, or the dispatcher that
+            //! the issuing one was moved or swapped into. Passed with another event or to another dispatcher, it does not
+            //! identify any listener, and remove_listener function does nothing.
+            //! 
+            //! @par Header
+            //! cws/events.hpp
+            //! 
+            //! @par Namespace
+            //! cws::events::dispatcher
+            //! 
+            class Connection
+            {
+                template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend,
+                          std::size_t _StorageSize, typename _Allocator, typename _Event>
+                friend class FlatHead;
+
+            public:
+                //==============================================================================================================
+                //! 
+                //! @brief Default constructor.
+                //! 
+                //! Instantiates connection that does not identify any listener.
+                //! 
+                Connection() noexcept
+                    : owner_     (0)
+                    , index_     (0)
+                    , generation_(0)
+                {
+                }
+
+                //==============================================================================================================
+                //! 
+                //! @brief Checks whether both connections identify the same listener.
+                //! 
+                bool operator==(Connection const &_other) const noexcept
+                {
+                    return owner_ == _other.owner_ && index_ == _other.index_ && generation_ == _other.generation_;
+                }
+
+                //==============================================================================================================
+                //! 
+                //! @brief Checks whether connections identify different listeners.
+                //! 
+                bool operator!=(Connection const &_other) const noexcept
+                {
+                    return !(*this == _other);
+                }
+
+            private:
+                //==============================================================================================================
+                Connection(std::uint64_t _owner, std::uint32_t _index, std::uint32_t _generation) noexcept
+                    : owner_     (_owner)
+                    , index_     (_index)
+                    , generation_(_generation)
+                {
+                }
+
+                //==============================================================================================================
+                // 
+                // Returns a new identifier of the listeners of an event of a dispatcher. Identifiers are never 0, which
+                // identifies no listeners.
+                // 
+                static std::uint64_t issue_owner() noexcept
+                {
+                    static std::atomic<std::uint64_t> ownersCount(0);
+
+                    return ownersCount.fetch_add(1, std::memory_order_relaxed) + 1;
+                }
+
+            private:
+                std::uint64_t owner_;       // Identifies the listeners of the event of the dispatcher that issued it.
+                std::uint32_t index_;
+                std::uint32_t generation_;
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
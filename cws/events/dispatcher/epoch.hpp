@@ -0,0 +1,151 @@
+// cws::events::dispatcher::Epoch class tracks lock-free readers of listeners arrays used by snapshot backend.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <atomic>
+#include <cstddef>
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Counts readers of the two alternating epochs. A reader enters the current epoch before loading the published
+            // array and leaves it when the array is no longer used. The writer retires replaced arrays to the current epoch
+            // and switches to the other epoch when it has no readers: then arrays retired to that epoch two switches ago are
+            // no longer used by anyone.
+            // 
+            // Readers of different threads are counted by different shards to avoid contention on a single cache line.
+            // 
+            class Epoch
+            {
+                static std::size_t const SHARDS_COUNT   = 16;
+                static std::size_t const SHARD_SIZE     = 128;
+
+                //==============================================================================================================
+                // 
+                // Shards are padded to two cache lines, so that counters of different shards never share a cache line
+                // whatever the alignment of the object.
+                // 
+                struct Shard
+                {
+                    std::atomic<std::size_t> readers[2];
+                    char                     padding[SHARD_SIZE - 2 * sizeof(std::atomic<std::size_t>)];
+                };
+
+            public:
+                //==============================================================================================================
+                Epoch() noexcept
+                    : current_(0)
+                {
+                    for (Shard &shard : shards_)
+                    {
+                        shard.readers[0].store(0, std::memory_order_relaxed);
+                        shard.readers[1].store(0, std::memory_order_relaxed);
+                    }
+                }
+
+                //==============================================================================================================
+                // 
+                // Registers a reader of the current epoch. Returns the counter that must be passed to leave function.
+                // 
+                std::atomic<std::size_t> &enter() noexcept
+                {
+                    Shard &shard = shards_[shard_index()];
+
+                    for (;;)
+                    {
+                        unsigned const            current = current_.load(std::memory_order_seq_cst);
+                        std::atomic<std::size_t> &readers = shard.readers[current];
+
+                        readers.fetch_add(1, std::memory_order_seq_cst);
+
+                        if (current_.load(std::memory_order_seq_cst) == current)
+                            return readers;
+
+                        readers.fetch_sub(1, std::memory_order_release);
+                    }
+                }
+
+                //==============================================================================================================
+                static void leave(std::atomic<std::size_t> &_readers) noexcept
+                {
+                    _readers.fetch_sub(1, std::memory_order_release);
+                }
+
+                //==============================================================================================================
+                // 
+                // Returns the current epoch. Must be called by the writer.
+                // 
+                unsigned current() const noexcept
+                {
+                    return current_.load(std::memory_order_relaxed);
+                }
+
+                //==============================================================================================================
+                // 
+                // Switches to the other epoch if it has no readers. Must be called by one writer at a time.
+                // 
+                bool advance() noexcept
+                {
+                    unsigned const next = current_.load(std::memory_order_relaxed) ^ 1;
+
+                    for (Shard const &shard : shards_)
+                    {
+                        if (shard.readers[next].load(std::memory_order_seq_cst) != 0)
+                            return false;
+                    }
+
+                    current_.store(next, std::memory_order_seq_cst);
+
+                    return true;
+                }
+
+            private:
+                //==============================================================================================================
+                static std::size_t shard_index() noexcept
+                {
+                    static std::atomic<std::size_t>       next(0);
+                    static thread_local std::size_t const index = next.fetch_add(1, std::memory_order_relaxed) % SHARDS_COUNT;
+
+                    return index;
+                }
+
+            private:
+                Epoch           (Epoch const &) = delete;
+                Epoch &operator=(Epoch const &) = delete;
+
+            private:
+                std::atomic<unsigned> current_;
+                Shard                 shards_[SHARDS_COUNT];
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
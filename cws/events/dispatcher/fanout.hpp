@@ -0,0 +1,213 @@
+// cws::events::dispatcher::Fanout class invokes a group of listeners concurrently by an executor.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Invokes listeners of a group by their indices, splitting them into chunks. Tasks submitted to the executor and
+            // the calling thread take chunks in turn until none remains, then the calling thread waits for the chunks taken
+            // by the tasks. Since the calling thread takes chunks too, the group is completed even if the executor runs the
+            // tasks later, or by the thread that waits.
+            // 
+            // The work is split for as many threads as there are hardware threads, but not less than two, as executor::Pool
+            // has. The state is shared with the tasks, which can outlive the call, and is allocated by the allocator. A task
+            // that takes no chunk does not access the listeners.
+            // 
+            template <typename _Executor, typename _Allocator>
+            class Fanout
+            {
+                static std::size_t const CHUNKS_PER_THREAD = 4;
+
+                //==============================================================================================================
+                struct State
+                {
+                    State(std::size_t _count, std::size_t _chunkSize, void const *_invoke,
+                          void (*_call)(void const *, std::size_t)) noexcept
+                        : count    (_count)
+                        , chunkSize(_chunkSize)
+                        , invoke   (_invoke)
+                        , call     (_call)
+                        , next     (0)
+                        , done     (0)
+                        , failed   (false)
+                    {
+                    }
+
+                    // 
+                    // Takes chunks until none remains.
+                    // 
+                    void run()
+                    {
+                        for (;;)
+                        {
+                            std::size_t const first = next.fetch_add(chunkSize, std::memory_order_relaxed);
+
+                            if (first >= count)
+                                return;
+
+                            std::size_t const last = first + chunkSize < count ? first + chunkSize : count;
+
+                            for (std::size_t index = first; index != last && !failed.load(std::memory_order_relaxed);
+                                 ++index)
+                            {
+                                try
+                                {
+                                    call(invoke, index);
+                                }
+                                catch (...)
+                                {
+                                    fail(std::current_exception());
+                                }
+                            }
+
+                            complete(last - first);
+                        }
+                    }
+
+                    void fail(std::exception_ptr const &_error) noexcept
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+
+                        if (!error)
+                            error = _error;
+
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+
+                    void complete(std::size_t _count)
+                    {
+                        if (done.fetch_add(_count, std::memory_order_acq_rel) + _count != count)
+                            return;
+
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                        }
+
+                        condition.notify_one();
+                    }
+
+                    void wait()
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+
+                        condition.wait(lock, [this]() { return done.load(std::memory_order_acquire) == count; });
+                    }
+
+                    std::size_t const           count;
+                    std::size_t const           chunkSize;
+                    void const          *const  invoke;
+                    void               (*const  call)(void const *, std::size_t);
+                    std::atomic<std::size_t>    next;
+                    std::atomic<std::size_t>    done;
+                    std::atomic<bool>           failed;
+                    std::mutex                  mutex;
+                    std::condition_variable     condition;
+                    std::exception_ptr          error;      // Guarded by mutex.
+                };
+
+            public:
+                //==============================================================================================================
+                Fanout(_Executor &_executor, _Allocator const &_allocator) noexcept
+                    : executor_ (_executor)
+                    , allocator_(_allocator)
+                {
+                }
+
+                //==============================================================================================================
+                // 
+                // Invokes _invoke(index) for each index of [0, _count), and returns when all calls are completed.
+                // Rethrows the first exception thrown by the calls, in which case the calls not started yet are skipped.
+                // 
+                template <typename _Invoke>
+                void operator()(std::size_t _count, _Invoke const &_invoke) const
+                {
+                    if (_count < 2)
+                    {
+                        if (_count == 1)
+                            _invoke(std::size_t(0));
+
+                        return;
+                    }
+
+                    std::size_t const threadsCount = std::thread::hardware_concurrency() > 2 ?
+                                                     std::thread::hardware_concurrency() : 2;
+                    std::size_t const chunksCount  = threadsCount * CHUNKS_PER_THREAD;
+                    std::size_t const chunkSize    = _count > chunksCount ? (_count + chunksCount - 1) / chunksCount : 1;
+                    std::size_t const tasksCount   = (_count + chunkSize - 1) / chunkSize - 1;
+
+                    std::shared_ptr<State> const state = std::allocate_shared<State>(allocator_, _count, chunkSize, &_invoke,
+                                                                                     &call<_Invoke>);
+
+                    for (std::size_t i = 0; i != tasksCount && i + 1 < threadsCount &&
+                                            state->next.load(std::memory_order_relaxed) < _count; ++i)
+                    {
+                        try
+                        {
+                            executor_.execute([state]() { state->run(); });
+                        }
+                        catch (...)
+                        {
+                            break;
+                        }
+                    }
+
+                    state->run();
+                    state->wait();
+
+                    if (state->error)
+                        std::rethrow_exception(state->error);
+                }
+
+            private:
+                //==============================================================================================================
+                template <typename _Invoke>
+                static void call(void const *_invoke, std::size_t _index)
+                {
+                    (*static_cast<_Invoke const *>(_invoke))(_index);
+                }
+
+            private:
+                _Executor         &executor_;
+                _Allocator const  &allocator_;
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
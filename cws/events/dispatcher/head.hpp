@@ -12,12 +12,23 @@
 #pragma once
 
 
+//==============================================================================================================================
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
 //==============================================================================================================================
 #include <boost/signals2.hpp>
 
 
 //==============================================================================================================================
+#include "../delegate.hpp"
 #include "../details.hpp"
+#include "allocator.hpp"
+#include "route.hpp"
 
 
 //==============================================================================================================================
@@ -37,35 +48,153 @@ namespace cws
 
             //==================================================================================================================
             // 
-            // Specifies head class for a specified event in cws::events::Dispatcher's scattered hierarchy.
+            // Specifies head class for a specified event in cws::events::Dispatcher's scattered hierarchy. Each backend
+            // provides its own specialization.
+            // 
+            template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend,
+                      std::size_t _StorageSize, typename _Allocator, typename _Event>
+            class Head;
+
+
+            //==================================================================================================================
+            // 
+            // Specifies type of a handle identifying a subscribed listener. Each backend provides its own specialization.
+            // 
+            template <typename _Backend>
+            struct ConnectionType;
+
+            //==================================================================================================================
+            template <>
+            struct ConnectionType<backend::Signals2>
+            {
+                typedef boost::signals2::connection  type;
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Move-only function object shared by its copies, since boost::function requires function objects to be copyable.
+            // 
+            template <typename _Callable>
+            class SharedCallable
+            {
+            public:
+                //==============================================================================================================
+                explicit SharedCallable(_Callable &&_callable)
+                    : callable_(std::make_shared<_Callable>(std::move(_callable)))
+                {
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                void operator()(_Event const &_event) const
+                {
+                    (*callable_)(_event);
+                }
+
+            private:
+                std::shared_ptr<_Callable> callable_;
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Passes a copyable function object as is, and wraps a move-only one into SharedCallable.
+            // 
+            template <typename _Callable>
+            inline _Callable &&make_copyable(_Callable &&_callable, std::true_type)
+            {
+                return std::forward<_Callable>(_callable);
+            }
+
+            //==================================================================================================================
+            template <typename _Callable>
+            inline SharedCallable<_Callable> make_copyable(_Callable &&_callable, std::false_type)
+            {
+                return SharedCallable<_Callable>(std::move(_callable));
+            }
+
+            //==================================================================================================================
+            template <typename _Callable>
+            inline decltype(auto) make_copyable(_Callable &&_callable)
+            {
+                return make_copyable(std::forward<_Callable>(_callable),
+                                     std::is_copy_constructible<typename std::decay<_Callable>::type>());
+            }
+
+
+            //==================================================================================================================
+            // 
+            // Combiner of boost::signals2::signal invoking all slots and returning the number of invoked slots.
+            // 
+            struct Counting
+            {
+                typedef std::size_t  result_type;
+
+                template <typename _Iterator>
+                std::size_t operator()(_Iterator _first, _Iterator _last) const
+                {
+                    std::size_t count = 0;
+
+                    for (; _first != _last; ++_first, ++count)
+                        *_first;
+
+                    return count;
+                }
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Head class for a specified event storing listeners in boost::signals2::signal. The signal is created when the
+            // first listener subscribes to the event, so events without listeners cost neither memory nor time. Listeners are
+            // stored by boost::function, so the storage size is not used. The signal is allocated by the allocator, but
+            // boost::signals2 allocates its connections and slots on the heap.
             // 
-            template <typename _Mutex, typename _Priority, typename _Comparator, typename _Event>
-            class Head
+            template <typename _Mutex, typename _Priority, typename _Comparator,
+                      std::size_t _StorageSize, typename _Allocator, typename _Event>
+            class Head<_Mutex, _Priority, _Comparator, backend::Signals2, _StorageSize, _Allocator, _Event>
             {
                 typedef typename boost::signals2::signal_type<void(_Event const &),
                                                               boost::signals2::keywords::group_type<_Priority>,
                                                               boost::signals2::keywords::group_compare_type<_Comparator>,
+                                                              boost::signals2::keywords::combiner_type<Counting>,
                                                               boost::signals2::keywords::mutex_type<_Mutex>>::type  signal_t;
 
-                typedef std::unique_ptr<signal_t>  unique_signal_t;
+                typedef typename signal_t::slot_type  slot_t;
 
             protected:
                 //==============================================================================================================
-                Head()
-                    : uniqueSignal_(new signal_t())
+                typedef typename ConnectionType<backend::Signals2>::type  connection_t;
+
+                //==============================================================================================================
+                explicit Head(_Allocator const &_allocator) noexcept
+                    : allocator_(_allocator)
+                    , signal_   (nullptr)
                 {
                 }
 
                 //==============================================================================================================
                 Head(Head &&_source) noexcept
-                    : uniqueSignal_(std::move(_source.uniqueSignal_))
+                    : allocator_(_source.allocator_)
+                    , signal_   (_source.signal_.exchange(nullptr))
+                {
+                }
+
+                //==============================================================================================================
+                ~Head()
                 {
+                    deallocate_object(allocator_, signal_.load());
                 }
 
                 //==============================================================================================================
                 void swap(Head &_source) noexcept
                 {
-                    std::swap(uniqueSignal_, _source.uniqueSignal_);
+                    using std::swap;
+
+                    swap(allocator_, _source.allocator_);
+
+                    signal_ = _source.signal_.exchange(signal_.load());
                 }
 
                 //==============================================================================================================
@@ -74,11 +203,10 @@ namespace cws
                 // The listener is any callable object.
                 // 
                 template <typename _Callable>
-                void add_listener(_Callable &&_callable, Order _order)
+                connection_t add_listener(_Callable &&_callable, Order _order)
                 {
                     remove_listener(std::forward<_Callable>(_callable));
-                    uniqueSignal_->connect(std::forward<_Callable>(_callable),
-                                           static_cast<boost::signals2::connect_position>(_order));
+                    return connect(std::forward<_Callable>(_callable), _order);
                 }
 
                 //==============================================================================================================
@@ -87,11 +215,10 @@ namespace cws
                 // The listener is any callable object.
                 //
                 template <typename _Callable>
-                void add_listener(_Priority _priority, _Callable &&_callable, Order _order)
+                connection_t add_listener(_Priority _priority, _Callable &&_callable, Order _order)
                 {
                     remove_listener(std::forward<_Callable>(_callable));
-                    uniqueSignal_->connect(_priority, std::forward<_Callable>(_callable),
-                                           static_cast<boost::signals2::connect_position>(_order));
+                    return connect(_priority, std::forward<_Callable>(_callable), _order);
                 }
 
                 //==============================================================================================================
@@ -100,12 +227,12 @@ namespace cws
                 // The listener is a member function with a pointer to object storing in std::shared_ptr.
                 // 
                 template <typename _Function, typename _Object>
-                void add_listener(_Function &&_function, std::shared_ptr<_Object> const &_object, Order _order)
+                connection_t add_listener(_Function &&_function, std::shared_ptr<_Object> const &_object, Order _order)
                 {
                     remove_tracked_listener(std::forward<_Function>(_function), _object);
-                    uniqueSignal_->connect(signal_t::slot_type(std::forward<_Function>(_function), _object.get(),
-                                                               _1).track_foreign(_object),
-                                           static_cast<boost::signals2::connect_position>(_order));
+                    return create_signal().connect(slot_t(bind_object<_Event>(std::forward<_Function>(_function),
+                                                                              _object.get())).track_foreign(_object),
+                                                   static_cast<boost::signals2::connect_position>(_order));
                 }
 
                 //==============================================================================================================
@@ -114,13 +241,13 @@ namespace cws
                 // The listener is a member function with a pointer to object storing in std::shared_ptr.
                 // 
                 template <typename _Function, typename _Object>
-                void add_listener(_Priority _priority, _Function &&_function, std::shared_ptr<_Object> const &_object,
-                                  Order _order)
+                connection_t add_listener(_Priority _priority, _Function &&_function, std::shared_ptr<_Object> const &_object,
+                                          Order _order)
                 {
                     remove_tracked_listener(std::forward<_Function>(_function), _object);
-                    uniqueSignal_->connect(_priority, signal_t::slot_type(std::forward<_Function>(_function), _object.get(),
-                                                                          _1).track_foreign(_object),
-                                           static_cast<boost::signals2::connect_position>(_order));
+                    return create_signal().connect(_priority, slot_t(bind_object<_Event>(std::forward<_Function>(_function),
+                                                                                         _object.get())).track_foreign(_object),
+                                                   static_cast<boost::signals2::connect_position>(_order));
                 }
 
                 //==============================================================================================================
@@ -129,12 +256,12 @@ namespace cws
                 // The listener is a member function with a pointer to object storing in boost::shared_ptr.
                 // 
                 template <typename _Function, typename _Object>
-                void add_listener(_Function &&_function, boost::shared_ptr<_Object> const &_object, Order _order)
+                connection_t add_listener(_Function &&_function, boost::shared_ptr<_Object> const &_object, Order _order)
                 {
                     remove_tracked_listener(std::forward<_Function>(_function), _object);
-                    uniqueSignal_->connect(signal_t::slot_type(std::forward<_Function>(_function), _object.get(),
-                                                               _1).track(_object),
-                                           static_cast<boost::signals2::connect_position>(_order));
+                    return create_signal().connect(slot_t(bind_object<_Event>(std::forward<_Function>(_function),
+                                                                              _object.get())).track(_object),
+                                                   static_cast<boost::signals2::connect_position>(_order));
                 }
 
                 //==============================================================================================================
@@ -143,13 +270,83 @@ namespace cws
                 // The listener is a member function with a pointer to object storing in boost::shared_ptr.
                 // 
                 template <typename _Function, typename _Object>
-                void add_listener(_Priority _priority, _Function &&_function, boost::shared_ptr<_Object> const &_object,
-                                  Order _order)
+                connection_t add_listener(_Priority _priority, _Function &&_function, boost::shared_ptr<_Object> const &_object,
+                                          Order _order)
                 {
                     remove_tracked_listener(std::forward<_Function>(_function), _object);
-                    uniqueSignal_->connect(_priority, signal_t::slot_type(std::forward<_Function>(_function), _object.get(),
-                                                                          _1).track(_object),
-                                           static_cast<boost::signals2::connect_position>(_order));
+                    return create_signal().connect(_priority, slot_t(bind_object<_Event>(std::forward<_Function>(_function),
+                                                                                         _object.get())).track(_object),
+                                                   static_cast<boost::signals2::connect_position>(_order));
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the current event in the specified order without removing the same
+                // listener subscribed earlier. The listener is any callable object.
+                // 
+                template <typename _Callable>
+                connection_t connect(_Callable &&_callable, Order _order)
+                {
+                    return create_signal().connect(make_copyable(std::forward<_Callable>(_callable)),
+                                                   static_cast<boost::signals2::connect_position>(_order));
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the current event using specified priority and order without removing
+                // the same listener subscribed earlier. The listener is any callable object.
+                // 
+                template <typename _Callable>
+                connection_t connect(_Priority _priority, _Callable &&_callable, Order _order)
+                {
+                    return create_signal().connect(_priority, make_copyable(std::forward<_Callable>(_callable)),
+                                                   static_cast<boost::signals2::connect_position>(_order));
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the events of the topic in the specified order.
+                // The listener is any callable object, which is invoked through a key test, since the signal does not index
+                // listeners by keys.
+                // 
+                template <typename _Key, typename _Callable>
+                connection_t add_listener(Topic<_Key> const &_topic, _Callable &&_callable, Order _order)
+                {
+                    return add_listener(make_keyed<_Event>(_topic.key, std::forward<_Callable>(_callable)), _order);
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the events of the topic using specified priority and order.
+                // The listener is any callable object.
+                // 
+                template <typename _Key, typename _Callable>
+                connection_t add_listener(Topic<_Key> const &_topic, _Priority _priority, _Callable &&_callable, Order _order)
+                {
+                    return add_listener(_priority, make_keyed<_Event>(_topic.key, std::forward<_Callable>(_callable)), _order);
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the events of the topic in the specified order without removing the
+                // same listener subscribed to the topic earlier. The listener is any callable object.
+                // 
+                template <typename _Key, typename _Callable>
+                connection_t connect(Topic<_Key> const &_topic, _Callable &&_callable, Order _order)
+                {
+                    return connect(make_keyed<_Event>(_topic.key, make_copyable(std::forward<_Callable>(_callable))), _order);
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the events of the topic using specified priority and order without
+                // removing the same listener subscribed to the topic earlier. The listener is any callable object.
+                // 
+                template <typename _Key, typename _Callable>
+                connection_t connect(Topic<_Key> const &_topic, _Priority _priority, _Callable &&_callable, Order _order)
+                {
+                    return connect(_priority, make_keyed<_Event>(_topic.key, make_copyable(std::forward<_Callable>(_callable))),
+                                   _order);
                 }
 
                 //==============================================================================================================
@@ -160,7 +357,19 @@ namespace cws
                 template <typename _Callable>
                 void remove_listener(_Callable &&_callable)
                 {
-                    uniqueSignal_->disconnect(std::forward<_Callable>(_callable));
+                    if (signal_t *signal = signal_.load(std::memory_order_acquire))
+                        signal->disconnect(std::forward<_Callable>(_callable));
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes specified listener subscribed to the topic for the current event.
+                // The listener is any callable object.
+                // 
+                template <typename _Key, typename _Callable>
+                void remove_listener(Topic<_Key> const &_topic, _Callable &&_callable)
+                {
+                    remove_listener(make_keyed<_Event>(_topic.key, std::forward<_Callable>(_callable)));
                 }
 
                 //==============================================================================================================
@@ -171,7 +380,17 @@ namespace cws
                 template <typename _Function, typename _Object>
                 void remove_tracked_listener(_Function &&_function, _Object const &_object)
                 {
-                    uniqueSignal_->disconnect(boost::bind(std::forward<_Function>(_function), _object.get(), _1));
+                    if (signal_t *signal = signal_.load(std::memory_order_acquire))
+                        signal->disconnect(bind_object<_Event>(std::forward<_Function>(_function), _object.get()));
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes the listener identified by the connection.
+                // 
+                void disconnect(connection_t const &_connection)
+                {
+                    _connection.disconnect();
                 }
 
                 //==============================================================================================================
@@ -180,7 +399,8 @@ namespace cws
                 // 
                 void remove_listeners(_Priority _priority)
                 {
-                    uniqueSignal_->disconnect(_priority);
+                    if (signal_t *signal = signal_.load(std::memory_order_acquire))
+                        signal->disconnect(_priority);
                 }
 
                 //==============================================================================================================
@@ -189,16 +409,82 @@ namespace cws
                 // 
                 void remove_listeners()
                 {
-                    uniqueSignal_->disconnect_all_slots();
+                    if (signal_t *signal = signal_.load(std::memory_order_acquire))
+                        signal->disconnect_all_slots();
+                }
+
+                //==============================================================================================================
+                // 
+                // Checks whether any listener is subscribed to the current event. Only a non-empty signal is locked.
+                // 
+                bool has_listeners() const
+                {
+                    signal_t const *signal = signal_.load(std::memory_order_acquire);
+
+                    return signal != nullptr && !signal->empty();
                 }
 
                 //==============================================================================================================
                 // 
                 // Dispatches current event object to corresponding listeners according to their priority and order.
+                // Returns the number of invoked listeners.
                 // 
-                void dispatch(_Event const &_event)
+                std::size_t dispatch(_Event const &_event)
                 {
-                    (*uniqueSignal_)(_event);
+                    if (signal_t *signal = signal_.load(std::memory_order_acquire))
+                        return (*signal)(_event);
+
+                    return 0;
+                }
+
+                //==============================================================================================================
+                // 
+                // Dispatches event objects of [_first, _last) range one by one. The signal locks its mutex for each of them.
+                // 
+                std::size_t dispatch_batch(_Event const *_first, _Event const *_last)
+                {
+                    std::size_t invocations = 0;
+
+                    if (signal_t *signal = signal_.load(std::memory_order_acquire))
+                    {
+                        for (; _first != _last; ++_first)
+                            invocations += (*signal)(*_first);
+                    }
+
+                    return invocations;
+                }
+
+                //==============================================================================================================
+                // 
+                // The signal invokes listeners one by one, so they are dispatched sequentially.
+                // 
+                template <typename _Fanout>
+                std::size_t dispatch_parallel(_Event const &_event, _Fanout const &)
+                {
+                    return dispatch(_event);
+                }
+
+            private:
+                //==============================================================================================================
+                // 
+                // Returns the signal creating it if no listener has subscribed to the event yet. Concurrent subscribers agree
+                // on a single signal without locking.
+                // 
+                signal_t &create_signal()
+                {
+                    signal_t *signal = signal_.load(std::memory_order_acquire);
+
+                    if (signal == nullptr)
+                    {
+                        signal_t *created = allocate_object<signal_t>(allocator_);
+
+                        if (signal_.compare_exchange_strong(signal, created, std::memory_order_acq_rel))
+                            signal = created;
+                        else
+                            deallocate_object(allocator_, created);
+                    }
+
+                    return *signal;
                 }
 
             private:
@@ -207,7 +493,8 @@ namespace cws
                 Head &operator=(Head &&)      = delete;
 
             private:
-                unique_signal_t uniqueSignal_;
+                _Allocator               allocator_;
+                std::atomic<signal_t *>  signal_;
             };
 
 
@@ -215,11 +502,14 @@ namespace cws
             // 
             // Access to head class for a specified event in cws::event::Dispatcher's scattered hierarchy.
             // 
-            template <typename _Mutex, typename _Priority, typename _Comparator>
+            template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend,
+                      std::size_t _StorageSize, typename _Allocator>
             struct HeadType
             {
+                typedef typename ConnectionType<_Backend>::type  connection_t;
+
                 template <typename _Event>
-                using type = Head<_Mutex, _Priority, _Comparator, _Event>;
+                using type = Head<_Mutex, _Priority, _Comparator, _Backend, _StorageSize, _Allocator, _Event>;
             };
 
         }  // namespace dispatcher
@@ -0,0 +1,1263 @@
+// cws::events::dispatcher::Head class specializations storing listeners in a priority-sorted contiguous array.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+//==============================================================================================================================
+#include <boost/optional.hpp>
+
+
+//==============================================================================================================================
+#include "../allocator.hpp"
+#include "../connection.hpp"
+#include "../epoch.hpp"
+#include "../head.hpp"
+#include "../listener.hpp"
+#include "../lock.hpp"
+#include "../rank.hpp"
+#include "../route.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            template <>
+            struct ConnectionType<backend::Flat>
+            {
+                typedef Connection  type;
+            };
+
+            //==================================================================================================================
+            template <>
+            struct ConnectionType<backend::Snapshot>
+            {
+                typedef Connection  type;
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Base of head classes storing listeners in a priority-sorted contiguous array. The array is created when the
+            // first listener subscribes to the event.
+            // 
+            // backend::Flat: the array is shared between the dispatcher and dispatches in progress, which are counted under
+            // the lock, shared if the mutex is shared-lockable. While the event is dispatching the array is never modified:
+            // subscribing and unsubscribing make a modified copy of it, and the last dispatch in progress destroys the outdated
+            // one.
+            // 
+            // backend::Snapshot: the published array is never modified. Dispatches read it without locking, registered in
+            // the current epoch. Subscribing and unsubscribing publish a modified copy and retire the outdated array, which is
+            // destroyed when no dispatch of its epoch remains.
+            // 
+            // Each subscribed listener owns a record locating its slot in the array, so that the listener is unsubscribed by
+            // its connection in constant time: the slot is replaced by a removed one, and removed slots are compacted when
+            // they make up half of the array. Records are reused, and the generation of a record distinguishes its owners.
+            // 
+            // Arrays, epoch, records, and listeners not stored in place are allocated by the allocator. An array keeps a copy
+            // of the allocator in its slots, so that it is destroyed by the allocator that created it.
+            // 
+            // Slots of a routed event keep the keys of their listeners, and the array keeps routes locating the slots of
+            // each key, which are updated together with the slots.
+            // 
+            template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend,
+                      std::size_t _StorageSize, typename _Allocator, typename _Event>
+            class FlatHead
+            {
+                typedef Listener<_Event, _StorageSize, _Allocator>               listener_t;
+                typedef std::vector<listener_t, Rebind<listener_t, _Allocator>>  garbage_t;
+                typedef Rank<_Priority, _Comparator>                             rank_t;
+                typedef Routes<_Allocator, _Event>                               routes_t;
+                typedef typename routes_t::key_t                                 key_t;
+                typedef std::uint32_t                                            index_t;
+                typedef std::integral_constant<bool, Routing<_Event>::routed>    routed_t;
+
+                static index_t const NO_RECORD = static_cast<index_t>(-1);
+
+                //==============================================================================================================
+                // 
+                // Listener of a removed slot.
+                // 
+                struct Removed
+                {
+                    void operator()(_Event const &) const
+                    {
+                    }
+                };
+
+                //==============================================================================================================
+                struct Slot
+                {
+                    listener_t  listener;
+                    rank_t      rank;
+                    index_t     record;    // NO_RECORD if the slot is removed.
+                    key_t       key;       // Empty if the listener is subscribed without a topic.
+                };
+
+                typedef std::vector<Slot, Rebind<Slot, _Allocator>>  slots_t;
+
+                //==============================================================================================================
+                struct Array
+                {
+                    explicit Array(_Allocator const &_allocator) noexcept
+                        : slots     (typename slots_t::allocator_type(_allocator))
+                        , routes    (_allocator)
+                        , removed   (0)
+                        , dispatches(0)
+                        , next      (nullptr)
+                    {
+                    }
+
+                    slots_t                   slots;
+                    routes_t                  routes;
+                    std::size_t               removed;
+                    std::atomic<std::size_t>  dispatches;  // backend::Flat only.
+                    Array                    *next;        // The next array retired to the same epoch, backend::Snapshot only.
+                };
+
+                //==============================================================================================================
+                // 
+                // Arrays linked by their next field. Destroys the arrays.
+                // 
+                class Chain
+                {
+                public:
+                    Chain() noexcept
+                        : first_(nullptr)
+                    {
+                    }
+
+                    ~Chain()
+                    {
+                        while (first_ != nullptr)
+                        {
+                            Array *next = first_->next;
+
+                            destroy(first_);
+                            first_ = next;
+                        }
+                    }
+
+                    void push(Array *_array) noexcept
+                    {
+                        _array->next = first_;
+                        first_       = _array;
+                    }
+
+                    void splice(Chain &_other) noexcept
+                    {
+                        while (_other.first_ != nullptr)
+                        {
+                            Array *next = _other.first_->next;
+
+                            push(_other.first_);
+                            _other.first_ = next;
+                        }
+                    }
+
+                    void swap(Chain &_other) noexcept
+                    {
+                        std::swap(first_, _other.first_);
+                    }
+
+                private:
+                    Chain           (Chain const &) = delete;
+                    Chain &operator=(Chain const &) = delete;
+
+                private:
+                    Array *first_;
+                };
+
+                //==============================================================================================================
+                // 
+                // The generation is odd while the record is in use, and the position is the position of the listener's slot.
+                // The generation is even while the record is free, and the position is the index of the next free record.
+                // 
+                struct Record
+                {
+                    index_t generation;
+                    index_t position;
+                };
+
+                typedef std::vector<Record, Rebind<Record, _Allocator>>  records_t;
+
+                //==============================================================================================================
+                // 
+                // Releases the array when dispatching ends even if a listener throws.
+                // 
+                class Dispatching
+                {
+                public:
+                    Dispatching(FlatHead &_head, Array *_array) noexcept
+                        : head_ (_head)
+                        , array_(_array)
+                    {
+                    }
+
+                    ~Dispatching()
+                    {
+                        head_.release(array_);
+                    }
+
+                private:
+                    FlatHead &head_;
+                    Array    *array_;
+                };
+
+                //==============================================================================================================
+                // 
+                // Keeps dispatch registered in the epoch until dispatching ends even if a listener throws.
+                // 
+                class Reading
+                {
+                public:
+                    explicit Reading(Epoch &_epoch) noexcept
+                        : readers_(_epoch.enter())
+                    {
+                    }
+
+                    ~Reading()
+                    {
+                        Epoch::leave(readers_);
+                    }
+
+                private:
+                    std::atomic<std::size_t> &readers_;
+                };
+
+                //==============================================================================================================
+                // 
+                // Provides the array to be modified under the lock, and publishes it when the modification ends even if an
+                // exception is thrown, since records already locate slots of the provided array.
+                // 
+                class Writing
+                {
+                public:
+                    Writing(FlatHead &_head, Chain &_reclaimed)
+                        : head_     (_head)
+                        , reclaimed_(_reclaimed)
+                        , current_  (_head.array_.load(std::memory_order_relaxed))
+                        , array_    (_head.writable(current_, _Backend()))
+                    {
+                    }
+
+                    ~Writing()
+                    {
+                        if (array_ != current_)
+                            head_.publish(current_, array_, reclaimed_, _Backend());
+                    }
+
+                    Array &array() const noexcept
+                    {
+                        return *array_;
+                    }
+
+                private:
+                    FlatHead &head_;
+                    Chain    &reclaimed_;
+                    Array    *current_;
+                    Array    *array_;
+                };
+
+            protected:
+                //==============================================================================================================
+                typedef typename ConnectionType<_Backend>::type  connection_t;
+
+                //==============================================================================================================
+                explicit FlatHead(_Allocator const &_allocator) noexcept
+                    : allocator_     (_allocator)
+                    , array_         (nullptr)
+                    , epoch_         (nullptr)
+                    , records_       (typename records_t::allocator_type(_allocator))
+                    , freeRecord_    (NO_RECORD)
+                    , owner_         (0)
+                    , listenersCount_(0)
+                {
+                }
+
+                //==============================================================================================================
+                FlatHead(FlatHead &&_source) noexcept
+                    : allocator_     (_source.allocator_)
+                    , array_         (_source.array_.exchange(nullptr))
+                    , epoch_         (_source.epoch_.exchange(nullptr))
+                    , records_       (std::move(_source.records_))
+                    , freeRecord_    (_source.freeRecord_)
+                    , owner_         (_source.owner_)
+                    , listenersCount_(_source.listenersCount_.exchange(0))
+                {
+                    retired_[0].swap(_source.retired_[0]);
+                    retired_[1].swap(_source.retired_[1]);
+
+                    _source.records_.clear();
+                    _source.freeRecord_ = NO_RECORD;
+                    _source.owner_      = 0;
+                }
+
+                //==============================================================================================================
+                ~FlatHead()
+                {
+                    if (Array *array = array_.load())
+                        destroy(array);
+
+                    deallocate_object(allocator_, epoch_.load());
+                }
+
+                //==============================================================================================================
+                void swap(FlatHead &_source) noexcept
+                {
+                    using std::swap;
+
+                    swap(allocator_, _source.allocator_);
+
+                    array_          = _source.array_.exchange(array_.load());
+                    epoch_          = _source.epoch_.exchange(epoch_.load());
+                    listenersCount_ = _source.listenersCount_.exchange(listenersCount_.load());
+
+                    retired_[0].swap(_source.retired_[0]);
+                    retired_[1].swap(_source.retired_[1]);
+                    records_.swap(_source.records_);
+                    swap(freeRecord_, _source.freeRecord_);
+                    swap(owner_,      _source.owner_);
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the current event in the specified order.
+                // The listener is any callable object.
+                // 
+                template <typename _Callable>
+                connection_t add_listener(_Callable &&_callable, Order _order)
+                {
+                    return insert(rank_t(_order), key_t(), std::forward<_Callable>(_callable), _order, std::true_type());
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the current event using specified priority and order.
+                // The listener is any callable object.
+                // 
+                template <typename _Callable>
+                connection_t add_listener(_Priority _priority, _Callable &&_callable, Order _order)
+                {
+                    return insert(rank_t(_priority), key_t(), std::forward<_Callable>(_callable), _order, std::true_type());
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the current event in the specified order.
+                // The listener is a member function with a pointer to object storing in std::shared_ptr.
+                // 
+                template <typename _Function, typename _Object>
+                connection_t add_listener(_Function &&_function, std::shared_ptr<_Object> const &_object, Order _order)
+                {
+                    return add_listener(make_tracked<_Event>(std::forward<_Function>(_function), _object), _order);
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the current event using specified priority and order.
+                // The listener is a member function with a pointer to object storing in std::shared_ptr.
+                // 
+                template <typename _Function, typename _Object>
+                connection_t add_listener(_Priority _priority, _Function &&_function, std::shared_ptr<_Object> const &_object,
+                                          Order _order)
+                {
+                    return add_listener(_priority, make_tracked<_Event>(std::forward<_Function>(_function), _object), _order);
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the current event in the specified order.
+                // The listener is a member function with a pointer to object storing in boost::shared_ptr.
+                // 
+                template <typename _Function, typename _Object>
+                connection_t add_listener(_Function &&_function, boost::shared_ptr<_Object> const &_object, Order _order)
+                {
+                    return add_listener(make_tracked<_Event>(std::forward<_Function>(_function), _object), _order);
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the current event using specified priority and order.
+                // The listener is a member function with a pointer to object storing in boost::shared_ptr.
+                // 
+                template <typename _Function, typename _Object>
+                connection_t add_listener(_Priority _priority, _Function &&_function, boost::shared_ptr<_Object> const &_object,
+                                          Order _order)
+                {
+                    return add_listener(_priority, make_tracked<_Event>(std::forward<_Function>(_function), _object), _order);
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the current event in the specified order without removing the same
+                // listener subscribed earlier. The listener is any callable object.
+                // 
+                template <typename _Callable>
+                connection_t connect(_Callable &&_callable, Order _order)
+                {
+                    return insert(rank_t(_order), key_t(), std::forward<_Callable>(_callable), _order, std::false_type());
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the current event using specified priority and order without removing
+                // the same listener subscribed earlier. The listener is any callable object.
+                // 
+                template <typename _Callable>
+                connection_t connect(_Priority _priority, _Callable &&_callable, Order _order)
+                {
+                    return insert(rank_t(_priority), key_t(), std::forward<_Callable>(_callable), _order, std::false_type());
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the events of the topic in the specified order.
+                // The listener is any callable object.
+                // 
+                template <typename _Key, typename _Callable>
+                connection_t add_listener(Topic<_Key> const &_topic, _Callable &&_callable, Order _order)
+                {
+                    return insert(rank_t(_order), key(_topic), std::forward<_Callable>(_callable), _order, std::true_type());
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the events of the topic using specified priority and order.
+                // The listener is any callable object.
+                // 
+                template <typename _Key, typename _Callable>
+                connection_t add_listener(Topic<_Key> const &_topic, _Priority _priority, _Callable &&_callable, Order _order)
+                {
+                    return insert(rank_t(_priority), key(_topic), std::forward<_Callable>(_callable), _order, std::true_type());
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the events of the topic in the specified order without removing the
+                // same listener subscribed to the topic earlier. The listener is any callable object.
+                // 
+                template <typename _Key, typename _Callable>
+                connection_t connect(Topic<_Key> const &_topic, _Callable &&_callable, Order _order)
+                {
+                    return insert(rank_t(_order), key(_topic), std::forward<_Callable>(_callable), _order, std::false_type());
+                }
+
+                //==============================================================================================================
+                // 
+                // Adds listener into dispatcher for the events of the topic using specified priority and order without
+                // removing the same listener subscribed to the topic earlier. The listener is any callable object.
+                // 
+                template <typename _Key, typename _Callable>
+                connection_t connect(Topic<_Key> const &_topic, _Priority _priority, _Callable &&_callable, Order _order)
+                {
+                    return insert(rank_t(_priority), key(_topic), std::forward<_Callable>(_callable), _order,
+                                  std::false_type());
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes specified listener subscribed without a topic for the current event.
+                // The listener is any callable object.
+                // 
+                template <typename _Callable>
+                void remove_listener(_Callable &&_callable)
+                {
+                    remove(key_t(), _callable);
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes specified listener subscribed to the topic for the current event.
+                // The listener is any callable object.
+                // 
+                template <typename _Key, typename _Callable>
+                void remove_listener(Topic<_Key> const &_topic, _Callable &&_callable)
+                {
+                    remove(key(_topic), _callable);
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes specified listener for the current event.
+                // The listener is a member function with a pointer to object storing as an automatic pointer.
+                // 
+                template <typename _Function, typename _Object>
+                void remove_tracked_listener(_Function &&_function, _Object const &_object)
+                {
+                    remove_listener(make_tracked<_Event>(std::forward<_Function>(_function), _object));
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes the listener identified by the connection. Connections issued by other heads, default-constructed
+                // ones, and connections of unsubscribed listeners are ignored.
+                // 
+                void disconnect(connection_t const &_connection)
+                {
+                    Chain                        reclaimed;
+                    boost::optional<listener_t>  garbage;
+
+                    if ((_connection.generation_ & 1) == 0)
+                        return;
+
+                    std::lock_guard<_Mutex> lock(mutex_);
+
+                    if (_connection.owner_ != owner_ || _connection.index_ >= records_.size() ||
+                        records_[_connection.index_].generation != _connection.generation_)
+                        return;
+
+                    Writing  writing(*this, reclaimed);
+                    Array   &array = writing.array();
+
+                    unsubscribe(array, array.slots[records_[_connection.index_].position], garbage);
+
+                    if (array.removed * 2 > array.slots.size())
+                        compact(array);
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes all listeners for the current event with the specified priority. A priority outside the declared
+                // range has no listeners.
+                // 
+                void remove_listeners(_Priority _priority)
+                {
+                    if (!rank_t::contains(_priority))
+                        return;
+
+                    rank_t const rank(_priority);
+
+                    modify([this, &rank](Array &_array, garbage_t &_garbage)
+                    {
+                        erase(_array, _garbage, [&rank](Slot const &_slot)
+                        {
+                            return _slot.rank == rank;
+                        });
+                    });
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes all listeners for the current event.
+                // 
+                void remove_listeners()
+                {
+                    modify([this](Array &_array, garbage_t &_garbage)
+                    {
+                        erase(_array, _garbage, [](Slot const &) { return true; });
+                    });
+                }
+
+                //==============================================================================================================
+                // 
+                // Checks whether any listener is subscribed to the current event without locking.
+                // 
+                bool has_listeners() const noexcept
+                {
+                    return listenersCount_.load(std::memory_order_relaxed) != 0;
+                }
+
+                //==============================================================================================================
+                // 
+                // Dispatches current event object to corresponding listeners according to their priority and order.
+                // Returns the number of invoked listeners.
+                // 
+                std::size_t dispatch(_Event const &_event)
+                {
+                    if (array_.load(std::memory_order_acquire) == nullptr)
+                        return 0;
+
+                    return dispatch(_event, _Backend());
+                }
+
+                //==============================================================================================================
+                // 
+                // Dispatches event objects of [_first, _last) range one by one, taking the listeners once.
+                // 
+                std::size_t dispatch_batch(_Event const *_first, _Event const *_last)
+                {
+                    if (array_.load(std::memory_order_acquire) == nullptr)
+                        return 0;
+
+                    return dispatch_batch(_first, _last, _Backend());
+                }
+
+                //==============================================================================================================
+                // 
+                // Dispatches current event object to corresponding listeners group by group. Listeners of a group are
+                // invoked by the fanout, possibly concurrently.
+                // 
+                template <typename _Fanout>
+                std::size_t dispatch_parallel(_Event const &_event, _Fanout const &_fanout)
+                {
+                    if (array_.load(std::memory_order_acquire) == nullptr)
+                        return 0;
+
+                    return dispatch_parallel(_event, _fanout, _Backend());
+                }
+
+            private:
+                //==============================================================================================================
+                std::size_t dispatch(_Event const &_event, backend::Flat)
+                {
+                    Array *array = acquire();
+
+                    if (array == nullptr)
+                        return 0;
+
+                    Dispatching dispatching(*this, array);
+
+                    return invoke(*array, _event, routed_t());
+                }
+
+                //==============================================================================================================
+                // 
+                // The array loaded after entering the epoch is not destroyed until the epoch is left.
+                // 
+                std::size_t dispatch(_Event const &_event, backend::Snapshot)
+                {
+                    Reading reading(*epoch_.load(std::memory_order_acquire));
+
+                    Array &array = *array_.load(std::memory_order_seq_cst);
+
+                    return invoke(array, _event, routed_t());
+                }
+
+                //==============================================================================================================
+                std::size_t dispatch_batch(_Event const *_first, _Event const *_last, backend::Flat)
+                {
+                    Array *array = acquire();
+
+                    if (array == nullptr)
+                        return 0;
+
+                    Dispatching dispatching(*this, array);
+
+                    return invoke(*array, _first, _last, routed_t());
+                }
+
+                //==============================================================================================================
+                std::size_t dispatch_batch(_Event const *_first, _Event const *_last, backend::Snapshot)
+                {
+                    Reading reading(*epoch_.load(std::memory_order_acquire));
+
+                    Array &array = *array_.load(std::memory_order_seq_cst);
+
+                    return invoke(array, _first, _last, routed_t());
+                }
+
+                //==============================================================================================================
+                template <typename _Fanout>
+                std::size_t dispatch_parallel(_Event const &_event, _Fanout const &_fanout, backend::Flat)
+                {
+                    Array *array = acquire();
+
+                    if (array == nullptr)
+                        return 0;
+
+                    Dispatching dispatching(*this, array);
+
+                    return fan_out(_event, _fanout, *array, routed_t());
+                }
+
+                //==============================================================================================================
+                template <typename _Fanout>
+                std::size_t dispatch_parallel(_Event const &_event, _Fanout const &_fanout, backend::Snapshot)
+                {
+                    Reading reading(*epoch_.load(std::memory_order_acquire));
+
+                    Array &array = *array_.load(std::memory_order_seq_cst);
+
+                    return fan_out(_event, _fanout, array, routed_t());
+                }
+
+                //==============================================================================================================
+                // 
+                // Number of listeners of the array, taken before the array is dispatched.
+                // 
+                static std::size_t listeners(Array const &_array) noexcept
+                {
+                    return _array.slots.size() - _array.removed;
+                }
+
+                //==============================================================================================================
+                // 
+                // Invokes all listeners of the array, since the event is not routed.
+                // 
+                static std::size_t invoke(Array &_array, _Event const &_event, std::false_type)
+                {
+                    std::size_t const invocations = listeners(_array);
+
+                    for (Slot &slot : _array.slots)
+                        slot.listener(_event);
+
+                    return invocations;
+                }
+
+                //==============================================================================================================
+                // 
+                // Invokes the listeners subscribed to the key of the event and the listeners subscribed without a topic.
+                // 
+                static std::size_t invoke(Array &_array, _Event const &_event, std::true_type)
+                {
+                    std::size_t invocations = 0;
+
+                    _array.routes.visit(_array.slots, _event, [&_event, &invocations](Slot &_slot)
+                    {
+                        if (subscribed(_slot))
+                        {
+                            _slot.listener(_event);
+                            ++invocations;
+                        }
+                    });
+
+                    return invocations;
+                }
+
+                //==============================================================================================================
+                static std::size_t invoke(Array &_array, _Event const *_first, _Event const *_last, std::false_type)
+                {
+                    std::size_t const invocations = listeners(_array) * static_cast<std::size_t>(_last - _first);
+
+                    for (; _first != _last; ++_first)
+                    {
+                        for (Slot &slot : _array.slots)
+                            slot.listener(*_first);
+                    }
+
+                    return invocations;
+                }
+
+                //==============================================================================================================
+                // 
+                // Each event of the batch is routed by its own key.
+                // 
+                static std::size_t invoke(Array &_array, _Event const *_first, _Event const *_last, std::true_type)
+                {
+                    std::size_t invocations = 0;
+
+                    for (; _first != _last; ++_first)
+                        invocations += invoke(_array, *_first, std::true_type());
+
+                    return invocations;
+                }
+
+                //==============================================================================================================
+                // 
+                // Slots of a group of the same priority are adjacent, since the slots are sorted.
+                // 
+                template <typename _Fanout>
+                static std::size_t fan_out(_Event const &_event, _Fanout const &_fanout, Array &_array, std::false_type)
+                {
+                    slots_t &slots = _array.slots;
+
+                    std::size_t const invocations = listeners(_array);
+
+                    for (auto first = slots.begin(); first != slots.end();)
+                    {
+                        auto const last = std::upper_bound(first, slots.end(), *first, &FlatHead::precedes);
+
+                        _fanout(static_cast<std::size_t>(last - first), [&_event, first](std::size_t _index)
+                        {
+                            first[_index].listener(_event);
+                        });
+
+                        first = last;
+                    }
+
+                    return invocations;
+                }
+
+                //==============================================================================================================
+                // 
+                // Routed slots are gathered in their order first, so that slots of a group of the same priority are
+                // adjacent too.
+                // 
+                template <typename _Fanout>
+                std::size_t fan_out(_Event const &_event, _Fanout const &_fanout, Array &_array, std::true_type)
+                {
+                    typedef std::vector<Slot *, Rebind<Slot *, _Allocator>>  routed_slots_t;
+
+                    routed_slots_t slots{ typename routed_slots_t::allocator_type(allocator_) };
+
+                    _array.routes.visit(_array.slots, _event, [&slots](Slot &_slot)
+                    {
+                        if (subscribed(_slot))
+                            slots.push_back(&_slot);
+                    });
+
+                    for (auto first = slots.begin(); first != slots.end();)
+                    {
+                        auto const last = std::upper_bound(first, slots.end(), *first, [](Slot const *_left, Slot const *_right)
+                        {
+                            return precedes(*_left, *_right);
+                        });
+
+                        _fanout(static_cast<std::size_t>(last - first), [&_event, first](std::size_t _index)
+                        {
+                            first[_index]->listener(_event);
+                        });
+
+                        first = last;
+                    }
+
+                    return slots.size();
+                }
+
+                //==============================================================================================================
+                // 
+                // Determines listeners' invocation order.
+                // 
+                static bool precedes(Slot const &_left, Slot const &_right)
+                {
+                    return _left.rank < _right.rank;
+                }
+
+                //==============================================================================================================
+                static bool subscribed(Slot const &_slot) noexcept
+                {
+                    return _slot.record != NO_RECORD;
+                }
+
+                //==============================================================================================================
+                // 
+                // Converts the key of the topic to the key of a slot.
+                // 
+                template <typename _Key>
+                static key_t key(Topic<_Key> const &_topic)
+                {
+                    return key_t(typename Routing<_Event>::key_type(_topic.key));
+                }
+
+                //==============================================================================================================
+                // 
+                // Destroys listener of a removed slot after the lock is released, unless there is no memory to defer it.
+                // 
+                void discard(listener_t &_listener, garbage_t &_garbage) noexcept
+                {
+                    try
+                    {
+                        _garbage.push_back(std::move(_listener));
+                    }
+                    catch (...)
+                    {
+                    }
+
+                    _listener = listener_t(Removed(), allocator_);
+                }
+
+                //==============================================================================================================
+                void discard(listener_t &_listener, boost::optional<listener_t> &_garbage) noexcept
+                {
+                    _garbage.emplace(std::move(_listener));
+
+                    _listener = listener_t(Removed(), allocator_);
+                }
+
+                //==============================================================================================================
+                // 
+                // Marks the slot removed and frees its record.
+                // 
+                template <typename _Garbage>
+                void unsubscribe(Array &_array, Slot &_slot, _Garbage &_garbage) noexcept
+                {
+                    _array.routes.removing(_array.slots, static_cast<std::size_t>(&_slot - _array.slots.data()));
+
+                    Record &record = records_[_slot.record];
+
+                    ++record.generation;
+                    record.position = freeRecord_;
+                    freeRecord_     = _slot.record;
+
+                    _slot.record = NO_RECORD;
+                    ++_array.removed;
+
+                    listenersCount_.fetch_sub(1, std::memory_order_relaxed);
+
+                    discard(_slot.listener, _garbage);
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes listeners satisfying the predicate and listeners whose tracked objects have expired.
+                // 
+                template <typename _Predicate>
+                void erase(Array &_array, garbage_t &_garbage, _Predicate &&_predicate)
+                {
+                    for (Slot &slot : _array.slots)
+                    {
+                        if (slot.record != NO_RECORD && (slot.listener.expired() || _predicate(slot)))
+                            unsubscribe(_array, slot, _garbage);
+                    }
+
+                    if (_array.removed != 0)
+                        compact(_array);
+                }
+
+                //==============================================================================================================
+                void compact(Array &_array) noexcept
+                {
+                    _array.slots.erase(std::remove_if(_array.slots.begin(), _array.slots.end(),
+                                                      [](Slot const &_slot) { return _slot.record == NO_RECORD; }),
+                                       _array.slots.end());
+                    _array.removed = 0;
+
+                    reindex(_array.slots, 0);
+
+                    _array.routes.rebuild(_array.slots, &FlatHead::subscribed);
+                }
+
+                //==============================================================================================================
+                // 
+                // Updates records of the slots starting from the specified position.
+                // 
+                void reindex(slots_t &_slots, std::size_t _position) noexcept
+                {
+                    for (std::size_t position = _position; position < _slots.size(); ++position)
+                    {
+                        if (_slots[position].record != NO_RECORD)
+                            records_[_slots[position].record].position = static_cast<index_t>(position);
+                    }
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes the listener subscribed with the key.
+                // 
+                template <typename _Callable>
+                void remove(key_t const &_key, _Callable const &_callable)
+                {
+                    modify([this, &_key, &_callable](Array &_array, garbage_t &_garbage)
+                    {
+                        erase(_array, _garbage, [&_key, &_callable](Slot const &_slot)
+                        {
+                            return _slot.key == _key && _slot.listener.equals(_callable);
+                        });
+                    });
+                }
+
+                //==============================================================================================================
+                template <typename _Callable>
+                void deduplicate(Array &_array, garbage_t &_garbage, key_t const &_key, _Callable const &_callable,
+                                 std::true_type)
+                {
+                    erase(_array, _garbage, [&_key, &_callable](Slot const &_slot)
+                    {
+                        return _slot.key == _key && _slot.listener.equals(_callable);
+                    });
+                }
+
+                //==============================================================================================================
+                template <typename _Callable>
+                void deduplicate(Array &, garbage_t &, key_t const &, _Callable const &, std::false_type)
+                {
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes the same listener if it was subscribed with the same key earlier and _Unique is std::true_type, and
+                // places the listener according to its rank and order.
+                // 
+                template <typename _Callable, typename _Unique>
+                connection_t insert(rank_t const &_rank, key_t const &_key, _Callable &&_callable, Order _order, _Unique)
+                {
+                    connection_t connection;
+
+                    modify([&](Array &_array, garbage_t &_garbage)
+                    {
+                        deduplicate(_array, _garbage, _key, _callable, _Unique());
+
+                        Slot slot{ listener_t(std::forward<_Callable>(_callable), allocator_), _rank, NO_RECORD, _key };
+
+                        if (owner_ == 0)
+                            owner_ = connection_t::issue_owner();
+
+                        if (freeRecord_ == NO_RECORD)
+                        {
+                            records_.push_back(Record{ 0, NO_RECORD });
+                            freeRecord_ = static_cast<index_t>(records_.size() - 1);
+                        }
+
+                        auto position = _order == Order::FRONT ?
+                                        std::lower_bound(_array.slots.begin(), _array.slots.end(), slot, &FlatHead::precedes) :
+                                        std::upper_bound(_array.slots.begin(), _array.slots.end(), slot, &FlatHead::precedes);
+
+                        position = _array.slots.insert(position, std::move(slot));
+
+                        index_t  index  = freeRecord_;
+                        Record  &record = records_[index];
+
+                        freeRecord_ = record.position;
+                        ++record.generation;
+
+                        position->record = index;
+
+                        listenersCount_.fetch_add(1, std::memory_order_relaxed);
+
+                        reindex(_array.slots, static_cast<std::size_t>(position - _array.slots.begin()));
+
+                        _array.routes.inserted(_array.slots, static_cast<std::size_t>(position - _array.slots.begin()));
+
+                        connection = connection_t(owner_, index, record.generation);
+                    }, true);
+
+                    return connection;
+                }
+
+                //==============================================================================================================
+                // 
+                // Applies the operation to the listeners array. Listeners removed by the operation and arrays no longer used
+                // are destroyed after the lock is released.
+                // 
+                template <typename _Operation>
+                void modify(_Operation &&_operation, bool _create = false)
+                {
+                    Chain     reclaimed;
+                    garbage_t garbage{ typename garbage_t::allocator_type(allocator_) };
+
+                    std::lock_guard<_Mutex> lock(mutex_);
+
+                    if (array_.load(std::memory_order_relaxed) == nullptr && !_create)
+                        return;
+
+                    Writing writing(*this, reclaimed);
+
+                    _operation(writing.array(), garbage);
+                }
+
+                //==============================================================================================================
+                // 
+                // Makes a copy of the array without removed slots, or an empty array if there is no array yet.
+                // 
+                Array *copy(Array const *_current)
+                {
+                    Array *array = allocate_object<Array>(allocator_, allocator_);
+
+                    try
+                    {
+                        if (_current != nullptr)
+                        {
+                            array->slots.reserve(_current->slots.size() - _current->removed);
+
+                            std::copy_if(_current->slots.begin(), _current->slots.end(), std::back_inserter(array->slots),
+                                         [](Slot const &_slot) { return _slot.record != NO_RECORD; });
+                        }
+                    }
+                    catch (...)
+                    {
+                        destroy(array);
+                        throw;
+                    }
+
+                    reindex(array->slots, 0);
+
+                    if (_current != nullptr && _current->removed == 0)
+                        array->routes.assign(_current->routes, array->slots, &FlatHead::subscribed);
+                    else
+                        array->routes.rebuild(array->slots, &FlatHead::subscribed);
+
+                    return array;
+                }
+
+                //==============================================================================================================
+                // 
+                // Destroys the array by the allocator kept in its slots.
+                // 
+                static void destroy(Array *_array) noexcept
+                {
+                    deallocate_object(_array->slots.get_allocator(), _array);
+                }
+
+                //==============================================================================================================
+                // 
+                // The array is modified in place unless it is being dispatched.
+                // 
+                Array *writable(Array *_current, backend::Flat)
+                {
+                    if (_current != nullptr && _current->dispatches.load(std::memory_order_relaxed) == 0)
+                        return _current;
+
+                    return copy(_current);
+                }
+
+                //==============================================================================================================
+                // 
+                // The published array is never modified.
+                // 
+                Array *writable(Array *_current, backend::Snapshot)
+                {
+                    if (epoch_.load(std::memory_order_relaxed) == nullptr)
+                        epoch_.store(allocate_object<Epoch>(allocator_), std::memory_order_release);
+
+                    return copy(_current);
+                }
+
+                //==============================================================================================================
+                // 
+                // The last dispatch in progress destroys the outdated array.
+                // 
+                void publish(Array *, Array *_array, Chain &, backend::Flat) noexcept
+                {
+                    array_.store(_array, std::memory_order_release);
+                }
+
+                //==============================================================================================================
+                // 
+                // Retires the outdated array to the current epoch. Arrays retired to an epoch are reclaimed when the epoch
+                // becomes current again, since then both epochs have had no readers once.
+                // 
+                void publish(Array *_current, Array *_array, Chain &_reclaimed, backend::Snapshot) noexcept
+                {
+                    Epoch &epoch = *epoch_.load(std::memory_order_relaxed);
+
+                    array_.store(_array, std::memory_order_seq_cst);
+
+                    if (_current != nullptr)
+                        retired_[epoch.current()].push(_current);
+
+                    for (int i = 0; i != 2 && epoch.advance(); ++i)
+                        _reclaimed.splice(retired_[epoch.current()]);
+                }
+
+                //==============================================================================================================
+                // 
+                // Dispatches are counted atomically, since they can hold a shared lock at once. Modifications hold an
+                // exclusive lock, so the array cannot be replaced while it is counted.
+                // 
+                Array *acquire()
+                {
+                    typename SharedLockType<_Mutex>::type lock(mutex_);
+
+                    Array *array = array_.load(std::memory_order_relaxed);
+
+                    if (array != nullptr)
+                        array->dispatches.fetch_add(1, std::memory_order_relaxed);
+
+                    return array;
+                }
+
+                //==============================================================================================================
+                void release(Array *_array) noexcept
+                {
+                    {
+                        typename SharedLockType<_Mutex>::type lock(mutex_);
+
+                        if (_array->dispatches.fetch_sub(1, std::memory_order_acq_rel) != 1 ||
+                            _array == array_.load(std::memory_order_relaxed))
+                            return;
+                    }
+
+                    destroy(_array);
+                }
+
+            private:
+                FlatHead           (FlatHead const &) = delete;
+                FlatHead &operator=(FlatHead const &) = delete;
+                FlatHead &operator=(FlatHead &&)      = delete;
+
+            private:
+                _Allocator                 allocator_;
+                std::atomic<Array *>       array_;
+                std::atomic<Epoch *>       epoch_;
+                _Mutex                     mutex_;
+                Chain                      retired_[2];
+                records_t                  records_;
+                index_t                    freeRecord_;
+                std::uint64_t              owner_;           // Identifies connections issued by the head, 0 until the first.
+                std::atomic<std::size_t>   listenersCount_;  // Modified under the lock.
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Head class for a specified event storing listeners in a priority-sorted contiguous array shared with dispatches
+            // in progress.
+            // 
+            template <typename _Mutex, typename _Priority, typename _Comparator,
+                      std::size_t _StorageSize, typename _Allocator, typename _Event>
+            class Head<_Mutex, _Priority, _Comparator, backend::Flat, _StorageSize, _Allocator, _Event> :
+                public FlatHead<_Mutex, _Priority, _Comparator, backend::Flat, _StorageSize, _Allocator, _Event>
+            {
+                typedef FlatHead<_Mutex, _Priority, _Comparator, backend::Flat, _StorageSize, _Allocator, _Event>  base_t;
+
+            protected:
+                //==============================================================================================================
+                explicit Head(_Allocator const &_allocator) noexcept
+                    : base_t(_allocator)
+                {
+                }
+
+                //==============================================================================================================
+                Head(Head &&_source) noexcept
+                    : base_t(std::move(_source))
+                {
+                }
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Head class for a specified event storing listeners in a priority-sorted contiguous array published as an
+            // immutable snapshot, which is dispatched without locking.
+            // 
+            template <typename _Mutex, typename _Priority, typename _Comparator,
+                      std::size_t _StorageSize, typename _Allocator, typename _Event>
+            class Head<_Mutex, _Priority, _Comparator, backend::Snapshot, _StorageSize, _Allocator, _Event> :
+                public FlatHead<_Mutex, _Priority, _Comparator, backend::Snapshot, _StorageSize, _Allocator, _Event>
+            {
+                typedef FlatHead<_Mutex, _Priority, _Comparator, backend::Snapshot, _StorageSize, _Allocator, _Event>  base_t;
+
+            protected:
+                //==============================================================================================================
+                explicit Head(_Allocator const &_allocator) noexcept
+                    : base_t(_allocator)
+                {
+                }
+
+                //==============================================================================================================
+                Head(Head &&_source) noexcept
+                    : base_t(std::move(_source))
+                {
+                }
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
@@ -0,0 +1,176 @@
+// cws::events::dispatcher::Index class finds pending events of a coalesced type by their keys.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+
+//==============================================================================================================================
+#include "../details.hpp"
+#include "allocator.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Events of a type that is not coalesced are not indexed.
+            // 
+            template <typename _Allocator, typename _Event, bool = Coalescing<_Event>::coalesced>
+            class Index
+            {
+            protected:
+                //==============================================================================================================
+                explicit Index(_Allocator const &) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                void swap(Index &) noexcept
+                {
+                }
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Maps keys to pending events of a coalesced type. The index belongs to a generation of pending events, and is
+            // cleared when it is used for the next one, so that it never refers to events that are being processed.
+            // 
+            template <typename _Allocator, typename _Event>
+            class Index<_Allocator, _Event, true>
+            {
+                typedef typename Coalescing<_Event>::key_type  key_t;
+
+                typedef std::unordered_map<key_t,
+                                           _Event *,
+                                           std::hash<key_t>,
+                                           std::equal_to<key_t>,
+                                           Rebind<std::pair<key_t const, _Event *>, _Allocator>>  events_t;
+
+            protected:
+                //==============================================================================================================
+                explicit Index(_Allocator const &_allocator)
+                    : events_    (0, std::hash<key_t>(), std::equal_to<key_t>(), _allocator)
+                    , generation_(0)
+                {
+                }
+
+                //==============================================================================================================
+                void swap(Index &_source) noexcept
+                {
+                    using std::swap;
+
+                    swap(events_,     _source.events_);
+                    swap(generation_, _source.generation_);
+                }
+
+                //==============================================================================================================
+                // 
+                // Returns the pointer to the pending event of the generation with the key, which is nullptr if there is no
+                // such event, so that the caller stores the event it enqueues.
+                // 
+                _Event *&pending(key_t const &_key, std::size_t _generation)
+                {
+                    if (generation_ != _generation)
+                    {
+                        events_.clear();
+
+                        generation_ = _generation;
+                    }
+
+                    return events_[_key];
+                }
+
+            private:
+                events_t     events_;
+                std::size_t  generation_;
+            };
+
+
+            //==================================================================================================================
+            template <typename _Allocator, typename ..._Events>
+            class Indices;
+
+
+            //==================================================================================================================
+            // 
+            // Empty tail of the indices of a queue.
+            // 
+            template <typename _Allocator>
+            class Indices<_Allocator>
+            {
+            protected:
+                //==============================================================================================================
+                explicit Indices(_Allocator const &) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                void swap(Indices &) noexcept
+                {
+                }
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Indices of a queue, one for each event type, inherited from the index of the first event type and the indices
+            // of the rest of event types.
+            // 
+            template <typename _Allocator, typename _This, typename ..._Rest>
+            class Indices<_Allocator, _This, _Rest...> :
+                public Index  <_Allocator, _This>,
+                public Indices<_Allocator, _Rest...>
+            {
+                typedef Index  <_Allocator, _This>     index_t;
+                typedef Indices<_Allocator, _Rest...>  indices_t;
+
+            protected:
+                //==============================================================================================================
+                explicit Indices(_Allocator const &_allocator)
+                    : index_t  (_allocator)
+                    , indices_t(_allocator)
+                {
+                }
+
+                //==============================================================================================================
+                void swap(Indices &_source) noexcept
+                {
+                    index_t  ::swap(_source);
+                    indices_t::swap(_source);
+                }
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
@@ -0,0 +1,287 @@
+// cws::events::dispatcher::Lane class keeps events posted to a single producer channel until the consumer dispatches them.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+//==============================================================================================================================
+#include "../overflow.hpp"
+#include "allocator.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Bounded wait-free ring of events of one type, which one thread posts to and one thread consumes.
+            // 
+            // The producer owns the tail and the consumer owns the head, so each of them only stores its own index and
+            // loads the other one. Each side also keeps a copy of the other index on its own cache line, and reloads it only
+            // when the ring looks full to the producer or holds fewer events than requested to the consumer, so that the
+            // cache lines of the indices do not bounce between cores on every event. The consumer publishes the head once
+            // per drained batch.
+            // 
+            template <typename _Overflow, typename _Allocator, typename _Event>
+            class Lane
+            {
+                static_assert(alignof(_Event) <= alignof(std::max_align_t), "Over-aligned events cannot be posted.");
+                static_assert(std::is_nothrow_move_constructible<_Event>::value,
+                              "Events posted to a channel must be nothrow move constructible.");
+                static_assert(std::is_same<_Overflow, overflow::Block>::value ||
+                              std::is_same<_Overflow, overflow::DropNewest>::value,
+                              "A single producer channel supports overflow::Block and overflow::DropNewest policies only.");
+
+                static std::size_t const CACHE_LINE = 64;
+
+                //==============================================================================================================
+                typedef typename std::aligned_storage<sizeof(_Event), alignof(_Event)>::type  Cell;
+
+                typedef Rebind<Cell, _Allocator>            allocator_t;
+                typedef std::allocator_traits<allocator_t>  traits_t;
+
+                //==============================================================================================================
+                // 
+                // Publishes the head after the released events of a drained batch when draining ends even if a listener throws.
+                // 
+                class Consuming
+                {
+                public:
+                    Consuming(Lane &_lane, std::size_t _position) noexcept
+                        : lane_    (_lane)
+                        , position_(_position)
+                    {
+                    }
+
+                    ~Consuming()
+                    {
+                        lane_.head_.store(position_, std::memory_order_release);
+                    }
+
+                    //==========================================================================================================
+                    std::size_t position() const noexcept
+                    {
+                        return position_;
+                    }
+
+                    //==========================================================================================================
+                    void release() noexcept
+                    {
+                        lane_.event(position_)->~_Event();
+
+                        ++position_;
+                    }
+
+                private:
+                    Lane         &lane_;
+                    std::size_t   position_;
+                };
+
+                //==============================================================================================================
+                // 
+                // Releases the event being dispatched even if a listener throws.
+                // 
+                class Releasing
+                {
+                public:
+                    explicit Releasing(Consuming &_consuming) noexcept
+                        : consuming_(_consuming)
+                    {
+                    }
+
+                    ~Releasing()
+                    {
+                        consuming_.release();
+                    }
+
+                private:
+                    Consuming &consuming_;
+                };
+
+            public:
+                //==============================================================================================================
+                // 
+                // Allocates cells for the capacity rounded up to a power of two, but not less than two.
+                // 
+                Lane(_Allocator const &_allocator, std::size_t _capacity)
+                    : allocator_(_allocator)
+                    , size_     (size(_capacity))
+                    , cells_    (traits_t::allocate(allocator_, size_))
+                    , tail_     (0)
+                    , headCache_(0)
+                    , dropped_  (0)
+                    , head_     (0)
+                    , tailCache_(0)
+                {
+                }
+
+                //==============================================================================================================
+                // 
+                // Destroys the events that are not consumed.
+                // 
+                ~Lane()
+                {
+                    for (std::size_t position = head_.load(); position != tail_.load(); ++position)
+                        event(position)->~_Event();
+
+                    traits_t::deallocate(allocator_, cells_, size_);
+                }
+
+                //==============================================================================================================
+                std::size_t capacity() const noexcept
+                {
+                    return size_;
+                }
+
+                //==============================================================================================================
+                std::uint64_t dropped() const noexcept
+                {
+                    return dropped_.load(std::memory_order_relaxed);
+                }
+
+                //==============================================================================================================
+                // 
+                // Moves the event into the ring. Returns false if the event is dropped by overflow::DropNewest policy.
+                // 
+                bool push(_Event &&_event) noexcept
+                {
+                    std::size_t const position = tail_.load(std::memory_order_relaxed);
+
+                    while (position - headCache_ == size_)
+                    {
+                        headCache_ = head_.load(std::memory_order_acquire);
+
+                        if (position - headCache_ == size_ && !full(_Overflow()))
+                            return false;
+                    }
+
+                    new (event(position)) _Event(std::move(_event));
+
+                    tail_.store(position + 1, std::memory_order_release);
+
+                    return true;
+                }
+
+                //==============================================================================================================
+                // 
+                // Dispatches events posted before the call in their order, but not more than the count. Returns the number
+                // of dispatched events.
+                // 
+                template <typename _Dispatcher>
+                std::size_t pop(_Dispatcher &_dispatcher, std::size_t _count)
+                {
+                    std::size_t const head = head_.load(std::memory_order_relaxed);
+
+                    if (tailCache_ - head < _count)
+                        tailCache_ = tail_.load(std::memory_order_acquire);
+
+                    std::size_t const count = tailCache_ - head < _count ? tailCache_ - head : _count;
+
+                    if (count == 0)
+                        return 0;
+
+                    Consuming consuming(*this, head);
+
+                    while (consuming.position() != head + count)
+                    {
+                        Releasing releasing(consuming);
+
+                        _dispatcher.dispatch(*static_cast<_Event const *>(event(consuming.position())));
+                    }
+
+                    return count;
+                }
+
+            private:
+                //==============================================================================================================
+                static std::size_t size(std::size_t _capacity) noexcept
+                {
+                    std::size_t size = 2;
+
+                    while (size < _capacity)
+                        size *= 2;
+
+                    return size;
+                }
+
+                //==============================================================================================================
+                _Event *event(std::size_t _position) noexcept
+                {
+                    return reinterpret_cast<_Event *>(cells_ + (_position & (size_ - 1)));
+                }
+
+                //==============================================================================================================
+                // 
+                // The producer yields while the ring is full, so that the consumer can run on the same core.
+                // 
+                bool full(overflow::Block) noexcept
+                {
+                    std::this_thread::yield();
+
+                    return true;
+                }
+
+                //==============================================================================================================
+                // 
+                // Only the producer counts dropped events, so the counter needs no read-modify-write.
+                // 
+                bool full(overflow::DropNewest) noexcept
+                {
+                    dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+                    return false;
+                }
+
+            private:
+                Lane           (Lane const &) = delete;
+                Lane &operator=(Lane const &) = delete;
+
+            private:
+                allocator_t                 allocator_;
+                std::size_t                 size_;
+                Cell                       *cells_;
+                char                        padding_[CACHE_LINE];     // Keeps the tail off the cache line of the cells.
+                std::atomic<std::size_t>    tail_;                    // Stored by the producer.
+                std::size_t                 headCache_;               // The producer's copy of the head.
+                std::atomic<std::uint64_t>  dropped_;                 // Stored by the producer.
+                char                        tailPadding_[CACHE_LINE]; // Keeps the head off the cache line of the tail.
+                std::atomic<std::size_t>    head_;                    // Stored by the consumer.
+                std::size_t                 tailCache_;               // The consumer's copy of the tail.
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
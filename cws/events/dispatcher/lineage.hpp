@@ -0,0 +1,141 @@
+// Template structures computing event types that an event of a hierarchy is dispatched to.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <type_traits>
+
+
+//==============================================================================================================================
+#include "../details.hpp"
+#include "list.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Concatenates lists of types.
+            // 
+            template <typename ..._Lists>
+            struct Concat
+            {
+                typedef TypesList<>  type;
+            };
+
+            //==================================================================================================================
+            template <typename ..._Types>
+            struct Concat<TypesList<_Types...>>
+            {
+                typedef TypesList<_Types...>  type;
+            };
+
+            //==================================================================================================================
+            template <typename ..._First, typename ..._Second, typename ..._Rest>
+            struct Concat<TypesList<_First...>, TypesList<_Second...>, _Rest...> :
+                Concat<TypesList<_First..., _Second...>, _Rest...>
+            {
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Appends _Types to the list of distinct types, skipping each type that occurs again after it, so that the last
+            // occurrence of each type is kept.
+            // 
+            template <typename _Distinct, typename ..._Types>
+            struct Distinct
+            {
+                typedef _Distinct  type;
+            };
+
+            //==================================================================================================================
+            template <typename ..._Distinct, typename _Type, typename ..._Rest>
+            struct Distinct<TypesList<_Distinct...>, _Type, _Rest...> :
+                Distinct<typename std::conditional<IsOneOf<_Type, _Rest...>::value,
+                                                   TypesList<_Distinct...>,
+                                                   TypesList<_Distinct..., _Type>>::type, _Rest...>
+            {
+            };
+
+
+            //==================================================================================================================
+            // 
+            // The event type followed by the ancestries of its bases, which repeat a type reached through several bases.
+            // 
+            template <typename _Event, typename = typename Hierarchy<_Event>::bases_type>
+            struct Ancestry;
+
+            //==================================================================================================================
+            template <typename _Event, typename ..._Bases>
+            struct Ancestry<_Event, TypesList<_Bases...>> :
+                Concat<TypesList<_Event>, typename Ancestry<_Bases>::type...>
+            {
+                static_assert(std::is_same<Bools<true, std::is_base_of<_Bases, _Event>::value...>,
+                                           Bools<std::is_base_of<_Bases, _Event>::value..., true>>::value,
+                              "An event type must be derived from the bases declared by its Hierarchy.");
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Event types of _Events that an event of the type _Event is dispatched to: _Event, and then its bases, each of
+            // them after all types of the hierarchy derived from it. A type occurs before its bases in every path of the
+            // ancestry, so its last occurrence does too.
+            // 
+            template <typename _Event, typename ..._Events>
+            struct Lineage
+            {
+            private:
+                template <typename _List>
+                struct Select;
+
+                template <typename ..._Types>
+                struct Select<TypesList<_Types...>> :
+                    Concat<typename std::conditional<IsOneOf<_Types, _Events...>::value,
+                                                     TypesList<_Types>,
+                                                     TypesList<>>::type...>
+                {
+                };
+
+                template <typename _List>
+                struct Unique;
+
+                template <typename ..._Types>
+                struct Unique<TypesList<_Types...>> :
+                    Distinct<TypesList<>, _Types...>
+                {
+                };
+
+            public:
+                typedef typename Select<typename Unique<typename Ancestry<_Event>::type>::type>::type  type;
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
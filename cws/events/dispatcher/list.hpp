@@ -0,0 +1,73 @@
+// Template structures inspecting lists of types.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <cstddef>
+#include <type_traits>
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            template <bool ..._Values>
+            struct Bools;
+
+
+            //==================================================================================================================
+            // 
+            // Checks whether _Type is one of _Types.
+            // 
+            template <typename _Type, typename ..._Types>
+            struct IsOneOf :
+                std::integral_constant<bool, !std::is_same<Bools<false, std::is_same<_Type, _Types>::value...>,
+                                                           Bools<std::is_same<_Type, _Types>::value..., false>>::value>
+            {
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Index of _Type in _Types. _Type must be one of _Types.
+            // 
+            template <typename _Type, typename _This, typename ..._Rest>
+            struct IndexOf :
+                std::integral_constant<std::size_t, 1 + IndexOf<_Type, _Rest...>::value>
+            {
+            };
+
+            //==================================================================================================================
+            template <typename _Type, typename ..._Rest>
+            struct IndexOf<_Type, _Type, _Rest...> :
+                std::integral_constant<std::size_t, 0>
+            {
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
@@ -0,0 +1,452 @@
+// cws::events::dispatcher::Listener class is a small type-erased invoker of a listener used by flat backends.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+//==============================================================================================================================
+#include <boost/function_equal.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+
+//==============================================================================================================================
+#include "../delegate.hpp"
+#include "allocator.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Member function bound to an object managed by a shared pointer. Invokes the member function only while the
+            // object is alive.
+            // 
+            template <typename _Bound, typename _Weak>
+            class Tracked
+            {
+            public:
+                //==============================================================================================================
+                Tracked(_Bound &&_bound, _Weak &&_object)
+                    : bound_ (std::move(_bound))
+                    , object_(std::move(_object))
+                {
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                void operator()(_Event const &_event)
+                {
+                    if (auto const locked = object_.lock())
+                        bound_(_event);
+                }
+
+                //==============================================================================================================
+                bool operator==(Tracked const &_other) const
+                {
+                    using boost::function_equal;
+
+                    return function_equal(bound_, _other.bound_);
+                }
+
+                //==============================================================================================================
+                bool expired() const
+                {
+                    return object_.expired();
+                }
+
+            private:
+                _Bound bound_;
+                _Weak  object_;
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Makes a member function listener tracking the object managed by std::shared_ptr.
+            // 
+            template <typename _Event, typename _Function, typename _Object>
+            inline auto make_tracked(_Function &&_function, std::shared_ptr<_Object> const &_object)
+            {
+                auto bound = bind_object<_Event>(std::forward<_Function>(_function), _object.get());
+
+                return Tracked<decltype(bound), std::weak_ptr<_Object>>(std::move(bound), std::weak_ptr<_Object>(_object));
+            }
+
+            //==================================================================================================================
+            // 
+            // Makes a member function listener tracking the object managed by boost::shared_ptr.
+            // 
+            template <typename _Event, typename _Function, typename _Object>
+            inline auto make_tracked(_Function &&_function, boost::shared_ptr<_Object> const &_object)
+            {
+                auto bound = bind_object<_Event>(std::forward<_Function>(_function), _object.get());
+
+                return Tracked<decltype(bound), boost::weak_ptr<_Object>>(std::move(bound), boost::weak_ptr<_Object>(_object));
+            }
+
+
+            //==================================================================================================================
+            // 
+            // Checks whether the listener can no longer be invoked. Only tracked listeners can expire.
+            // 
+            template <typename _Callable>
+            inline bool is_expired(_Callable const &)
+            {
+                return false;
+            }
+
+            //==================================================================================================================
+            template <typename _Bound, typename _Weak>
+            inline bool is_expired(Tracked<_Bound, _Weak> const &_tracked)
+            {
+                return _tracked.expired();
+            }
+
+
+            //==================================================================================================================
+            // 
+            // Type-erased listener of the specified event. Callable objects that fit into the internal storage of the
+            // specified size and are nothrow-movable and copyable are stored in place. Others are allocated by the specified
+            // allocator, and copies of the listener share the allocation, so that copying arrays of listeners neither
+            // allocates nor requires callable objects to be copyable.
+            // 
+            template <typename _Event, std::size_t _Size, typename _Allocator>
+            class Listener
+            {
+                typedef typename std::aligned_storage<_Size>::type  storage_t;
+                typedef void (*invoke_t)(void const *, _Event const &);
+
+                //==============================================================================================================
+                // 
+                // Operations on a stored callable object that are not required to invoke it.
+                // 
+                struct Table
+                {
+                    void (*copy)   (storage_t const &, storage_t &);
+                    void (*move)   (storage_t &, storage_t &);
+                    void (*destroy)(storage_t &);
+                    bool (*expired)(storage_t const &);
+                };
+
+                //==============================================================================================================
+                template <typename _Callable>
+                struct IsLocal :
+                    std::integral_constant<bool, sizeof(_Callable) <= sizeof(storage_t) &&
+                                                 alignof(_Callable) <= alignof(storage_t) &&
+                                                 std::is_nothrow_move_constructible<_Callable>::value &&
+                                                 std::is_copy_constructible<_Callable>::value>
+                {
+                };
+
+                //==============================================================================================================
+                template <typename _Callable, bool = IsLocal<_Callable>::value>
+                struct Storage;
+
+                //==============================================================================================================
+                // 
+                // Callable object stored in place.
+                // 
+                template <typename _Callable>
+                struct Storage<_Callable, true>
+                {
+                    static _Callable &get(storage_t &_storage)
+                    {
+                        return reinterpret_cast<_Callable &>(_storage);
+                    }
+
+                    static _Callable const &get(storage_t const &_storage)
+                    {
+                        return reinterpret_cast<_Callable const &>(_storage);
+                    }
+
+                    template <typename _Source>
+                    static void create(storage_t &_storage, _Source &&_source)
+                    {
+                        new (&_storage) _Callable(std::forward<_Source>(_source));
+                    }
+
+                    template <typename _Source>
+                    static void create(storage_t &_storage, _Source &&_source, _Allocator const &)
+                    {
+                        create(_storage, std::forward<_Source>(_source));
+                    }
+
+                    static void copy(storage_t const &_source, storage_t &_target)
+                    {
+                        create(_target, get(_source));
+                    }
+
+                    static void move(storage_t &_source, storage_t &_target)
+                    {
+                        create(_target, std::move(get(_source)));
+                        destroy(_source);
+                    }
+
+                    static void destroy(storage_t &_storage)
+                    {
+                        get(_storage).~_Callable();
+                    }
+                };
+
+                //==============================================================================================================
+                // 
+                // Callable object allocated by the allocator and shared by copies of the listener. Copies can be destroyed
+                // concurrently, after the lock is released.
+                // 
+                template <typename _Callable>
+                struct Storage<_Callable, false>
+                {
+                    struct Shared
+                    {
+                        template <typename _Source>
+                        Shared(_Source &&_source, _Allocator const &_allocator)
+                            : callable  (std::forward<_Source>(_source))
+                            , references(1)
+                            , allocator (_allocator)
+                        {
+                        }
+
+                        _Callable                 callable;
+                        std::atomic<std::size_t>  references;
+                        _Allocator                allocator;
+                    };
+
+                    static Shared *&shared(storage_t &_storage)
+                    {
+                        return reinterpret_cast<Shared *&>(_storage);
+                    }
+
+                    static Shared * const &shared(storage_t const &_storage)
+                    {
+                        return reinterpret_cast<Shared * const &>(_storage);
+                    }
+
+                    static _Callable &get(storage_t &_storage)
+                    {
+                        return shared(_storage)->callable;
+                    }
+
+                    static _Callable const &get(storage_t const &_storage)
+                    {
+                        return shared(_storage)->callable;
+                    }
+
+                    template <typename _Source>
+                    static void create(storage_t &_storage, _Source &&_source, _Allocator const &_allocator)
+                    {
+                        new (&_storage) Shared *(allocate_object<Shared>(_allocator, std::forward<_Source>(_source),
+                                                                         _allocator));
+                    }
+
+                    static void copy(storage_t const &_source, storage_t &_target)
+                    {
+                        shared(_source)->references.fetch_add(1, std::memory_order_relaxed);
+
+                        new (&_target) Shared *(shared(_source));
+                    }
+
+                    static void move(storage_t &_source, storage_t &_target)
+                    {
+                        new (&_target) Shared *(shared(_source));
+                    }
+
+                    static void destroy(storage_t &_storage)
+                    {
+                        if (shared(_storage)->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                            deallocate_object(shared(_storage)->allocator, shared(_storage));
+                    }
+                };
+
+                //==============================================================================================================
+                template <typename _Callable>
+                struct Manager :
+                    Storage<_Callable>
+                {
+                    // 
+                    // The storage is owned by the listener, which is not constant, so the callable object can be modified.
+                    // 
+                    static void invoke(void const *_storage, _Event const &_event)
+                    {
+                        Manager::get(*const_cast<storage_t *>(static_cast<storage_t const *>(_storage)))(_event);
+                    }
+
+                    static bool expired(storage_t const &_storage)
+                    {
+                        return is_expired(Manager::get(_storage));
+                    }
+
+                    static Table table;
+                };
+
+                //==============================================================================================================
+                template <typename _Callable>
+                static invoke_t invoker(_Callable const &)
+                {
+                    return &Manager<_Callable>::invoke;
+                }
+
+                //==============================================================================================================
+                // 
+                // Delegate stored in place at the beginning of the storage is invoked by its own invoker directly.
+                // 
+                static invoke_t invoker(Delegate<_Event> const &_delegate)
+                {
+                    return invoker(_delegate, IsLocal<Delegate<_Event>>());
+                }
+
+                //==============================================================================================================
+                static invoke_t invoker(Delegate<_Event> const &_delegate, std::true_type)
+                {
+                    return _delegate.invoke_;
+                }
+
+                //==============================================================================================================
+                static invoke_t invoker(Delegate<_Event> const &, std::false_type)
+                {
+                    return &Manager<Delegate<_Event>>::invoke;
+                }
+
+            public:
+                //==============================================================================================================
+                template <typename _Callable>
+                Listener(_Callable &&_callable, _Allocator const &_allocator)
+                    : table_(&Manager<typename std::decay<_Callable>::type>::table)
+                {
+                    Manager<typename std::decay<_Callable>::type>::create(storage_, std::forward<_Callable>(_callable),
+                                                                          _allocator);
+
+                    invoke_ = invoker(Manager<typename std::decay<_Callable>::type>::get(storage_));
+                }
+
+                //==============================================================================================================
+                Listener(Listener const &_source)
+                    : invoke_(_source.invoke_)
+                    , table_ (_source.table_)
+                {
+                    table_->copy(_source.storage_, storage_);
+                }
+
+                //==============================================================================================================
+                Listener(Listener &&_source) noexcept
+                    : invoke_(_source.invoke_)
+                    , table_ (_source.table_)
+                {
+                    table_->move(_source.storage_, storage_);
+
+                    _source.table_ = nullptr;
+                }
+
+                //==============================================================================================================
+                ~Listener()
+                {
+                    if (table_ != nullptr)
+                        table_->destroy(storage_);
+                }
+
+                //==============================================================================================================
+                Listener &operator=(Listener const &_source)
+                {
+                    Listener that(_source);
+
+                    return *this = std::move(that);
+                }
+
+                //==============================================================================================================
+                Listener &operator=(Listener &&_source) noexcept
+                {
+                    if (this != &_source)
+                    {
+                        this->~Listener();
+
+                        new (this) Listener(std::move(_source));
+                    }
+
+                    return *this;
+                }
+
+                //==============================================================================================================
+                void operator()(_Event const &_event)
+                {
+                    invoke_(&storage_, _event);
+                }
+
+                //==============================================================================================================
+                // 
+                // Compares the stored callable object with the specified one. Objects of different types are never equal.
+                // 
+                template <typename _Callable>
+                bool equals(_Callable const &_callable) const
+                {
+                    typedef typename std::decay<_Callable>::type  callable_t;
+
+                    callable_t const &callable = _callable;
+
+                    using boost::function_equal;
+
+                    return table_ == &Manager<callable_t>::table &&
+                           function_equal(Manager<callable_t>::get(storage_), callable);
+                }
+
+                //==============================================================================================================
+                bool expired() const
+                {
+                    return table_->expired(storage_);
+                }
+
+            private:
+                invoke_t      invoke_;
+                Table const  *table_;
+                storage_t     storage_;
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Non-constant, so that tables of different callable types never share an address.
+            // 
+            template <typename _Event, std::size_t _Size, typename _Allocator>
+            template <typename _Callable>
+            typename Listener<_Event, _Size, _Allocator>::Table Listener<_Event, _Size, _Allocator>::Manager<_Callable>::table =
+            {
+                &Listener<_Event, _Size, _Allocator>::Manager<_Callable>::copy,
+                &Listener<_Event, _Size, _Allocator>::Manager<_Callable>::move,
+                &Listener<_Event, _Size, _Allocator>::Manager<_Callable>::destroy,
+                &Listener<_Event, _Size, _Allocator>::Manager<_Callable>::expired,
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
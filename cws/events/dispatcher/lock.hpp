@@ -0,0 +1,75 @@
+// cws::events::dispatcher::SharedLockType structure selects the lock that dispatching takes on a dispatcher's mutex.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Checks whether the mutex has public methods lock_shared() and unlock_shared() in addition to lock() and
+            // unlock(), like std::shared_timed_mutex and boost::shared_mutex.
+            // 
+            template <typename _Mutex, typename = void>
+            struct IsSharedLockable :
+                std::false_type
+            {
+            };
+
+            //==================================================================================================================
+            template <typename _Mutex>
+            struct IsSharedLockable<_Mutex, decltype(std::declval<_Mutex &>().lock_shared(),
+                                                     std::declval<_Mutex &>().unlock_shared(), void())> :
+                std::true_type
+            {
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Lock that dispatching takes on the mutex: a shared lock if the mutex is shared-lockable, so that dispatches of
+            // different threads run concurrently, and an exclusive one otherwise. Subscribing and unsubscribing always take
+            // an exclusive lock.
+            // 
+            template <typename _Mutex>
+            struct SharedLockType
+            {
+                typedef typename std::conditional<IsSharedLockable<_Mutex>::value,
+                                                  std::shared_lock<_Mutex>,
+                                                  std::lock_guard<_Mutex>>::type  type;
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
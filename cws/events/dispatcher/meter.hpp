@@ -0,0 +1,743 @@
+// cws::events::dispatcher::Meter class collects statistics of dispatcher's events.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+
+//==============================================================================================================================
+#include <boost/core/demangle.hpp>
+#include <boost/function_equal.hpp>
+
+
+//==============================================================================================================================
+#include "../stats.hpp"
+#include "allocator.hpp"
+#include "list.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            template <typename _Stats, typename _Connection, typename _Allocator, typename ..._Events>
+            class Meter;
+
+
+            //==================================================================================================================
+            // 
+            // Passes a listener as is, and a labeled listener without its label.
+            // 
+            template <typename _Callable>
+            inline _Callable &&unlabel(_Callable &&_callable) noexcept
+            {
+                return std::forward<_Callable>(_callable);
+            }
+
+            //==================================================================================================================
+            template <typename _Callable>
+            inline _Callable &&unlabel(stats::Labeled<_Callable> &&_labeled) noexcept
+            {
+                return std::move(_labeled.callable);
+            }
+
+            //==================================================================================================================
+            template <typename _Callable>
+            inline _Callable const &unlabel(stats::Labeled<_Callable> const &_labeled) noexcept
+            {
+                return _labeled.callable;
+            }
+
+            //==================================================================================================================
+            template <typename _Callable>
+            inline _Callable &unlabel(stats::Labeled<_Callable> &_labeled) noexcept
+            {
+                return _labeled.callable;
+            }
+
+
+            //==================================================================================================================
+            // 
+            // Running aggregates of durations of a listener's invocations.
+            // 
+            struct Profile
+            {
+                explicit Profile(std::string &&_label)
+                    : label      (std::move(_label))
+                    , invocations(0)
+                    , total      (0)
+                    , max        (0)
+                    , latency    ()
+                {
+                }
+
+                void record(std::uint64_t _nanoseconds) noexcept
+                {
+                    invocations.fetch_add(1, std::memory_order_relaxed);
+                    total.fetch_add(_nanoseconds, std::memory_order_relaxed);
+                    latency[stats::Histogram::bucket(_nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+
+                    std::uint64_t longest = max.load(std::memory_order_relaxed);
+
+                    while (longest < _nanoseconds &&
+                           !max.compare_exchange_weak(longest, _nanoseconds, std::memory_order_relaxed))
+                    {
+                    }
+                }
+
+                std::string const           label;
+                std::atomic<std::uint64_t>  invocations;
+                std::atomic<std::uint64_t>  total;
+                std::atomic<std::uint64_t>  max;
+                std::atomic<std::uint64_t>  latency[stats::Histogram::BUCKETS_COUNT];
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Listener timing each invocation of the wrapped one into its profile. Listeners are compared by the wrapped
+            // ones, so a wrapper without profile finds the listener to remove.
+            // 
+            template <typename _Callable>
+            class Timed
+            {
+            public:
+                //==============================================================================================================
+                template <typename _Argument>
+                Timed(_Argument &&_callable, std::shared_ptr<Profile> _profile)
+                    : callable_(std::forward<_Argument>(_callable))
+                    , profile_ (std::move(_profile))
+                {
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                void operator()(_Event const &_event) const
+                {
+                    std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+                    callable_(_event);
+
+                    std::chrono::nanoseconds const duration = std::chrono::steady_clock::now() - start;
+
+                    profile_->record(static_cast<std::uint64_t>(duration.count()));
+                }
+
+                //==============================================================================================================
+                friend bool operator==(Timed const &_left, Timed const &_right)
+                {
+                    using boost::function_equal;
+
+                    return function_equal(_left.callable_, _right.callable_);
+                }
+
+            private:
+                mutable _Callable         callable_;
+                std::shared_ptr<Profile>  profile_;
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Meter collecting nothing. It is empty, and its functions do nothing, so that they compile to nothing.
+            // 
+            template <typename _Connection, typename _Allocator, typename ..._Events>
+            class Meter<stats::Disabled, _Connection, _Allocator, _Events...>
+            {
+            protected:
+                //==============================================================================================================
+                struct Start
+                {
+                };
+
+                //==============================================================================================================
+                // 
+                // Subscription of a listener, which is passed to the head as is.
+                // 
+                template <typename _Event>
+                class Subscription
+                {
+                public:
+                    explicit Subscription(Meter &) noexcept
+                    {
+                    }
+
+                    template <typename _Callable>
+                    static decltype(auto) wrap(_Callable &&_callable) noexcept
+                    {
+                        return unlabel(std::forward<_Callable>(_callable));
+                    }
+
+                    static _Connection commit(_Connection &&_connection)
+                    {
+                        return std::move(_connection);
+                    }
+                };
+
+                //==============================================================================================================
+                explicit Meter(_Allocator const &) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                Meter(Meter &&) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                void swap(Meter &) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                static Start start() noexcept
+                {
+                    return Start();
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                void dispatched(Start const &, std::size_t, std::size_t) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                // 
+                // Returns the listener to compare subscribed listeners with.
+                // 
+                template <typename _Callable>
+                static decltype(auto) match(_Callable &&_callable) noexcept
+                {
+                    return unlabel(std::forward<_Callable>(_callable));
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                void unsubscribed() noexcept
+                {
+                }
+
+                //==============================================================================================================
+                void unsubscribed_all() noexcept
+                {
+                }
+
+            private:
+                Meter           (Meter const &) = delete;
+                Meter &operator=(Meter const &) = delete;
+                Meter &operator=(Meter &&)      = delete;
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Meter collecting statistics of each event in counters sharded by threads. A thread updates the shard chosen by
+            // the order in which threads first used any meter, so that up to SHARDS_COUNT threads update distinct cache lines.
+            // The latency histogram is not sharded, since it is large and its buckets are spread by durations. Counters are
+            // updated by relaxed atomic additions, since threads share shards and histograms. Counters of an event are
+            // allocated by the allocator when the event is first subscribed, unsubscribed, or dispatched, so events that are
+            // never used cost a pointer. Concurrent threads agree on a single allocation without locking.
+            // 
+            template <typename _Connection, typename _Allocator, typename ..._Events>
+            class Meter<stats::Enabled, _Connection, _Allocator, _Events...>
+            {
+                static std::size_t const SHARDS_COUNT = 8;
+                static std::size_t const SHARD_SIZE   = 128;
+
+                //==============================================================================================================
+                // 
+                // Shards are padded to two cache lines, so that counters of different shards never share a cache line
+                // whatever the alignment of the counters.
+                // 
+                struct Shard
+                {
+                    std::atomic<std::uint64_t>  dispatches;
+                    std::atomic<std::uint64_t>  invocations;
+                    std::atomic<std::uint64_t>  subscribes;
+                    std::atomic<std::uint64_t>  unsubscribes;
+                    char                        padding[SHARD_SIZE - 4 * sizeof(std::atomic<std::uint64_t>)];
+                };
+
+                //==============================================================================================================
+                // 
+                // Counters of an event. Value-initialized, so that the counters are zeroed.
+                // 
+                struct Counters
+                {
+                    Shard                       shards[SHARDS_COUNT];
+                    std::atomic<std::uint64_t>  latency[stats::Histogram::BUCKETS_COUNT];
+                };
+
+            protected:
+                //==============================================================================================================
+                typedef std::chrono::steady_clock::time_point  Start;
+
+                //==============================================================================================================
+                // 
+                // Subscription of a listener, which is counted when the head returns its connection.
+                // 
+                template <typename _Event>
+                class Subscription
+                {
+                public:
+                    explicit Subscription(Meter &_meter) noexcept
+                        : meter_(_meter)
+                    {
+                    }
+
+                    template <typename _Callable>
+                    static decltype(auto) wrap(_Callable &&_callable) noexcept
+                    {
+                        return unlabel(std::forward<_Callable>(_callable));
+                    }
+
+                    _Connection commit(_Connection &&_connection)
+                    {
+                        meter_.template subscribed<_Event>();
+
+                        return std::move(_connection);
+                    }
+
+                private:
+                    Meter &meter_;
+                };
+
+                //==============================================================================================================
+                explicit Meter(_Allocator const &_allocator) noexcept
+                    : allocator_(_allocator)
+                {
+                    for (std::atomic<Counters *> &counters : counters_)
+                        counters.store(nullptr, std::memory_order_relaxed);
+                }
+
+                //==============================================================================================================
+                // 
+                // The source is left without counters, as if it has collected nothing.
+                // 
+                Meter(Meter &&_source) noexcept
+                    : allocator_(_source.allocator_)
+                {
+                    for (std::size_t i = 0; i != sizeof...(_Events); ++i)
+                        counters_[i].store(_source.counters_[i].exchange(nullptr), std::memory_order_relaxed);
+                }
+
+                //==============================================================================================================
+                ~Meter()
+                {
+                    for (std::atomic<Counters *> &counters : counters_)
+                        deallocate_object(allocator_, counters.load());
+                }
+
+                //==============================================================================================================
+                void swap(Meter &_source) noexcept
+                {
+                    using std::swap;
+
+                    swap(allocator_, _source.allocator_);
+
+                    for (std::size_t i = 0; i != sizeof...(_Events); ++i)
+                        counters_[i] = _source.counters_[i].exchange(counters_[i].load());
+                }
+
+                //==============================================================================================================
+                static Start start() noexcept
+                {
+                    return std::chrono::steady_clock::now();
+                }
+
+                //==============================================================================================================
+                // 
+                // Records dispatching of the events started at the specified time, which invoked the listeners.
+                // 
+                template <typename _Event>
+                void dispatched(Start const &_start, std::size_t _eventsCount, std::size_t _invocations) noexcept
+                {
+                    std::chrono::nanoseconds const duration = std::chrono::steady_clock::now() - _start;
+
+                    if (_eventsCount == 0)
+                        return;
+
+                    Counters *counters = find<_Event>();
+
+                    if (counters == nullptr)
+                        return;
+
+                    std::uint64_t const nanoseconds = static_cast<std::uint64_t>(duration.count()) / _eventsCount;
+
+                    Shard &shard = counters->shards[shard_index()];
+
+                    add(shard.dispatches,  _eventsCount);
+                    add(shard.invocations, _invocations);
+                    add(counters->latency[stats::Histogram::bucket(nanoseconds)], _eventsCount);
+                }
+
+                //==============================================================================================================
+                template <typename _Callable>
+                static decltype(auto) match(_Callable &&_callable) noexcept
+                {
+                    return unlabel(std::forward<_Callable>(_callable));
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                void subscribed() noexcept
+                {
+                    if (Counters *counters = find<_Event>())
+                        add(counters->shards[shard_index()].subscribes, 1);
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                void unsubscribed() noexcept
+                {
+                    if (Counters *counters = find<_Event>())
+                        add(counters->shards[shard_index()].unsubscribes, 1);
+                }
+
+                //==============================================================================================================
+                // 
+                // Counts unsubscribing from the events that have counters, as others have had no listeners.
+                // 
+                void unsubscribed_all() noexcept
+                {
+                    for (std::atomic<Counters *> &counters : counters_)
+                    {
+                        if (Counters *allocated = counters.load(std::memory_order_acquire))
+                            add(allocated->shards[shard_index()].unsubscribes, 1);
+                    }
+                }
+
+                //==============================================================================================================
+                // 
+                // Sums the shards. Counters updated concurrently may be taken before or after the update.
+                // 
+                std::vector<stats::EventStats> collect() const
+                {
+                    std::vector<stats::EventStats> events = { make<_Events>()... };
+
+                    for (std::size_t i = 0; i != events.size(); ++i)
+                    {
+                        Counters const *counters = counters_[i].load(std::memory_order_acquire);
+
+                        if (counters == nullptr)
+                            continue;
+
+                        for (Shard const &shard : counters->shards)
+                        {
+                            events[i].dispatches   += shard.dispatches.load(std::memory_order_relaxed);
+                            events[i].invocations  += shard.invocations.load(std::memory_order_relaxed);
+                            events[i].subscribes   += shard.subscribes.load(std::memory_order_relaxed);
+                            events[i].unsubscribes += shard.unsubscribes.load(std::memory_order_relaxed);
+                        }
+
+                        for (std::size_t j = 0; j != stats::Histogram::BUCKETS_COUNT; ++j)
+                            events[i].latency.counts[j] = counters->latency[j].load(std::memory_order_relaxed);
+                    }
+
+                    return events;
+                }
+
+            private:
+                //==============================================================================================================
+                // 
+                // The shard of the current thread.
+                // 
+                static std::size_t shard_index() noexcept
+                {
+                    static std::atomic<std::size_t> threadsCount(0);
+                    static thread_local std::size_t const index = threadsCount.fetch_add(1, std::memory_order_relaxed) %
+                                                                  SHARDS_COUNT;
+
+                    return index;
+                }
+
+                //==============================================================================================================
+                // 
+                // Counters of the event, which are allocated if the event has not been used yet. Returns nullptr if the
+                // counters cannot be allocated, so that the event is not counted rather than dispatching throws.
+                // 
+                template <typename _Event>
+                Counters *find() noexcept
+                {
+                    std::atomic<Counters *> &slot     = counters_[IndexOf<_Event, _Events...>::value];
+                    Counters                *counters = slot.load(std::memory_order_acquire);
+
+                    if (counters != nullptr)
+                        return counters;
+
+                    Counters *created = nullptr;
+
+                    try
+                    {
+                        created = allocate_object<Counters>(allocator_);
+                    }
+                    catch (...)
+                    {
+                        return nullptr;
+                    }
+
+                    if (slot.compare_exchange_strong(counters, created, std::memory_order_acq_rel))
+                        return created;
+
+                    deallocate_object(allocator_, created);
+
+                    return counters;
+                }
+
+                //==============================================================================================================
+                static void add(std::atomic<std::uint64_t> &_counter, std::uint64_t _value) noexcept
+                {
+                    _counter.fetch_add(_value, std::memory_order_relaxed);
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                static stats::EventStats make()
+                {
+                    stats::EventStats event = { boost::core::demangle(typeid(_Event).name()), 0, 0, 0, 0, {} };
+
+                    return event;
+                }
+
+            private:
+                Meter           (Meter const &) = delete;
+                Meter &operator=(Meter const &) = delete;
+                Meter &operator=(Meter &&)      = delete;
+
+            private:
+                _Allocator               allocator_;
+                std::atomic<Counters *>  counters_[sizeof...(_Events)];
+            };
+
+
+
+            //==================================================================================================================
+            // 
+            // Meter collecting statistics as the enabled meter does and profiling listeners. A subscribed listener is wrapped
+            // into Timed together with a new profile, which the meter keeps with the listener's connection. A profile is
+            // dropped when the meter is its only owner, that is the listener has been destroyed.
+            // 
+            template <typename _Connection, typename _Allocator, typename ..._Events>
+            class Meter<stats::Profiled, _Connection, _Allocator, _Events...> :
+                public Meter<stats::Enabled, _Connection, _Allocator, _Events...>
+            {
+                typedef Meter<stats::Enabled, _Connection, _Allocator, _Events...>  base_t;
+
+                //==============================================================================================================
+                struct Entry
+                {
+                    std::size_t               event;
+                    _Connection               connection;
+                    std::shared_ptr<Profile>  profile;
+                };
+
+                typedef std::vector<Entry, Rebind<Entry, _Allocator>>  entries_t;
+
+            protected:
+                //==============================================================================================================
+                // 
+                // Subscription of a listener, which is wrapped with a new profile. The profile is kept by the meter when
+                // the head returns the connection of the listener.
+                // 
+                template <typename _Event>
+                class Subscription
+                {
+                public:
+                    explicit Subscription(Meter &_meter) noexcept
+                        : meter_(_meter)
+                    {
+                    }
+
+                    template <typename _Callable>
+                    auto wrap(_Callable &&_callable)
+                    {
+                        typedef typename std::decay<decltype(unlabel(std::forward<_Callable>(_callable)))>::type  callable_t;
+
+                        profile_ = std::allocate_shared<Profile>(meter_.entries_.get_allocator(), label_of(_callable));
+
+                        return Timed<callable_t>(unlabel(std::forward<_Callable>(_callable)), profile_);
+                    }
+
+                    _Connection commit(_Connection &&_connection)
+                    {
+                        meter_.template subscribed<_Event>();
+
+                        if (profile_)
+                            meter_.enroll(IndexOf<_Event, _Events...>::value, _connection, std::move(profile_));
+
+                        return std::move(_connection);
+                    }
+
+                private:
+                    template <typename _Callable>
+                    static std::string label_of(stats::Labeled<_Callable> const &_labeled)
+                    {
+                        return _labeled.label;
+                    }
+
+                    template <typename _Callable>
+                    static std::string label_of(_Callable const &)
+                    {
+                        return boost::core::demangle(typeid(_Callable).name());
+                    }
+
+                private:
+                    Meter                     &meter_;
+                    std::shared_ptr<Profile>   profile_;
+                };
+
+                //==============================================================================================================
+                explicit Meter(_Allocator const &_allocator)
+                    : base_t  (_allocator)
+                    , entries_(typename entries_t::allocator_type(_allocator))
+                    , swept_  (1)
+                {
+                }
+
+                //==============================================================================================================
+                Meter(Meter &&_source) noexcept
+                    : base_t  (std::move(_source))
+                    , entries_(std::move(_source.entries_))
+                    , swept_  (_source.swept_)
+                {
+                }
+
+                //==============================================================================================================
+                void swap(Meter &_source) noexcept
+                {
+                    base_t::swap(_source);
+
+                    using std::swap;
+
+                    swap(entries_, _source.entries_);
+                    swap(swept_,   _source.swept_);
+                }
+
+                //==============================================================================================================
+                template <typename _Callable>
+                static auto match(_Callable &&_callable)
+                {
+                    typedef typename std::decay<decltype(unlabel(std::forward<_Callable>(_callable)))>::type  callable_t;
+
+                    return Timed<callable_t>(unlabel(std::forward<_Callable>(_callable)), nullptr);
+                }
+
+                //==============================================================================================================
+                // 
+                // Profiles of the listeners sorted by the total duration of their invocations, longest first.
+                // 
+                std::vector<stats::ListenerStats<_Connection>> top(std::size_t _count) const
+                {
+                    std::string const names[] = { boost::core::demangle(typeid(_Events).name())... };
+
+                    std::vector<stats::ListenerStats<_Connection>> listeners;
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+
+                        listeners.reserve(entries_.size());
+
+                        for (Entry const &entry : entries_)
+                        {
+                            if (entry.profile.use_count() > 1)
+                                listeners.push_back(make(entry, names[entry.event]));
+                        }
+                    }
+
+                    std::sort(listeners.begin(), listeners.end(),
+                              [](stats::ListenerStats<_Connection> const &_left,
+                                 stats::ListenerStats<_Connection> const &_right)
+                    {
+                        return _left.total > _right.total;
+                    });
+
+                    if (listeners.size() > _count)
+                        listeners.erase(listeners.begin() + static_cast<std::ptrdiff_t>(_count), listeners.end());
+
+                    return listeners;
+                }
+
+            private:
+                //==============================================================================================================
+                // 
+                // Keeps the profile. Profiles of destroyed listeners are dropped when the number of entries has doubled since
+                // they were dropped last time, so that subscribing takes amortized constant time.
+                // 
+                void enroll(std::size_t _event, _Connection const &_connection, std::shared_ptr<Profile> &&_profile)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+
+                    if (entries_.size() >= 2 * swept_)
+                    {
+                        entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                                      [](Entry const &_entry) { return _entry.profile.use_count() == 1; }),
+                                       entries_.end());
+
+                        swept_ = std::max<std::size_t>(entries_.size(), 1);
+                    }
+
+                    entries_.push_back(Entry{ _event, _connection, std::move(_profile) });
+                }
+
+                //==============================================================================================================
+                static stats::ListenerStats<_Connection> make(Entry const &_entry, std::string const &_event)
+                {
+                    Profile const &profile = *_entry.profile;
+
+                    stats::Histogram latency;
+
+                    for (std::size_t i = 0; i != stats::Histogram::BUCKETS_COUNT; ++i)
+                        latency.counts[i] = profile.latency[i].load(std::memory_order_relaxed);
+
+                    return stats::ListenerStats<_Connection>{ _entry.connection, _event, profile.label,
+                                                              profile.invocations.load(std::memory_order_relaxed),
+                                                              profile.total.load(std::memory_order_relaxed),
+                                                              profile.max.load(std::memory_order_relaxed),
+                                                              latency.quantile(0.99) };
+                }
+
+            private:
+                mutable std::mutex  mutex_;
+                entries_t           entries_;  // Guarded by mutex_.
+                std::size_t         swept_;    // Number of entries left by the last sweep, guarded by mutex_.
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
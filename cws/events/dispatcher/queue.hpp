@@ -0,0 +1,483 @@
+// cws::events::dispatcher::Queue class keeps events enqueued to a dispatcher until they are processed.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+//==============================================================================================================================
+#include "../details.hpp"
+#include "allocator.hpp"
+#include "index.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // FIFO queue of events of different types. Events are stored one after another in blocks of memory together with
+            // functions dispatching and destroying them, so that a block holds many events and is reused when all of them are
+            // processed.
+            // 
+            // Events are enqueued under the lock into the pending list of blocks. Processing moves the pending list to the
+            // processing one under the lock and dispatches its events without locking, so that only one thread at a time can
+            // process the queue, while any thread can enqueue.
+            // 
+            // Blocks are allocated by the allocator as arrays of block headers, so that they are aligned without an
+            // allocator supporting over-alignment.
+            // 
+            // Pending events of coalesced types are indexed by their keys under the lock, so that an event replaces the
+            // pending event with the same key. Each processing starts a new generation of pending events, which makes the
+            // indices stale without touching them.
+            // 
+            template <typename _Mutex, typename _Allocator, typename ..._Events>
+            class Queue : private Indices<_Allocator, _Events...>
+            {
+                typedef Indices<_Allocator, _Events...>  indices_t;
+
+                static std::size_t const BLOCK_CAPACITY    = 4096;
+                static std::size_t const FREE_BLOCKS_COUNT = 16;
+                static std::size_t const ALIGNMENT         = alignof(std::max_align_t);
+
+                //==============================================================================================================
+                // 
+                // Enqueued event follows its record.
+                // 
+                struct alignas(ALIGNMENT) Record
+                {
+                    void        (*dispatch)(void *, void *);
+                    void        (*destroy) (void *);
+                    std::size_t   size;      // Size of the record together with the event.
+                };
+
+                //==============================================================================================================
+                // 
+                // Records are placed after the block header between begin and end offsets.
+                // 
+                struct alignas(ALIGNMENT) Block
+                {
+                    Block       *next;
+                    std::size_t  capacity;
+                    std::size_t  begin;
+                    std::size_t  end;
+
+                    Record *record(std::size_t _offset) noexcept
+                    {
+                        return reinterpret_cast<Record *>(reinterpret_cast<char *>(this + 1) + _offset);
+                    }
+                };
+
+                //==============================================================================================================
+                // 
+                // Singly linked list of blocks.
+                // 
+                struct List
+                {
+                    Block *first;
+                    Block *last;
+
+                    void append(List &_other) noexcept
+                    {
+                        if (_other.first == nullptr)
+                            return;
+
+                        if (first == nullptr)
+                            first = _other.first;
+                        else
+                            last->next = _other.first;
+
+                        last         = _other.last;
+                        _other.first = nullptr;
+                        _other.last  = nullptr;
+                    }
+                };
+
+                //==============================================================================================================
+                // 
+                // Destroys the event and removes its record from the block when dispatching ends even if a listener throws.
+                // 
+                class Consuming
+                {
+                public:
+                    Consuming(Block &_block, Record &_record) noexcept
+                        : block_ (_block)
+                        , record_(_record)
+                    {
+                    }
+
+                    ~Consuming()
+                    {
+                        block_.begin += record_.size;
+
+                        record_.destroy(&record_ + 1);
+                    }
+
+                private:
+                    Block  &block_;
+                    Record &record_;
+                };
+
+                //==============================================================================================================
+                template <typename _Target, typename _Event>
+                static void dispatch(void *_target, void *_event)
+                {
+                    static_cast<_Target *>(_target)->dispatch(*static_cast<_Event const *>(_event));
+                }
+
+                //==============================================================================================================
+                template <typename _Event, typename ..._Args>
+                static void construct(void *_place, std::true_type, _Args &&..._args)
+                {
+                    new (_place) _Event(std::forward<_Args>(_args)...);
+                }
+
+                //==============================================================================================================
+                // 
+                // Aggregates are initialized by the arguments.
+                // 
+                template <typename _Event, typename ..._Args>
+                static void construct(void *_place, std::false_type, _Args &&..._args)
+                {
+                    new (_place) _Event{ std::forward<_Args>(_args)... };
+                }
+
+                //==============================================================================================================
+                template <typename _Event>
+                static void destroy(void *_event) noexcept
+                {
+                    static_cast<_Event *>(_event)->~_Event();
+                }
+
+                //==============================================================================================================
+                template <typename _Event, typename ..._Args>
+                static _Event make(std::true_type, _Args &&..._args)
+                {
+                    return _Event(std::forward<_Args>(_args)...);
+                }
+
+                //==============================================================================================================
+                template <typename _Event, typename ..._Args>
+                static _Event make(std::false_type, _Args &&..._args)
+                {
+                    return _Event{ std::forward<_Args>(_args)... };
+                }
+
+            public:
+                //==============================================================================================================
+                explicit Queue(_Allocator const &_allocator)
+                    : indices_t  (_allocator)
+                    , allocator_ (_allocator)
+                    , pending_   { nullptr, nullptr }
+                    , processing_{ nullptr, nullptr }
+                    , free_      (nullptr)
+                    , freeCount_ (0)
+                    , generation_(0)
+                {
+                }
+
+                //==============================================================================================================
+                Queue(Queue &&_source) noexcept
+                    : Queue(_source.allocator_)
+                {
+                    swap(_source);
+                }
+
+                //==============================================================================================================
+                ~Queue()
+                {
+                    clear(processing_);
+                    clear(pending_);
+
+                    while (free_ != nullptr)
+                    {
+                        Block *next = free_->next;
+
+                        deallocate(free_);
+                        free_ = next;
+                    }
+                }
+
+                //==============================================================================================================
+                void swap(Queue &_source) noexcept
+                {
+                    indices_t::swap(_source);
+
+                    using std::swap;
+
+                    swap(allocator_,  _source.allocator_);
+                    swap(pending_,    _source.pending_);
+                    swap(processing_, _source.processing_);
+                    swap(free_,       _source.free_);
+                    swap(freeCount_,  _source.freeCount_);
+                    swap(generation_, _source.generation_);
+                }
+
+                //==============================================================================================================
+                _Allocator const &get_allocator() const noexcept
+                {
+                    return allocator_;
+                }
+
+                //==============================================================================================================
+                // 
+                // Constructs the event in the queue from the arguments. The event will be dispatched by the target of the type
+                // _Target. An event of a coalesced type replaces the pending event with the same key instead.
+                // 
+                template <typename _Target, typename _Event, typename ..._Args>
+                void push(_Args &&..._args)
+                {
+                    static_assert(alignof(_Event) <= ALIGNMENT, "Over-aligned events cannot be enqueued.");
+
+                    push<_Target, _Event>(std::integral_constant<bool, Coalescing<_Event>::coalesced>(),
+                                          std::forward<_Args>(_args)...);
+                }
+
+                //==============================================================================================================
+                // 
+                // Dispatches events enqueued before the call in their order while the predicate allows. Events enqueued
+                // during the call stay in the queue. Returns the number of dispatched events.
+                // 
+                template <typename _Target, typename _Predicate>
+                std::size_t pop(_Target &_target, _Predicate &&_predicate)
+                {
+                    {
+                        std::lock_guard<_Mutex> lock(mutex_);
+
+                        processing_.append(pending_);
+
+                        ++generation_;
+                    }
+
+                    std::size_t count = 0;
+
+                    while (Block *block = processing_.first)
+                    {
+                        while (block->begin != block->end)
+                        {
+                            if (!_predicate())
+                                return count;
+
+                            Record    &record = *block->record(block->begin);
+                            Consuming  consuming(*block, record);
+
+                            ++count;
+
+                            record.dispatch(&_target, &record + 1);
+                        }
+
+                        processing_.first = block->next;
+
+                        if (processing_.first == nullptr)
+                            processing_.last = nullptr;
+
+                        recycle(block);
+                    }
+
+                    return count;
+                }
+
+            private:
+                //==============================================================================================================
+                template <typename _Target, typename _Event, typename ..._Args>
+                void push(std::false_type, _Args &&..._args)
+                {
+                    std::lock_guard<_Mutex> lock(mutex_);
+
+                    place<_Target, _Event>(std::forward<_Args>(_args)...);
+                }
+
+                //==============================================================================================================
+                // 
+                // The event is made and its key is extracted before locking. The pending event is replaced by move
+                // assignment, so it keeps its place in the queue.
+                // 
+                template <typename _Target, typename _Event, typename ..._Args>
+                void push(std::true_type, _Args &&..._args)
+                {
+                    _Event event = make<_Event>(std::is_constructible<_Event, _Args...>(), std::forward<_Args>(_args)...);
+
+                    auto const key = Coalescing<_Event>::key(static_cast<_Event const &>(event));
+
+                    std::lock_guard<_Mutex> lock(mutex_);
+
+                    _Event *&indexed = Index<_Allocator, _Event>::pending(key, generation_);
+
+                    if (indexed != nullptr)
+                        *indexed = std::move(event);
+                    else
+                        indexed = place<_Target, _Event>(std::move(event));
+                }
+
+                //==============================================================================================================
+                // 
+                // Constructs the event at the end of the pending list under the lock, and returns it.
+                // 
+                template <typename _Target, typename _Event, typename ..._Args>
+                _Event *place(_Args &&..._args)
+                {
+                    std::size_t const size = sizeof(Record) + (sizeof(_Event) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+                    Block *block = pending_.last;
+
+                    if (block == nullptr || block->capacity - block->end < size)
+                        block = reserve(size);
+
+                    Record *record = block->record(block->end);
+
+                    construct<_Event>(record + 1, std::is_constructible<_Event, _Args...>(), std::forward<_Args>(_args)...);
+                    new (record) Record{ &Queue::dispatch<_Target, _Event>, &Queue::destroy<_Event>, size };
+
+                    block->end += size;
+
+                    return static_cast<_Event *>(static_cast<void *>(record + 1));
+                }
+
+                //==============================================================================================================
+                // 
+                // Number of block headers taken by a block of the capacity together with its header.
+                // 
+                static std::size_t length(std::size_t _capacity) noexcept
+                {
+                    return 1 + (_capacity + sizeof(Block) - 1) / sizeof(Block);
+                }
+
+                //==============================================================================================================
+                Block *allocate(std::size_t _capacity)
+                {
+                    Rebind<Block, _Allocator> allocator(allocator_);
+
+                    Block *block = std::allocator_traits<Rebind<Block, _Allocator>>::allocate(allocator, length(_capacity));
+
+                    return new (block) Block{ nullptr, _capacity, 0, 0 };
+                }
+
+                //==============================================================================================================
+                void deallocate(Block *_block) noexcept
+                {
+                    Rebind<Block, _Allocator> allocator(allocator_);
+
+                    std::allocator_traits<Rebind<Block, _Allocator>>::deallocate(allocator, _block, length(_block->capacity));
+                }
+
+                //==============================================================================================================
+                // 
+                // Destroys events of the blocks and the blocks.
+                // 
+                void clear(List &_list) noexcept
+                {
+                    while (Block *block = _list.first)
+                    {
+                        for (std::size_t offset = block->begin; offset != block->end; offset += block->record(offset)->size)
+                            block->record(offset)->destroy(block->record(offset) + 1);
+
+                        _list.first = block->next;
+
+                        deallocate(block);
+                    }
+
+                    _list.last = nullptr;
+                }
+
+                //==============================================================================================================
+                // 
+                // Appends a free or a new block, which is large enough for the record, to the pending list.
+                // 
+                Block *reserve(std::size_t _size)
+                {
+                    Block *block = nullptr;
+
+                    if (free_ != nullptr && _size <= BLOCK_CAPACITY)
+                    {
+                        block = free_;
+                        free_ = block->next;
+                        --freeCount_;
+
+                        block->next = nullptr;
+                    }
+                    else
+                    {
+                        block = allocate(_size > BLOCK_CAPACITY ? _size : BLOCK_CAPACITY);
+                    }
+
+                    List list{ block, block };
+
+                    pending_.append(list);
+
+                    return block;
+                }
+
+                //==============================================================================================================
+                // 
+                // Keeps the processed block for reuse, unless there are enough free blocks or the block is oversized.
+                // 
+                void recycle(Block *_block) noexcept
+                {
+                    if (_block->capacity == BLOCK_CAPACITY)
+                    {
+                        std::lock_guard<_Mutex> lock(mutex_);
+
+                        if (freeCount_ != FREE_BLOCKS_COUNT)
+                        {
+                            _block->next  = free_;
+                            _block->begin = 0;
+                            _block->end   = 0;
+
+                            free_ = _block;
+                            ++freeCount_;
+
+                            return;
+                        }
+                    }
+
+                    deallocate(_block);
+                }
+
+            private:
+                Queue           (Queue const &) = delete;
+                Queue &operator=(Queue const &) = delete;
+                Queue &operator=(Queue &&)      = delete;
+
+            private:
+                _Allocator   allocator_;
+                _Mutex       mutex_;
+                List         pending_;     // Guarded by the mutex.
+                List         processing_;  // Used only by the processing thread.
+                Block       *free_;        // Guarded by the mutex.
+                std::size_t  freeCount_;   // Guarded by the mutex.
+                std::size_t  generation_;  // Guarded by the mutex. Number of processings started.
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
@@ -0,0 +1,209 @@
+// cws::events::dispatcher::Rank class orders listeners of flat backends by their group and priority.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+
+//==============================================================================================================================
+#include <boost/optional.hpp>
+
+
+//==============================================================================================================================
+#include "../details.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Position of a listener in the order of invocation: listeners subscribed to the front without priority, then
+            // listeners with priorities ordered by the comparator, then listeners subscribed to the back without priority.
+            // Listeners of equal ranks make a group, which keeps the order of subscription.
+            // 
+            // A rank of an unbounded priority type keeps the priority and compares it by the comparator.
+            // 
+            template <typename _Priority, typename _Comparator, bool = PriorityRange<_Priority>::bounded>
+            class Rank
+            {
+                //==============================================================================================================
+                enum class Group
+                {
+                    FRONT,
+                    PRIORITY,
+                    BACK,
+                };
+
+            public:
+                //==============================================================================================================
+                explicit Rank(Order _order) noexcept
+                    : group_(_order == Order::FRONT ? Group::FRONT : Group::BACK)
+                {
+                }
+
+                //==============================================================================================================
+                explicit Rank(_Priority const &_priority)
+                    : group_   (Group::PRIORITY)
+                    , priority_(_priority)
+                {
+                }
+
+                //==============================================================================================================
+                // 
+                // Every priority of an unbounded type has a rank.
+                // 
+                static bool contains(_Priority const &) noexcept
+                {
+                    return true;
+                }
+
+                //==============================================================================================================
+                bool operator<(Rank const &_other) const
+                {
+                    if (group_ != _other.group_)
+                        return group_ < _other.group_;
+
+                    return group_ == Group::PRIORITY && _Comparator()(*priority_, *_other.priority_);
+                }
+
+                //==============================================================================================================
+                bool operator==(Rank const &_other) const
+                {
+                    return !(*this < _other) && !(_other < *this);
+                }
+
+            private:
+                Group                       group_;
+                boost::optional<_Priority>  priority_;
+            };
+
+
+            //==================================================================================================================
+            // 
+            // A rank of a priority type with a declared range is the index of a bucket: the first bucket is for listeners
+            // subscribed to the front, the last one is for listeners subscribed to the back, and each priority of the range
+            // has a bucket between them in the order specified by the comparator. Equivalent priorities share a bucket.
+            // A priority outside the range has no bucket, so constructing its rank throws std::out_of_range.
+            // 
+            template <typename _Priority, typename _Comparator>
+            class Rank<_Priority, _Comparator, true>
+            {
+                typedef PriorityRange<_Priority>  range_t;
+                typedef std::uint16_t             index_t;
+
+                static long long const FIRST = static_cast<long long>(range_t::first);
+                static long long const LAST  = static_cast<long long>(range_t::last);
+
+                static std::size_t const PRIORITIES_COUNT = static_cast<std::size_t>(LAST - FIRST + 1);
+
+                static_assert(PRIORITIES_COUNT <= 1024, "The range of priorities is too wide for buckets.");
+
+                //==============================================================================================================
+                // 
+                // Buckets of the priorities of the range, computed once by the comparator.
+                // 
+                struct Buckets
+                {
+                    Buckets()
+                    {
+                        for (std::size_t i = 0; i != PRIORITIES_COUNT; ++i)
+                        {
+                            indices[i] = 1;
+
+                            for (std::size_t j = 0; j != PRIORITIES_COUNT; ++j)
+                            {
+                                if (_Comparator()(priority(j), priority(i)))
+                                    ++indices[i];
+                            }
+                        }
+                    }
+
+                    static _Priority priority(std::size_t _offset) noexcept
+                    {
+                        return static_cast<_Priority>(FIRST + static_cast<long long>(_offset));
+                    }
+
+                    std::array<index_t, PRIORITIES_COUNT> indices;
+                };
+
+            public:
+                //==============================================================================================================
+                explicit Rank(Order _order) noexcept
+                    : bucket_(static_cast<index_t>(_order == Order::FRONT ? 0 : PRIORITIES_COUNT + 1))
+                {
+                }
+
+                //==============================================================================================================
+                explicit Rank(_Priority const &_priority)
+                    : bucket_(bucket(_priority))
+                {
+                }
+
+                //==============================================================================================================
+                static bool contains(_Priority const &_priority) noexcept
+                {
+                    long long const value = static_cast<long long>(_priority);
+
+                    return value >= FIRST && value <= LAST;
+                }
+
+                //==============================================================================================================
+                bool operator<(Rank const &_other) const noexcept
+                {
+                    return bucket_ < _other.bucket_;
+                }
+
+                //==============================================================================================================
+                bool operator==(Rank const &_other) const noexcept
+                {
+                    return bucket_ == _other.bucket_;
+                }
+
+            private:
+                //==============================================================================================================
+                static index_t bucket(_Priority const &_priority)
+                {
+                    if (!contains(_priority))
+                        throw std::out_of_range("The priority is outside the range declared by PriorityRange.");
+
+                    static Buckets const buckets;
+
+                    return buckets.indices[static_cast<std::size_t>(static_cast<long long>(_priority) - FIRST)];
+                }
+
+            private:
+                index_t bucket_;
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
@@ -0,0 +1,477 @@
+// cws::events::dispatcher::Ring class keeps events posted to a channel until the consumer dispatches them.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+//==============================================================================================================================
+#include "../overflow.hpp"
+#include "../producers.hpp"
+#include "allocator.hpp"
+#include "lane.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Bounded lock-free ring of events of one type, which any thread can post to and one thread consumes.
+            // 
+            // Each cell has a sequence number telling its state for the position of the ring that maps to it:
+            //   - position          the cell is free for the event of the position;
+            //   - position + 1      the event of the position is posted;
+            //   - position          again, while the event is being consumed, dropped or overwritten by the thread that
+            //                       took the cell, which the producers of the position cannot mistake for a free cell,
+            //                       since they have passed it already;
+            //   - position + size   the event is consumed, so the cell is free for the position of the next lap.
+            // 
+            // Producers take positions by advancing the tail, and the consumer advances the head. A thread takes a posted
+            // event by exchanging its sequence number, so the consumer and producers dropping or overwriting events never
+            // take the same event. The head and the tail are kept on different cache lines.
+            // 
+            template <typename _Overflow, typename _Allocator, typename _Event>
+            class Ring
+            {
+                static_assert(alignof(_Event) <= alignof(std::max_align_t), "Over-aligned events cannot be posted.");
+                static_assert(std::is_nothrow_move_constructible<_Event>::value,
+                              "Events posted to a channel must be nothrow move constructible.");
+
+                static std::size_t const CACHE_LINE = 64;
+
+                //==============================================================================================================
+                struct Cell
+                {
+                    std::atomic<std::size_t>                                              sequence;
+                    typename std::aligned_storage<sizeof(_Event), alignof(_Event)>::type  storage;
+
+                    _Event *event() noexcept
+                    {
+                        return reinterpret_cast<_Event *>(&storage);
+                    }
+                };
+
+                typedef Rebind<Cell, _Allocator>            allocator_t;
+                typedef std::allocator_traits<allocator_t>  traits_t;
+
+                //==============================================================================================================
+                // 
+                // Result of posting to a full ring.
+                // 
+                enum class Overflow
+                {
+                    RETRY,
+                    POSTED,
+                    DROPPED,
+                };
+
+                //==============================================================================================================
+                // 
+                // Destroys the event and frees its cell for the next lap when dispatching ends even if a listener throws.
+                // 
+                class Consuming
+                {
+                public:
+                    Consuming(Ring &_ring, Cell &_cell, std::size_t _position) noexcept
+                        : ring_    (_ring)
+                        , cell_    (_cell)
+                        , position_(_position)
+                    {
+                    }
+
+                    ~Consuming()
+                    {
+                        ring_.release(cell_, position_);
+                    }
+
+                private:
+                    Ring         &ring_;
+                    Cell         &cell_;
+                    std::size_t   position_;
+                };
+
+            public:
+                //==============================================================================================================
+                // 
+                // Allocates cells for the capacity rounded up to a power of two, but not less than two.
+                // 
+                Ring(_Allocator const &_allocator, std::size_t _capacity)
+                    : allocator_(_allocator)
+                    , size_     (size(_capacity))
+                    , cells_    (traits_t::allocate(allocator_, size_))
+                    , head_     (0)
+                    , tail_     (0)
+                    , dropped_  (0)
+                {
+                    for (std::size_t i = 0; i != size_; ++i)
+                    {
+                        traits_t::construct(allocator_, cells_ + i);
+
+                        cells_[i].sequence.store(i, std::memory_order_relaxed);
+                    }
+                }
+
+                //==============================================================================================================
+                // 
+                // Destroys the events that are not consumed.
+                // 
+                ~Ring()
+                {
+                    for (std::size_t position = head_.load(); position != tail_.load(); ++position)
+                    {
+                        Cell &cell = cells_[position & (size_ - 1)];
+
+                        if (cell.sequence.load() == position + 1)
+                            cell.event()->~_Event();
+                    }
+
+                    traits_t::deallocate(allocator_, cells_, size_);
+                }
+
+                //==============================================================================================================
+                std::size_t capacity() const noexcept
+                {
+                    return size_;
+                }
+
+                //==============================================================================================================
+                std::uint64_t dropped() const noexcept
+                {
+                    return dropped_.load(std::memory_order_relaxed);
+                }
+
+                //==============================================================================================================
+                // 
+                // Moves the event into the ring. Returns false if the event is dropped by overflow::DropNewest policy.
+                // 
+                bool push(_Event &&_event) noexcept
+                {
+                    for (;;)
+                    {
+                        std::size_t  position = tail_.load(std::memory_order_relaxed);
+                        Cell        &cell     = cells_[position & (size_ - 1)];
+
+                        std::size_t const sequence = cell.sequence.load(std::memory_order_acquire);
+
+                        if (sequence == position)
+                        {
+                            if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                            {
+                                new (cell.event()) _Event(std::move(_event));
+
+                                cell.sequence.store(position + 1, std::memory_order_release);
+
+                                return true;
+                            }
+                        }
+                        else if (static_cast<std::ptrdiff_t>(sequence - position) < 0)
+                        {
+                            Overflow const overflow = full(position, _event, _Overflow());
+
+                            if (overflow != Overflow::RETRY)
+                                return overflow == Overflow::POSTED;
+                        }
+                    }
+                }
+
+                //==============================================================================================================
+                // 
+                // Dispatches events posted before the call in their order, but not more than the count. Stops earlier at an
+                // event that is not posted completely yet or is being dropped or overwritten. Returns the number of
+                // dispatched events.
+                // 
+                template <typename _Dispatcher>
+                std::size_t pop(_Dispatcher &_dispatcher, std::size_t _count)
+                {
+                    std::size_t const last = tail_.load(std::memory_order_acquire);
+
+                    std::size_t count = 0;
+
+                    while (count != _count && static_cast<std::ptrdiff_t>(head_.load(std::memory_order_relaxed) - last) < 0)
+                    {
+                        std::size_t const position = head_.load(std::memory_order_relaxed);
+
+                        Cell *cell = take(position);
+
+                        if (cell == nullptr)
+                            break;
+
+                        Consuming consuming(*this, *cell, position);
+
+                        ++count;
+
+                        _dispatcher.dispatch(*static_cast<_Event const *>(cell->event()));
+                    }
+
+                    return count;
+                }
+
+            private:
+                //==============================================================================================================
+                static std::size_t size(std::size_t _capacity) noexcept
+                {
+                    std::size_t size = 2;
+
+                    while (size < _capacity)
+                        size *= 2;
+
+                    return size;
+                }
+
+                //==============================================================================================================
+                // 
+                // Takes the event of the position if it is the oldest one, or returns nullptr if it is not, is not posted
+                // completely, or is taken by another thread. The head cannot pass an event that is not taken, so the event
+                // is the oldest one if the head is at its position when it is taken.
+                // 
+                Cell *take(std::size_t _position) noexcept
+                {
+                    Cell &cell = cells_[_position & (size_ - 1)];
+
+                    std::size_t sequence = _position + 1;
+
+                    if (head_.load(std::memory_order_acquire) != _position ||
+                        !cell.sequence.compare_exchange_strong(sequence, _position, std::memory_order_acquire))
+                        return nullptr;
+
+                    head_.store(_position + 1, std::memory_order_release);
+
+                    return &cell;
+                }
+
+                //==============================================================================================================
+                // 
+                // Destroys the taken event and frees its cell for the next lap.
+                // 
+                void release(Cell &_cell, std::size_t _position) noexcept
+                {
+                    _cell.event()->~_Event();
+                    _cell.sequence.store(_position + size_, std::memory_order_release);
+                }
+
+                //==============================================================================================================
+                Overflow full(std::size_t, _Event &, overflow::Block) noexcept
+                {
+                    std::this_thread::yield();
+
+                    return Overflow::RETRY;
+                }
+
+                //==============================================================================================================
+                Overflow full(std::size_t, _Event &, overflow::DropNewest) noexcept
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+
+                    return Overflow::DROPPED;
+                }
+
+                //==============================================================================================================
+                // 
+                // Drops the oldest event, which occupies the cell of the tail. The producer yields while another thread
+                // holds it, which may be preempted, rather than drop the events after it.
+                // 
+                Overflow full(std::size_t _tail, _Event &, overflow::DropOldest) noexcept
+                {
+                    std::size_t const position = _tail - size_;
+
+                    if (Cell *cell = take(position))
+                    {
+                        release(*cell, position);
+
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    return Overflow::RETRY;
+                }
+
+                //==============================================================================================================
+                // 
+                // Overwrites the event just before the tail, unless the tail has moved, or the event is being taken. The
+                // producer yields while another thread holds the event, which may be preempted.
+                // 
+                Overflow full(std::size_t _tail, _Event &_event, overflow::Overwrite) noexcept
+                {
+                    std::size_t const  position = _tail - 1;
+                    Cell              &cell     = cells_[position & (size_ - 1)];
+
+                    std::size_t sequence = position + 1;
+
+                    if (!cell.sequence.compare_exchange_strong(sequence, position, std::memory_order_acquire))
+                    {
+                        std::this_thread::yield();
+
+                        return Overflow::RETRY;
+                    }
+
+                    if (tail_.load(std::memory_order_acquire) != _tail)
+                    {
+                        cell.sequence.store(position + 1, std::memory_order_release);
+
+                        return Overflow::RETRY;
+                    }
+
+                    cell.event()->~_Event();
+                    new (cell.event()) _Event(std::move(_event));
+
+                    cell.sequence.store(position + 1, std::memory_order_release);
+
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+
+                    return Overflow::POSTED;
+                }
+
+            private:
+                Ring           (Ring const &) = delete;
+                Ring &operator=(Ring const &) = delete;
+
+            private:
+                allocator_t                 allocator_;
+                std::size_t                 size_;
+                Cell                       *cells_;
+                char                        padding_[CACHE_LINE];     // Keeps the head off the cache line of the cells.
+                std::atomic<std::size_t>    head_;                    // Advanced by the threads taking events.
+                char                        headPadding_[CACHE_LINE]; // Keeps the tail off the cache line of the head.
+                std::atomic<std::size_t>    tail_;                    // Advanced by the producers.
+                std::atomic<std::uint64_t>  dropped_;
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Selects the ring of events of one type for the producers policy of a channel.
+            // 
+            template <typename _Producers, typename _Overflow, typename _Allocator, typename _Event>
+            struct RingType;
+
+            template <typename _Overflow, typename _Allocator, typename _Event>
+            struct RingType<producers::Multiple, _Overflow, _Allocator, _Event>
+            {
+                typedef Ring<_Overflow, _Allocator, _Event>  type;
+            };
+
+            template <typename _Overflow, typename _Allocator, typename _Event>
+            struct RingType<producers::Single, _Overflow, _Allocator, _Event>
+            {
+                typedef Lane<_Overflow, _Allocator, _Event>  type;
+            };
+
+
+            //==================================================================================================================
+            template <typename _Producers, typename _Overflow, typename _Allocator, typename ..._Events>
+            class Rings;
+
+
+            //==================================================================================================================
+            // 
+            // Empty tail of the rings of a channel.
+            // 
+            template <typename _Producers, typename _Overflow, typename _Allocator>
+            class Rings<_Producers, _Overflow, _Allocator>
+            {
+            protected:
+                //==============================================================================================================
+                Rings(_Allocator const &, std::size_t) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                template <typename _Dispatcher>
+                std::size_t pop(_Dispatcher &, std::size_t) noexcept
+                {
+                    return 0;
+                }
+
+                //==============================================================================================================
+                std::uint64_t dropped() const noexcept
+                {
+                    return 0;
+                }
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Rings of a channel, one for each event type, inherited from the ring of the first event type and the rings of
+            // the rest of event types.
+            // 
+            template <typename _Producers, typename _Overflow, typename _Allocator, typename _This, typename ..._Rest>
+            class Rings<_Producers, _Overflow, _Allocator, _This, _Rest...> :
+                public RingType<_Producers, _Overflow, _Allocator, _This>::type,
+                public Rings   <_Producers, _Overflow, _Allocator, _Rest...>
+            {
+                typedef typename RingType<_Producers, _Overflow, _Allocator, _This>::type  ring_t;
+                typedef Rings<_Producers, _Overflow, _Allocator, _Rest...>                 rings_t;
+
+            protected:
+                //==============================================================================================================
+                Rings(_Allocator const &_allocator, std::size_t _capacity)
+                    : ring_t (_allocator, _capacity)
+                    , rings_t(_allocator, _capacity)
+                {
+                }
+
+                //==============================================================================================================
+                // 
+                // Dispatches events of the current ring and then of the rest of rings, but not more than the count.
+                // 
+                template <typename _Dispatcher>
+                std::size_t pop(_Dispatcher &_dispatcher, std::size_t _count)
+                {
+                    std::size_t const count = ring_t::pop(_dispatcher, _count);
+
+                    return count + rings_t::pop(_dispatcher, _count - count);
+                }
+
+                //==============================================================================================================
+                std::size_t capacity() const noexcept
+                {
+                    return ring_t::capacity();
+                }
+
+                //==============================================================================================================
+                std::uint64_t dropped() const noexcept
+                {
+                    return ring_t::dropped() + rings_t::dropped();
+                }
+            };
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
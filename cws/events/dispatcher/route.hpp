@@ -0,0 +1,406 @@
+// cws::events::dispatcher::Routes class finds listeners of a routed event subscribed to the key of a dispatched event.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+#pragma once
+
+
+//==============================================================================================================================
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+//==============================================================================================================================
+#include <boost/optional.hpp>
+
+
+//==============================================================================================================================
+#include "../details.hpp"
+#include "allocator.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Listeners of an event that is not routed are not indexed, and all of them have the same empty key.
+            // 
+            template <typename _Allocator, typename _Event, bool = Routing<_Event>::routed>
+            class Routes
+            {
+            public:
+                //==============================================================================================================
+                struct key_t
+                {
+                    bool operator==(key_t const &) const noexcept
+                    {
+                        return true;
+                    }
+                };
+
+                //==============================================================================================================
+                explicit Routes(_Allocator const &) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                template <typename _Slots>
+                void inserted(_Slots const &, std::size_t) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                template <typename _Slots>
+                void removing(_Slots const &, std::size_t) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                template <typename _Slots, typename _Live>
+                void rebuild(_Slots const &, _Live const &) noexcept
+                {
+                }
+
+                //==============================================================================================================
+                template <typename _Slots, typename _Live>
+                void assign(Routes const &, _Slots const &, _Live const &) noexcept
+                {
+                }
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Positions of the slots of listeners subscribed without a key, and positions of the slots of listeners
+            // subscribed to a key sorted by the hash of the key. Both are kept in the order of the slots, so that merging
+            // the positions of the unkeyed listeners with the positions of a hash visits the matching listeners in their
+            // invocation order. The slots of different keys with the same hash are skipped by comparing their keys.
+            // 
+            // The positions are flat arrays rather than a hash table, since arrays of backend::Snapshot are copied by every
+            // modification. If the routes fail to be updated for lack of memory, they are invalidated, and the event is
+            // dispatched by testing the key of every slot until the routes are rebuilt by a compaction or a copy of the array.
+            // 
+            template <typename _Allocator, typename _Event>
+            class Routes<_Allocator, _Event, true>
+            {
+                typedef typename Routing<_Event>::key_type  key_type;
+                typedef std::uint32_t                       index_t;
+
+                //==============================================================================================================
+                struct Route
+                {
+                    std::size_t hash;
+                    index_t     position;
+                };
+
+                typedef std::vector<Route,   Rebind<Route,   _Allocator>>  keyed_t;
+                typedef std::vector<index_t, Rebind<index_t, _Allocator>>  unkeyed_t;
+
+            public:
+                //==============================================================================================================
+                // 
+                // The key of a listener subscribed without a topic is empty.
+                // 
+                typedef boost::optional<key_type>  key_t;
+
+                //==============================================================================================================
+                explicit Routes(_Allocator const &_allocator) noexcept
+                    : keyed_  (typename keyed_t::allocator_type(_allocator))
+                    , unkeyed_(typename unkeyed_t::allocator_type(_allocator))
+                    , valid_  (true)
+                {
+                }
+
+                //==============================================================================================================
+                // 
+                // Shifts positions following the slot inserted at the position, and adds the position of the slot.
+                // 
+                template <typename _Slots>
+                void inserted(_Slots const &_slots, std::size_t _position) noexcept
+                {
+                    if (!valid_)
+                        return;
+
+                    key_t const &key = _slots[_position].key;
+
+                    try
+                    {
+                        if (key)
+                            grow(keyed_);
+                        else
+                            grow(unkeyed_);
+                    }
+                    catch (...)
+                    {
+                        invalidate();
+                        return;
+                    }
+
+                    index_t const position = static_cast<index_t>(_position);
+
+                    for (Route &route : keyed_)
+                    {
+                        if (route.position >= position)
+                            ++route.position;
+                    }
+
+                    for (index_t &unkeyed : unkeyed_)
+                    {
+                        if (unkeyed >= position)
+                            ++unkeyed;
+                    }
+
+                    if (key)
+                    {
+                        Route const route{ hash(*key), position };
+
+                        keyed_.insert(std::lower_bound(keyed_.begin(), keyed_.end(), route, &Routes::precedes), route);
+                    }
+                    else
+                        unkeyed_.insert(std::lower_bound(unkeyed_.begin(), unkeyed_.end(), position), position);
+                }
+
+                //==============================================================================================================
+                // 
+                // Removes the position of the slot that is being marked removed. Positions of other slots do not change.
+                // 
+                template <typename _Slots>
+                void removing(_Slots const &_slots, std::size_t _position) noexcept
+                {
+                    if (!valid_)
+                        return;
+
+                    key_t const   &key      = _slots[_position].key;
+                    index_t const  position = static_cast<index_t>(_position);
+
+                    if (key)
+                        keyed_.erase(std::lower_bound(keyed_.begin(), keyed_.end(), Route{ hash(*key), position },
+                                                      &Routes::precedes));
+                    else
+                        unkeyed_.erase(std::lower_bound(unkeyed_.begin(), unkeyed_.end(), position));
+                }
+
+                //==============================================================================================================
+                // 
+                // Indexes the slots satisfying the predicate anew.
+                // 
+                template <typename _Slots, typename _Live>
+                void rebuild(_Slots const &_slots, _Live const &_live) noexcept
+                {
+                    keyed_.clear();
+                    unkeyed_.clear();
+
+                    try
+                    {
+                        for (std::size_t position = 0; position != _slots.size(); ++position)
+                        {
+                            if (!_live(_slots[position]))
+                                continue;
+
+                            if (key_t const &key = _slots[position].key)
+                                keyed_.push_back(Route{ hash(*key), static_cast<index_t>(position) });
+                            else
+                                unkeyed_.push_back(static_cast<index_t>(position));
+                        }
+                    }
+                    catch (...)
+                    {
+                        invalidate();
+                        return;
+                    }
+
+                    std::stable_sort(keyed_.begin(), keyed_.end(),
+                                     [](Route const &_left, Route const &_right) { return _left.hash < _right.hash; });
+
+                    valid_ = true;
+                }
+
+                //==============================================================================================================
+                // 
+                // Copies the routes of slots that keep their positions in the copy, or rebuilds invalid ones.
+                // 
+                template <typename _Slots, typename _Live>
+                void assign(Routes const &_source, _Slots const &_slots, _Live const &_live) noexcept
+                {
+                    if (!_source.valid_)
+                        return rebuild(_slots, _live);
+
+                    try
+                    {
+                        keyed_   = _source.keyed_;
+                        unkeyed_ = _source.unkeyed_;
+                    }
+                    catch (...)
+                    {
+                        invalidate();
+                    }
+                }
+
+                //==============================================================================================================
+                // 
+                // Invokes the visitor for each slot of a listener subscribed without a key or to the key of the event in the
+                // order of the slots.
+                // 
+                template <typename _Slots, typename _Visitor>
+                void visit(_Slots &_slots, _Event const &_event, _Visitor &&_visitor) const
+                {
+                    auto &&key = Routing<_Event>::key(_event);
+
+                    if (!valid_)
+                    {
+                        for (auto &slot : _slots)
+                        {
+                            if (!slot.key || *slot.key == key)
+                                _visitor(slot);
+                        }
+
+                        return;
+                    }
+
+                    auto const range = std::equal_range(keyed_.begin(), keyed_.end(), Route{ hash(key), 0 },
+                                                        [](Route const &_left, Route const &_right)
+                                                        {
+                                                            return _left.hash < _right.hash;
+                                                        });
+
+                    auto keyed   = range.first;
+                    auto unkeyed = unkeyed_.begin();
+
+                    while (keyed != range.second || unkeyed != unkeyed_.end())
+                    {
+                        if (keyed == range.second || (unkeyed != unkeyed_.end() && *unkeyed < keyed->position))
+                        {
+                            _visitor(_slots[*unkeyed++]);
+                        }
+                        else
+                        {
+                            auto &slot = _slots[(keyed++)->position];
+
+                            if (*slot.key == key)
+                                _visitor(slot);
+                        }
+                    }
+                }
+
+            private:
+                //==============================================================================================================
+                template <typename _Key>
+                static std::size_t hash(_Key const &_key)
+                {
+                    return std::hash<key_type>()(_key);
+                }
+
+                //==============================================================================================================
+                // 
+                // Makes room for one more position, so that inserting it does not throw.
+                // 
+                template <typename _Vector>
+                static void grow(_Vector &_vector)
+                {
+                    if (_vector.size() == _vector.capacity())
+                        _vector.reserve(_vector.size() < 8 ? 8 : _vector.size() * 2);
+                }
+
+                //==============================================================================================================
+                static bool precedes(Route const &_left, Route const &_right) noexcept
+                {
+                    return _left.hash < _right.hash || (_left.hash == _right.hash && _left.position < _right.position);
+                }
+
+                //==============================================================================================================
+                void invalidate() noexcept
+                {
+                    keyed_.clear();
+                    unkeyed_.clear();
+
+                    valid_ = false;
+                }
+
+            private:
+                keyed_t    keyed_;
+                unkeyed_t  unkeyed_;
+                bool       valid_;
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Function object invoking the listener only for events with the key, which subscribes a listener to a topic
+            // of a backend that does not index listeners by keys.
+            // 
+            template <typename _Event, typename _Callable>
+            class Keyed
+            {
+                typedef typename Routing<_Event>::key_type  key_type;
+
+            public:
+                //==============================================================================================================
+                template <typename _Function>
+                Keyed(key_type const &_key, _Function &&_function)
+                    : key_     (_key)
+                    , callable_(std::forward<_Function>(_function))
+                {
+                }
+
+                //==============================================================================================================
+                void operator()(_Event const &_event)
+                {
+                    if (Routing<_Event>::key(_event) == key_)
+                        callable_(_event);
+                }
+
+                //==============================================================================================================
+                template <typename _Other>
+                bool operator==(Keyed<_Event, _Other> const &_other) const
+                {
+                    return key_ == _other.key_ && callable_ == _other.callable_;
+                }
+
+            private:
+                template <typename, typename>
+                friend class Keyed;
+
+            private:
+                key_type   key_;
+                _Callable  callable_;
+            };
+
+
+            //==================================================================================================================
+            template <typename _Event, typename _Key, typename _Callable>
+            inline Keyed<_Event, typename std::decay<_Callable>::type> make_keyed(_Key const &_key, _Callable &&_callable)
+            {
+                return Keyed<_Event, typename std::decay<_Callable>::type>(typename Routing<_Event>::key_type(_key),
+                                                                          std::forward<_Callable>(_callable));
+            }
+
+        }  // namespace dispatcher
+
+    }  // namespace events
+
+}  // namespace cws
@@ -12,8 +12,13 @@
 #pragma once
 
 
+//==============================================================================================================================
+#include <cstddef>
+
+
 //==============================================================================================================================
 #include "head.hpp"
+#include "head/flat.hpp"
 
 
 //==============================================================================================================================
@@ -32,7 +37,8 @@ namespace cws
 
 
             //==================================================================================================================
-            template <typename ..._Types>
+            template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend,
+                      std::size_t _StorageSize, typename _Allocator, typename ..._Events>
             class Tail;
 
 
@@ -40,12 +46,15 @@ namespace cws
             // 
             // Empty tail in cws::events::Dispatcher's scattered hierarchy.
             // 
-            template <typename _Mutex, typename _Priority, typename _Comparator>
-            class Tail<_Mutex, _Priority, _Comparator>
+            template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend,
+                      std::size_t _StorageSize, typename _Allocator>
+            class Tail<_Mutex, _Priority, _Comparator, _Backend, _StorageSize, _Allocator>
             {
             protected:
                 //==============================================================================================================
-                Tail() = default;
+                explicit Tail(_Allocator const &) noexcept
+                {
+                }
 
                 //==============================================================================================================
                 Tail(Tail &&_source) noexcept
@@ -74,17 +83,22 @@ namespace cws
             // Vertex in cws::events::Dispatcher's scattered hierarchy. Inherited from cws::events::dispatcher::Head class for
             // the first provided event type and next vertex for the rest of events types.
             // 
-            template <typename _Mutex, typename _Priority, typename _Comparator, typename _This, typename ..._Rest>
-            class Tail<_Mutex, _Priority, _Comparator, _This, _Rest...> :
-                public Head<_Mutex, _Priority, _Comparator, _This>,
-                public Tail<_Mutex, _Priority, _Comparator, _Rest...>
+            template <typename _Mutex, typename _Priority, typename _Comparator, typename _Backend,
+                      std::size_t _StorageSize, typename _Allocator, typename _This, typename ..._Rest>
+            class Tail<_Mutex, _Priority, _Comparator, _Backend, _StorageSize, _Allocator, _This, _Rest...> :
+                public Head<_Mutex, _Priority, _Comparator, _Backend, _StorageSize, _Allocator, _This>,
+                public Tail<_Mutex, _Priority, _Comparator, _Backend, _StorageSize, _Allocator, _Rest...>
             {
-                typedef Head<_Mutex, _Priority, _Comparator, _This>     head_t;
-                typedef Tail<_Mutex, _Priority, _Comparator, _Rest...>  tail_t;
+                typedef Head<_Mutex, _Priority, _Comparator, _Backend, _StorageSize, _Allocator, _This>     head_t;
+                typedef Tail<_Mutex, _Priority, _Comparator, _Backend, _StorageSize, _Allocator, _Rest...>  tail_t;
 
             protected:
                 //==============================================================================================================
-                Tail() = default;
+                explicit Tail(_Allocator const &_allocator) noexcept
+                    : head_t(_allocator)
+                    , tail_t(_allocator)
+                {
+                }
 
                 //==============================================================================================================
                 Tail(Tail &&_source) noexcept
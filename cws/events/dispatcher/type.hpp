@@ -35,10 +35,12 @@ namespace cws
             //! 
             //! @brief Specifies custom Dispatcher type.
             //! 
-            //! A convenient way to declare Dispatcher of custom type with specified mutex type and/or priority type and events
+            //! A convenient way to declare Dispatcher of custom type with specified mutex type and/or priority type and/or
+            //! backend type and/or executor type and/or storage type and/or allocator type and/or statistics type and events
             //! list.
             //! 
-            //! @tparam ..._Types Can contain MutexType and/or PriorityType. Must contain TypesList.
+            //! @tparam ..._Types Can contain MutexType and/or PriorityType and/or BackendType and/or ExecutorType and/or
+            //! StorageType and/or AllocatorType and/or StatsType. Must contain TypesList.
             //! 
             //! @remark Template parameters order makes no sense.
             //! 
@@ -58,7 +60,10 @@ namespace cws
             struct Type:
                 private type::Base<_Types...>
             {
-                typedef Dispatcher<typename Type::mutex_t, typename Type::priority_t, typename Type::list_t>  type;  //!< Uses to instantiate Dispatcher<_Types...>
+                //! Uses to instantiate Dispatcher<_Types...>
+                typedef Dispatcher<typename Type::mutex_t, typename Type::priority_t, typename Type::backend_t,
+                                   typename Type::executor_t, typename Type::storage_t, typename Type::allocator_t,
+                                   typename Type::stats_t, typename Type::list_t>  type;
             };
 
         }  // namespace dispatcher
@@ -43,14 +43,20 @@ namespace cws
 
                 //==============================================================================================================
                 // 
-                // Last empty tail class with default empty mutex and priority parameters.
+                // Last empty tail class with default empty mutex, priority, backend, executor, storage, and allocator
+                // parameters.
                 // 
                 template <>
                 struct Base<>
                 {
                 protected:
-                    typedef MutexType<>     mutex_t;
-                    typedef PriorityType<>  priority_t;
+                    typedef MutexType<>      mutex_t;
+                    typedef PriorityType<>   priority_t;
+                    typedef BackendType<>    backend_t;
+                    typedef ExecutorType<>   executor_t;
+                    typedef StorageType<>    storage_t;
+                    typedef AllocatorType<>  allocator_t;
+                    typedef StatsType<>      stats_t;
                 };
 
 
@@ -80,6 +86,71 @@ namespace cws
                 };
 
 
+                //==============================================================================================================
+                // 
+                // Extracts backend type from all cws::events::Dispatcher's template parameters.
+                // 
+                template <typename _Backend, typename ..._Rest>
+                struct Base<BackendType<_Backend>, _Rest...> :
+                    protected Base<_Rest...>
+                {
+                protected:
+                    typedef BackendType<_Backend>  backend_t;
+                };
+
+
+                //==============================================================================================================
+                // 
+                // Extracts executor type from all cws::events::Dispatcher's template parameters.
+                // 
+                template <typename _Executor, typename ..._Rest>
+                struct Base<ExecutorType<_Executor>, _Rest...> :
+                    protected Base<_Rest...>
+                {
+                protected:
+                    typedef ExecutorType<_Executor>  executor_t;
+                };
+
+
+                //==============================================================================================================
+                // 
+                // Extracts storage type from all cws::events::Dispatcher's template parameters.
+                // 
+                template <std::size_t _Size, typename ..._Rest>
+                struct Base<StorageType<_Size>, _Rest...> :
+                    protected Base<_Rest...>
+                {
+                protected:
+                    typedef StorageType<_Size>  storage_t;
+                };
+
+
+                //==============================================================================================================
+                // 
+                // Extracts allocator type from all cws::events::Dispatcher's template parameters.
+                // 
+                template <typename _Allocator, typename ..._Rest>
+                struct Base<AllocatorType<_Allocator>, _Rest...> :
+                    protected Base<_Rest...>
+                {
+                protected:
+                    typedef AllocatorType<_Allocator>  allocator_t;
+                };
+
+
+                //==============================================================================================================
+                // 
+                // Extracts stats type from all cws::events::Dispatcher's template parameters.
+                // 
+                template <typename _Stats, typename ..._Rest>
+                struct Base<StatsType<_Stats>, _Rest...> :
+                    protected Base<_Rest...>
+                {
+                protected:
+                    typedef StatsType<_Stats>  stats_t;
+                };
+
+
                 //==============================================================================================================
                 // 
                 // Extracts events list from all cws::events::Dispatcher's template parameters.
@@ -0,0 +1,321 @@
+// cws::events::executor namespace contains executors that can run listeners of asynchronously dispatched events.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+//! 
+//! @file
+//! 
+#pragma once
+
+
+//==============================================================================================================================
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Executors that can be used to run listeners of asynchronously dispatched events.
+        //! 
+        //! An executor is any default-constructible, movable, and swappable type with a public method execute(_Task &&)
+        //! accepting a move-only function object without parameters. The executor must eventually invoke the function
+        //! object exactly once.
+        //! 
+        namespace executor
+        {
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Runs a task in the thread that submits it.
+            //! 
+            //! Asynchronous dispatching is completed when dispatch_async function returns. This is the default executor.
+            //! 
+            struct Inline
+            {
+                //==============================================================================================================
+                //! @brief Invokes the task.
+                template <typename _Task>
+                void execute(_Task &&_task) const
+                {
+                    _task();
+                }
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Type-erased move-only task that an executor can store until it runs the task.
+            //! 
+            class Task
+            {
+                struct Callable
+                {
+                    virtual ~Callable() = default;
+
+                    virtual void operator()() = 0;
+                };
+
+                template <typename _Function>
+                struct Function :
+                    Callable
+                {
+                    explicit Function(_Function &&_function)
+                        : function(std::move(_function))
+                    {
+                    }
+
+                    void operator()() override
+                    {
+                        function();
+                    }
+
+                    _Function function;
+                };
+
+            public:
+                //==============================================================================================================
+                //! @brief Instantiates empty task.
+                Task() = default;
+
+                //==============================================================================================================
+                //! @brief Instantiates task invoking the function object without parameters.
+                template <typename _Function>
+                explicit Task(_Function &&_function)
+                    : callable_(new Function<typename std::decay<_Function>::type>(std::forward<_Function>(_function)))
+                {
+                }
+
+                //==============================================================================================================
+                //! @brief Invokes the function object.
+                void operator()()
+                {
+                    (*callable_)();
+                }
+
+            private:
+                std::unique_ptr<Callable> callable_;
+            };
+
+
+            //==================================================================================================================
+            namespace details
+            {
+
+
+                //==============================================================================================================
+                // 
+                // Work-stealing threads. Each thread has its own deque of tasks. A thread runs tasks from the back of its
+                // deque, and when it is empty, steals tasks from the front of the other threads' deques. Tasks submitted by
+                // a worker thread are pushed to its own deque, others are distributed among the threads in turn.
+                // 
+                class Workers
+                {
+                    //==========================================================================================================
+                    struct Worker
+                    {
+                        std::mutex        mutex;
+                        std::deque<Task>  tasks;
+                    };
+
+                public:
+                    //==========================================================================================================
+                    explicit Workers(std::size_t _threadsCount)
+                        : workers_ (_threadsCount)
+                        , queued_  (0)
+                        , next_    (0)
+                        , stopping_(false)
+                    {
+                        for (std::size_t i = 0; i != workers_.size(); ++i)
+                            threads_.emplace_back([this, i]() { run(i); });
+                    }
+
+                    //==========================================================================================================
+                    // 
+                    // Runs the queued tasks and stops the threads.
+                    // 
+                    ~Workers()
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(sleepMutex_);
+
+                            stopping_ = true;
+                        }
+
+                        sleepCondition_.notify_all();
+
+                        for (std::thread &thread : threads_)
+                            thread.join();
+                    }
+
+                    //==========================================================================================================
+                    // 
+                    // Threads shared by all executor::Pool objects, created when the first task is submitted.
+                    // 
+                    static Workers &instance()
+                    {
+                        static Workers workers(std::max(std::thread::hardware_concurrency(), 2u));
+
+                        return workers;
+                    }
+
+                    //==========================================================================================================
+                    void push(Task &&_task)
+                    {
+                        std::size_t const index = current() < workers_.size() ?
+                                                  current() : next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+                        {
+                            std::lock_guard<std::mutex> lock(workers_[index].mutex);
+
+                            workers_[index].tasks.push_back(std::move(_task));
+
+                            queued_.fetch_add(1, std::memory_order_seq_cst);
+                        }
+
+                        {
+                            std::lock_guard<std::mutex> lock(sleepMutex_);
+                        }
+
+                        sleepCondition_.notify_one();
+                    }
+
+                private:
+                    //==========================================================================================================
+                    // 
+                    // Index of the worker running the current thread, or SIZE_MAX if it is not a worker thread.
+                    // 
+                    static std::size_t &current() noexcept
+                    {
+                        static thread_local std::size_t index = static_cast<std::size_t>(-1);
+
+                        return index;
+                    }
+
+                    //==========================================================================================================
+                    void run(std::size_t _index)
+                    {
+                        current() = _index;
+
+                        for (;;)
+                        {
+                            Task task;
+
+                            if (pop(_index, task))
+                            {
+                                task();
+                                continue;
+                            }
+
+                            std::unique_lock<std::mutex> lock(sleepMutex_);
+
+                            sleepCondition_.wait(lock, [this]() { return stopping_ || queued_.load() != 0; });
+
+                            if (stopping_ && queued_.load() == 0)
+                                return;
+                        }
+                    }
+
+                    //==========================================================================================================
+                    // 
+                    // Takes a task from the back of the worker's own deque or from the front of another one.
+                    // 
+                    bool pop(std::size_t _index, Task &_task)
+                    {
+                        for (std::size_t i = 0; i != workers_.size(); ++i)
+                        {
+                            Worker &worker = workers_[(_index + i) % workers_.size()];
+
+                            std::lock_guard<std::mutex> lock(worker.mutex);
+
+                            if (worker.tasks.empty())
+                                continue;
+
+                            if (i == 0)
+                            {
+                                _task = std::move(worker.tasks.back());
+                                worker.tasks.pop_back();
+                            }
+                            else
+                            {
+                                _task = std::move(worker.tasks.front());
+                                worker.tasks.pop_front();
+                            }
+
+                            queued_.fetch_sub(1, std::memory_order_seq_cst);
+
+                            return true;
+                        }
+
+                        return false;
+                    }
+
+                private:
+                    Workers           (Workers const &) = delete;
+                    Workers &operator=(Workers const &) = delete;
+
+                private:
+                    std::vector<Worker>       workers_;
+                    std::vector<std::thread>  threads_;
+                    std::atomic<std::size_t>  queued_;
+                    std::atomic<std::size_t>  next_;
+                    std::mutex                sleepMutex_;
+                    std::condition_variable   sleepCondition_;
+                    bool                      stopping_;     // Guarded by sleepMutex_.
+                };
+
+            }  // namespace details
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Runs tasks by a work-stealing pool of threads.
+            //! 
+            //! All Pool objects share the same threads. Their number is the number of hardware threads, but not less than
+            //! two. The threads are created when the first task is submitted and are stopped at program exit after running
+            //! the submitted tasks.
+            //! 
+            //! @remark Tasks are not guaranteed to run in the order they were submitted.
+            //! 
+            struct Pool
+            {
+                //==============================================================================================================
+                //! @brief Submits the task to the pool.
+                template <typename _Task>
+                void execute(_Task &&_task) const
+                {
+                    details::Workers::instance().push(Task(std::forward<_Task>(_task)));
+                }
+            };
+
+        }  // namespace executor
+
+    }  // namespace events
+
+}  // namespace cws
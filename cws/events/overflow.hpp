@@ -0,0 +1,84 @@
+// cws::events::overflow namespace contains policies of Channel class for events posted to a full channel.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+//! 
+//! @file
+//! 
+#pragma once
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Policies of Channel class for events posted when the channel has no room for them.
+        //! 
+        //! Events dropped by DropNewest, DropOldest, and Overwrite policies are counted by the channel.
+        //! 
+        namespace overflow
+        {
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief The producer waits until the consumer makes room for the event. This is the default.
+            //! 
+            //! The waiting producer yields its time slice between attempts, so that the consumer can run on the same core.
+            //! 
+            struct Block
+            {
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief The posted event is dropped, and try_post function returns false.
+            //! 
+            struct DropNewest
+            {
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief The oldest event of the channel is dropped to make room for the posted event.
+            //! 
+            //! The consumer receives the latest events posted to a full channel.
+            //! 
+            struct DropOldest
+            {
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief The posted event overwrites the most recently posted event that the consumer has not taken yet.
+            //! 
+            //! The consumer receives the oldest events posted to a full channel and the latest one, which suits events
+            //! carrying the current state of something.
+            //! 
+            struct Overwrite
+            {
+            };
+
+        }  // namespace overflow
+
+    }  // namespace events
+
+}  // namespace cws
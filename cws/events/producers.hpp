@@ -0,0 +1,66 @@
+// cws::events::producers namespace contains policies of Channel class for the number of threads posting to a channel.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+//! 
+//! @file
+//! 
+#pragma once
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Policies of Channel class for the number of threads posting events to the channel.
+        //! 
+        namespace producers
+        {
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Any number of threads post events to the channel. This is the default.
+            //! 
+            //! Producers take positions of the ring by compare-and-swap, and all overflow policies are supported.
+            //! 
+            struct Multiple
+            {
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Only one thread at a time posts events to the channel.
+            //! 
+            //! Posting and draining take no compare-and-swap: the producer and the consumer each own their index of the ring
+            //! and keep a cached copy of the other one, which they reload only when the ring looks full or empty. Posting is
+            //! wait-free with overflow::DropNewest policy.
+            //! 
+            //! @remark Only overflow::Block and overflow::DropNewest policies are supported, since the producer never
+            //! touches events posted before.
+            //! 
+            struct Single
+            {
+            };
+
+        }  // namespace producers
+
+    }  // namespace events
+
+}  // namespace cws
@@ -0,0 +1,318 @@
+// cws::events::ScopedListener class unsubscribes listeners subscribed through it when it is destroyed.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+//! 
+//! @file
+//! 
+#pragma once
+
+
+//==============================================================================================================================
+#include <exception>
+#include <utility>
+#include <vector>
+
+
+//==============================================================================================================================
+#include "details.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Owns listeners subscribed through it and unsubscribes them when it is destroyed.
+        //! 
+        //! ScopedListener class subscribes listeners to events of a dispatcher by their connections and keeps the connections.
+        //! Its owner controls the lifetime of subscriptions deterministically instead of tracking objects by shared pointers,
+        //! which costs nothing while events are dispatching.
+        //! 
+        //! @tparam _Dispatcher A type of Dispatcher class or a class derived from it.
+        //! 
+        //! @remark ScopedListener class is non-copyable, moveable.
+        //! 
+        //! @remark The dispatcher must outlive ScopedListener object, and must not be moved or swapped while it has listeners
+        //! subscribed through ScopedListener object.
+        //! 
+        //! @remark ScopedListener class is non-thread-safe. Listeners are subscribed and unsubscribed by the dispatcher's
+        //! functions, so ScopedListener objects of different threads can share a thread-safe dispatcher.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_scoped_listener.cpp
+        //! 
+        //! @par Output
+        //! @include example_scoped_listener.txt
+        //! 
+        template <typename _Dispatcher>
+        class ScopedListener
+        {
+        public:
+            //==================================================================================================================
+            typedef _Dispatcher                                dispatcher_t;  //!< Dispatcher type.
+            typedef typename _Dispatcher::priority_t           priority_t;    //!< Dispatcher's priority type.
+            typedef typename _Dispatcher::connection_t         connection_t;  //!< Dispatcher's connection type.
+
+        private:
+            //==================================================================================================================
+            // 
+            // Connection of a listener together with the function unsubscribing it from its event.
+            // 
+            struct Subscription
+            {
+                void        (*disconnect)(_Dispatcher &, connection_t const &);
+                connection_t  connection;
+            };
+
+        public:
+            //==================================================================================================================
+            //! 
+            //! @brief Constructor.
+            //! 
+            //! Instantiates object of ScopedListener class that subscribes listeners to events of the specified dispatcher.
+            //! 
+            //! @param[in] _dispatcher Reference to the dispatcher.
+            //! 
+            //! @par Complexity
+            //! Constant.
+            //! 
+            //! @par Exception safety
+            //! Will not throw.
+            //! 
+            explicit ScopedListener(_Dispatcher &_dispatcher) noexcept
+                : dispatcher_(&_dispatcher)
+            {
+            }
+
+            //==================================================================================================================
+            //! 
+            //! @brief Move constructor.
+            //! 
+            //! Instantiates object of ScopedListener class taking ownership of listeners from the source object. The source
+            //! object owns no listeners after that.
+            //! 
+            //! @param[in] _source Object of ScopedListener class.
+            //! 
+            //! @par Complexity
+            //! Constant.
+            //! 
+            //! @par Exception safety
+            //! Will not throw.
+            //! 
+            ScopedListener(ScopedListener &&_source) noexcept
+                : dispatcher_   (_source.dispatcher_)
+                , subscriptions_(std::move(_source.subscriptions_))
+            {
+                _source.subscriptions_.clear();
+            }
+
+            //==================================================================================================================
+            //! 
+            //! @brief Destructor.
+            //! 
+            //! Unsubscribes all listeners subscribed through the object.
+            //! 
+            //! @par Complexity
+            //! Linear in the number of listeners subscribed through the object.
+            //! 
+            //! @par Exception safety
+            //! Will not throw. If unsubscribing a listener throws, for example when the dispatcher's mutex cannot be locked,
+            //! the exception is ignored, the listener may stay subscribed, and the remaining listeners are still
+            //! unsubscribed.
+            //! 
+            ~ScopedListener()
+            {
+                disconnect_all();
+            }
+
+            //==================================================================================================================
+            //! 
+            //! @brief Move assignment operator.
+            //! 
+            //! Unsubscribes all listeners subscribed through the object and takes ownership of listeners from the source
+            //! object. The source object owns no listeners after that.
+            //! 
+            //! @param[in] _source Object of ScopedListener class.
+            //! 
+            //! @return Reference to the object.
+            //! 
+            //! @par Complexity
+            //! Linear in the number of listeners subscribed through the object.
+            //! 
+            //! @par Exception safety
+            //! Will not throw unless unsubscribing a listener throws. If it throws, the listener may stay subscribed, the
+            //! remaining listeners are still unsubscribed and the ownership is still taken, then the first exception is
+            //! rethrown.
+            //! 
+            ScopedListener &operator=(ScopedListener &&_source)
+            {
+                if (this != &_source)
+                {
+                    std::exception_ptr const exception = disconnect_all();
+
+                    dispatcher_    = _source.dispatcher_;
+                    subscriptions_ = std::move(_source.subscriptions_);
+
+                    _source.subscriptions_.clear();
+
+                    if (exception)
+                        std::rethrow_exception(exception);
+                }
+
+                return *this;
+            }
+
+            //==================================================================================================================
+            //! 
+            //! @{
+            //! 
+            //! @brief Subscribes listener to the event of the dispatcher.
+            //! 
+            //! The listener is subscribed by the dispatcher's connect function and stays subscribed until it is unsubscribed
+            //! by remove_listeners function or the object is destroyed.
+            //! 
+            //! @tparam _Event A type of event that listener is subscribing to.
+            //! @tparam _Callable A type of function object or function.
+            //! 
+            //! @param[in] _priority [2] A value that is used to determine listeners' invocation order.
+            //! @param[in] _callable A reference to function object or pointer/reference to a function that will be invoked
+            //! when an event occurs.
+            //! @param[in] _order Specifies where the listener will be placed. The default value is Order::BACK.
+            //! 
+            //! @return Connection identifying the subscribed listener.
+            //! 
+            //! @par Complexity
+            //! The same as the complexity of the dispatcher's connect function.
+            //! 
+            //! @par Exception safety
+            //! This routine meets the strong exception guarantee, where any exception thrown will cause the listener to not
+            //! be subscribed to the event.
+            //! 
+            //! @remark Listener signature: void (_Event const &).
+            //! 
+            template <typename _Event, typename _Callable>
+            connection_t add_listener(_Callable &&_callable, Order _order = Order::BACK)
+            {
+                return keep<_Event>(dispatcher_->template connect<_Event>(std::forward<_Callable>(_callable), _order));
+            }
+
+            template <typename _Event, typename _Callable>
+            connection_t add_listener(priority_t _priority, _Callable &&_callable, Order _order = Order::BACK)
+            {
+                return keep<_Event>(dispatcher_->template connect<_Event>(_priority, std::forward<_Callable>(_callable),
+                                                                          _order));
+            }
+            //! 
+            //! @}
+            //! 
+
+            //==================================================================================================================
+            //! 
+            //! @brief Unsubscribes all listeners subscribed through the object from all events.
+            //! 
+            //! @return No return value.
+            //! 
+            //! @par Complexity
+            //! Linear in the number of listeners subscribed through the object.
+            //! 
+            //! @par Exception safety
+            //! Will not throw unless unsubscribing a listener throws. If it throws, the listener may stay subscribed, the
+            //! remaining listeners are still unsubscribed, then the first exception is rethrown.
+            //! 
+            void remove_listeners()
+            {
+                std::exception_ptr const exception = disconnect_all();
+
+                if (exception)
+                    std::rethrow_exception(exception);
+            }
+
+        private:
+            //==================================================================================================================
+            // 
+            // Unsubscribes all listeners subscribed through the object. An exception thrown by unsubscribing a listener does
+            // not stop unsubscribing the others, and the first one is returned.
+            // 
+            std::exception_ptr disconnect_all() noexcept
+            {
+                std::exception_ptr exception;
+
+                for (Subscription const &subscription : subscriptions_)
+                {
+                    try
+                    {
+                        subscription.disconnect(*dispatcher_, subscription.connection);
+                    }
+                    catch (...)
+                    {
+                        if (!exception)
+                            exception = std::current_exception();
+                    }
+                }
+
+                subscriptions_.clear();
+
+                return exception;
+            }
+
+            //==================================================================================================================
+            // 
+            // Keeps the connection of the listener subscribed to the event. Unsubscribes the listener if the connection
+            // cannot be kept.
+            // 
+            template <typename _Event>
+            connection_t const &keep(connection_t const &_connection)
+            {
+                try
+                {
+                    subscriptions_.push_back(Subscription{ &ScopedListener::disconnect<_Event>, _connection });
+                }
+                catch (...)
+                {
+                    disconnect<_Event>(*dispatcher_, _connection);
+                    throw;
+                }
+
+                return subscriptions_.back().connection;
+            }
+
+            //==================================================================================================================
+            template <typename _Event>
+            static void disconnect(_Dispatcher &_dispatcher, connection_t const &_connection)
+            {
+                _dispatcher.template remove_listener<_Event>(_connection);
+            }
+
+        private:
+            ScopedListener           (ScopedListener const &) = delete;
+            ScopedListener &operator=(ScopedListener const &) = delete;
+
+        private:
+            _Dispatcher               *dispatcher_;
+            std::vector<Subscription>  subscriptions_;
+        };
+
+    }  // namespace events
+
+}  // namespace cws
@@ -0,0 +1,340 @@
+// cws::events::StaticDispatcher class dispatches events to listeners specified at compile time.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+//! 
+//! @file
+//! 
+#pragma once
+
+
+//==============================================================================================================================
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+//==============================================================================================================================
+#include "details.hpp"
+#include "dispatcher/list.hpp"
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Listeners of StaticDispatcher class.
+        //! 
+        //! A listener is invoked for every event it can be called with. Listeners are invoked by direct calls, which the
+        //! compiler can inline.
+        //! 
+        namespace static_listener
+        {
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Specifies function listener.
+            //! 
+            //! @tparam _Function A type of pointer to function.
+            //! @tparam _Pointer Pointer to function.
+            //! @tparam _Priority Priority of the listener.
+            //! 
+            template <typename _Function, _Function _Pointer, int _Priority = 0>
+            struct Function
+            {
+                static int const priority = _Priority;  //!< Priority of the listener.
+
+                //! Invokes the function.
+                template <typename _Event>
+                static auto invoke(_Event const &_event) -> decltype(_Pointer(_event), void())
+                {
+                    _Pointer(_event);
+                }
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Specifies function object listener.
+            //! 
+            //! @tparam _Functor A type of stateless default-constructible function object, which is constructed for each
+            //! call.
+            //! @tparam _Priority Priority of the listener.
+            //! 
+            template <typename _Functor, int _Priority = 0>
+            struct Functor
+            {
+                static int const priority = _Priority;  //!< Priority of the listener.
+
+                //! Invokes the function object.
+                template <typename _Event>
+                static auto invoke(_Event const &_event) -> decltype(_Functor()(_event), void())
+                {
+                    _Functor()(_event);
+                }
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Specifies member function listener.
+            //! 
+            //! @tparam _Class A type of object.
+            //! @tparam _Function A type of pointer to member function.
+            //! @tparam _Pointer Pointer to member function.
+            //! @tparam _Object Pointer to object with static storage duration.
+            //! @tparam _Priority Priority of the listener.
+            //! 
+            template <typename _Class, typename _Function, _Function _Pointer, _Class *_Object, int _Priority = 0>
+            struct Method
+            {
+                static int const priority = _Priority;  //!< Priority of the listener.
+
+                //! Invokes the member function of the object.
+                template <typename _Event>
+                static auto invoke(_Event const &_event) -> decltype((_Object->*_Pointer)(_event), void())
+                {
+                    (_Object->*_Pointer)(_event);
+                }
+            };
+
+        }  // namespace static_listener
+
+
+        //======================================================================================================================
+        namespace dispatcher
+        {
+
+
+            //==================================================================================================================
+            // 
+            // Checks whether the listener can be invoked with the event.
+            // 
+            template <typename _Listener, typename _Event, typename = void>
+            struct IsListening :
+                std::false_type
+            {
+            };
+
+            //==================================================================================================================
+            template <typename _Listener, typename _Event>
+            struct IsListening<_Listener, _Event, decltype(_Listener::invoke(std::declval<_Event const &>()))> :
+                std::true_type
+            {
+            };
+
+
+            //==================================================================================================================
+            // 
+            // Sorts listeners by their priorities at compile time. Listeners of the same priority keep their order.
+            // 
+            template <typename _Comparator, int ..._Priorities>
+            struct StaticOrder
+            {
+                // 
+                // Returns the position of the listener with the specified index.
+                // 
+                static constexpr std::size_t position(std::size_t _index)
+                {
+                    int const priorities[] = { _Priorities..., 0 };
+
+                    std::size_t position = 0;
+
+                    for (std::size_t i = 0; i != sizeof...(_Priorities); ++i)
+                    {
+                        if (_Comparator()(priorities[i], priorities[_index]) ||
+                            (i < _index && !_Comparator()(priorities[_index], priorities[i])))
+                            ++position;
+                    }
+
+                    return position;
+                }
+
+                // 
+                // Returns the index of the listener at the specified position.
+                // 
+                static constexpr std::size_t index(std::size_t _position)
+                {
+                    for (std::size_t i = 0; i != sizeof...(_Priorities); ++i)
+                    {
+                        if (position(i) == _position)
+                            return i;
+                    }
+
+                    return 0;
+                }
+            };
+
+
+            //==================================================================================================================
+            template <std::size_t _Index, typename _This, typename ..._Rest>
+            struct NthType :
+                NthType<_Index - 1, _Rest...>
+            {
+            };
+
+            //==================================================================================================================
+            template <typename _This, typename ..._Rest>
+            struct NthType<0, _This, _Rest...>
+            {
+                typedef _This  type;
+            };
+
+        }  // namespace dispatcher
+
+
+        //======================================================================================================================
+        template <typename ..._Types>
+        class StaticDispatcher;
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Dispatcher with listeners specified at compile time.
+        //! 
+        //! StaticDispatcher class dispatches events to listeners that are specified by its template parameters, so that
+        //! dispatching compiles to direct calls of the listeners, which the compiler can inline. It has no type erasure, no
+        //! memory allocation, and no locking. Listeners cannot be subscribed or unsubscribed at run time.
+        //! 
+        //! @tparam _Comparator A type of method used for determining higher priority. Its function call operator must be
+        //! constexpr. The default is std::less<int>.
+        //! @tparam ..._Events Types of events that dispatcher can dispatch.
+        //! @tparam ..._Listeners Listeners from static_listener namespace.
+        //! 
+        //! @remark StaticDispatcher is instantiated as StaticDispatcher<TypesList<_Events...>, _Listeners...>, or as
+        //! StaticDispatcher<PriorityType<int, _Comparator>, TypesList<_Events...>, _Listeners...> to specify comparator.
+        //! 
+        //! @remark Listeners are invoked in the order of their priorities. Listeners of the same priority are invoked in the
+        //! order they are specified.
+        //! 
+        //! @remark StaticDispatcher class is empty, and it is as thread-safe as its listeners.
+        //! 
+        //! @par Header
+        //! cws/events.hpp
+        //! 
+        //! @par Namespace
+        //! cws::events
+        //! 
+        //! @par Example
+        //! @include{lineno} example_static_dispatcher.cpp
+        //! 
+        //! @par Output
+        //! @include example_static_dispatcher.txt
+        //! 
+        template <typename _Comparator, typename ..._Events, typename ..._Listeners>
+        class StaticDispatcher<PriorityType<int, _Comparator>, TypesList<_Events...>, _Listeners...>
+        {
+            typedef dispatcher::StaticOrder<_Comparator, _Listeners::priority...>  order_t;
+
+        public:
+            //==================================================================================================================
+            //! 
+            //! @brief Invokes listeners of the event.
+            //! 
+            //! Invokes listeners that can be called with the event in the order of their priorities.
+            //! 
+            //! @tparam _Event The type of event occurs.
+            //! 
+            //! @param[in] _event Event object that will be passed as a parameter to listeners.
+            //! 
+            //! @return
+            //! No return value.
+            //! 
+            //! @par Complexity
+            //! Linear in the number of listeners of the event plus listeners' complexity.
+            //! 
+            //! @par Exception safety
+            //! If an exception is thrown by a listener call, all listeners after that will not be invoked.
+            //! 
+            //! @par Example
+            //! @include{lineno} example_static_dispatcher.cpp
+            //! 
+            //! @par Output
+            //! @include example_static_dispatcher.txt
+            //! 
+            template <typename _Event>
+            void dispatch(_Event const &_event) const
+            {
+                static_assert(dispatcher::IsOneOf<_Event, _Events...>::value, "The event is not in the events list.");
+
+                dispatch(_event, std::make_index_sequence<sizeof...(_Listeners)>());
+            }
+
+            //==================================================================================================================
+            //! 
+            //! @brief Checks whether any listener can be invoked with the event.
+            //! 
+            //! @tparam _Event The type of event.
+            //! 
+            //! @return true if at least one listener can be called with the event, false otherwise.
+            //! 
+            template <typename _Event>
+            static constexpr bool has_listeners() noexcept
+            {
+                return !std::is_same<dispatcher::Bools<false, dispatcher::IsListening<_Listeners, _Event>::value...>,
+                                     dispatcher::Bools<dispatcher::IsListening<_Listeners, _Event>::value..., false>>::value;
+            }
+
+        private:
+            //==================================================================================================================
+            template <typename _Event, std::size_t ..._Positions>
+            void dispatch(_Event const &_event, std::index_sequence<_Positions...>) const
+            {
+                int const calls[] = { 0, (call<order_t::index(_Positions)>(_event), 0)... };
+
+                static_cast<void>(calls);
+            }
+
+            //==================================================================================================================
+            template <std::size_t _Index, typename _Event>
+            static void call(_Event const &_event)
+            {
+                typedef typename dispatcher::NthType<_Index, _Listeners...>::type  listener_t;
+
+                invoke<listener_t>(_event, dispatcher::IsListening<listener_t, _Event>());
+            }
+
+            //==================================================================================================================
+            template <typename _Listener, typename _Event>
+            static void invoke(_Event const &_event, std::true_type)
+            {
+                _Listener::invoke(_event);
+            }
+
+            //==================================================================================================================
+            template <typename _Listener, typename _Event>
+            static void invoke(_Event const &, std::false_type)
+            {
+            }
+        };
+
+
+        //======================================================================================================================
+        // 
+        // Static dispatcher with the default comparator.
+        // 
+        template <typename ..._Events, typename ..._Listeners>
+        class StaticDispatcher<TypesList<_Events...>, _Listeners...> :
+            public StaticDispatcher<PriorityType<>, TypesList<_Events...>, _Listeners...>
+        {
+        };
+
+    }  // namespace events
+
+}  // namespace cws
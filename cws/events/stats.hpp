@@ -0,0 +1,277 @@
+// cws::events::stats namespace contains statistics that a dispatcher can collect about dispatched events.
+// 
+// Copyright (c) 2014-2021 Zaur Khachemizov
+// 
+// Use, modification, and distribution is subject to the C++ convenient wrappers library license Version 1.0 at accompanying
+// file license.txt or at http://www.cpphelpers.org/license/
+// 
+// See documentation at docs/index.html
+
+
+//==============================================================================================================================
+//! 
+//! @file
+//! 
+#pragma once
+
+
+//==============================================================================================================================
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+
+//==============================================================================================================================
+namespace cws
+{
+
+
+    //==========================================================================================================================
+    namespace events
+    {
+
+
+        //======================================================================================================================
+        //! 
+        //! @brief Statistics of dispatched events.
+        //! 
+        //! Statistics are collected by a dispatcher instantiated with StatsType<stats::Enabled>, and are returned by its
+        //! stats function.
+        //! 
+        namespace stats
+        {
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Collects no statistics. This is the default.
+            //! 
+            //! The dispatcher neither measures nor counts anything, and has no data for statistics.
+            //! 
+            struct Disabled
+            {
+                static bool const enabled  = false; //!< Statistics are not collected.
+                static bool const profiled = false; //!< Listeners are not profiled.
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Collects statistics of each event of the dispatcher.
+            //! 
+            //! Counters are sharded: each thread updates its own shard, and shards are summed when statistics are taken, so
+            //! that threads dispatching concurrently do not contend for the counters.
+            //! 
+            struct Enabled
+            {
+                static bool const enabled  = true;  //!< Statistics are collected.
+                static bool const profiled = false; //!< Listeners are not profiled.
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Collects statistics of each event as stats::Enabled does, and profiles each listener.
+            //! 
+            //! Each invocation of a listener is timed, and the durations are aggregated per listener, so that the slowest
+            //! listeners are reported by top_listeners function. Timing costs two reads of std::chrono::steady_clock per
+            //! invocation.
+            //! 
+            //! @remark Listeners subscribed with tracked objects are not profiled. A profiled listener is wrapped together
+            //! with its profile, so a listener that fits the storage specified by StorageType without profiling may not fit
+            //! it with profiling.
+            //! 
+            struct Profiled
+            {
+                static bool const enabled  = true; //!< Statistics are collected.
+                static bool const profiled = true; //!< Listeners are profiled.
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Log-linear histogram of durations in nanoseconds.
+            //! 
+            //! Durations below 4 nanoseconds have a bucket each. Every power of two above is split into 4 buckets of equal
+            //! width, so that a bucket is less than 25% wider than its lower bound. Durations of 2^33 nanoseconds and longer
+            //! fall into the last bucket.
+            //! 
+            struct Histogram
+            {
+                static std::size_t const BUCKETS_COUNT = 128; //!< Number of buckets.
+
+                //==============================================================================================================
+                //! @brief Returns the index of the bucket of the duration.
+                static std::size_t bucket(std::uint64_t _nanoseconds) noexcept
+                {
+                    if (_nanoseconds < 4)
+                        return static_cast<std::size_t>(_nanoseconds);
+
+                    std::size_t exponent = 2;
+
+                    while (exponent != BUCKETS_COUNT / 4 && (_nanoseconds >> (exponent + 1)) != 0)
+                        ++exponent;
+
+                    if ((_nanoseconds >> (exponent + 1)) != 0)
+                        return BUCKETS_COUNT - 1;
+
+                    return 4 * (exponent - 1) + static_cast<std::size_t>((_nanoseconds >> (exponent - 2)) & 3);
+                }
+
+                //==============================================================================================================
+                //! @brief Returns the least duration falling into the bucket.
+                static std::uint64_t lower_bound(std::size_t _bucket) noexcept
+                {
+                    if (_bucket < 4)
+                        return _bucket;
+
+                    return static_cast<std::uint64_t>(4 + _bucket % 4) << (_bucket / 4 - 1);
+                }
+
+                //==============================================================================================================
+                //! @brief Returns the number of recorded durations.
+                std::uint64_t total() const noexcept
+                {
+                    std::uint64_t total = 0;
+
+                    for (std::uint64_t count : counts)
+                        total += count;
+
+                    return total;
+                }
+
+                //==============================================================================================================
+                //! 
+                //! @brief Returns the lower bound of the bucket containing the specified quantile of recorded durations.
+                //! 
+                //! The quantile is the duration of the nearest rank, that is the ceil(_quantile * total())-th least one, so
+                //! the 99th percentile of 100 durations is the 99th least one.
+                //! 
+                //! @param[in] _quantile A value in [0, 1], for example 0.99 for the 99th percentile.
+                //! 
+                //! @return The lower bound in nanoseconds, or 0 if no duration is recorded.
+                //! 
+                std::uint64_t quantile(double _quantile) const noexcept
+                {
+                    std::uint64_t const count = total();
+
+                    if (count == 0)
+                        return 0;
+
+                    // 
+                    // The product is reduced by a relative error, so that products like 0.07 * 100 computed as
+                    // 7.000000000000001 do not round up to the next rank.
+                    // 
+                    double const        product = _quantile * static_cast<double>(count) * (1.0 - 1e-12);
+                    std::uint64_t const rank    = product <= 1.0                         ? 1     :
+                                                  product >= static_cast<double>(count) ? count :
+                                                  static_cast<std::uint64_t>(std::ceil(product));
+
+                    std::uint64_t seen = 0;
+
+                    for (std::size_t i = 0; i != BUCKETS_COUNT; ++i)
+                    {
+                        seen += counts[i];
+
+                        if (seen >= rank)
+                            return lower_bound(i);
+                    }
+
+                    return 0;
+                }
+
+                std::array<std::uint64_t, BUCKETS_COUNT> counts; //!< Number of durations in each bucket.
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Statistics of an event.
+            //! 
+            //! @remark A batch dispatched by dispatch_batch function counts as a dispatch of each of its events, which all
+            //! get the average duration. Dispatching interrupted by an exception is not counted.
+            //! 
+            //! @remark Subscriptions count calls of add_listener and connect functions. Unsubscriptions count calls of
+            //! remove_listener and remove_listeners functions, but not disconnections by connections and expiration of
+            //! tracked objects.
+            //! 
+            struct EventStats
+            {
+                std::string    name;         //!< Demangled name of the event type.
+                std::uint64_t  dispatches;   //!< Number of dispatched events.
+                std::uint64_t  invocations;  //!< Number of listeners invoked by the dispatched events.
+                std::uint64_t  subscribes;   //!< Number of subscribed listeners.
+                std::uint64_t  unsubscribes; //!< Number of requests to remove listeners.
+                Histogram      latency;      //!< Durations of dispatching.
+            };
+
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Listener with a label, which identifies the listener in profiles.
+            //! 
+            //! Created by stats::label function. It is subscribed as the listener itself, and the label is used only if
+            //! listeners are profiled.
+            //! 
+            //! @tparam _Callable A type of the listener.
+            //! 
+            template <typename _Callable>
+            struct Labeled
+            {
+                std::string  label;     //!< Label of the listener.
+                _Callable    callable;  //!< The listener.
+            };
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Labels the listener for profiles.
+            //! 
+            //! @param[in] _label Label of the listener.
+            //! @param[in] _callable Function object or function.
+            //! 
+            //! @return The labeled listener.
+            //! 
+            //! @par Example
+            //! @include{lineno} example_top_listeners.cpp
+            //! 
+            //! @par Possible output
+            //! @include example_top_listeners.txt
+            //! 
+            template <typename _Callable>
+            inline Labeled<typename std::decay<_Callable>::type> label(std::string _label, _Callable &&_callable)
+            {
+                return { std::move(_label), std::forward<_Callable>(_callable) };
+            }
+
+
+            //==================================================================================================================
+            //! 
+            //! @brief Profile of a listener.
+            //! 
+            //! @tparam _Connection A type of connection identifying subscribed listeners.
+            //! 
+            //! @remark Durations are in nanoseconds. An invocation interrupted by an exception is not counted.
+            //! 
+            template <typename _Connection>
+            struct ListenerStats
+            {
+                _Connection    connection;  //!< Connection identifying the listener.
+                std::string    event;       //!< Demangled name of the event type the listener is subscribed to.
+                std::string    label;       //!< Label given by stats::label function, or demangled type of the listener.
+                std::uint64_t  invocations; //!< Number of invocations.
+                std::uint64_t  total;       //!< Total duration of the invocations.
+                std::uint64_t  max;         //!< Longest duration of an invocation.
+                std::uint64_t  p99;         //!< Lower bound of the histogram bucket of the 99th percentile of durations.
+            };
+
+        }  // namespace stats
+
+    }  // namespace events
+
+}  // namespace cws
@@ -39,7 +39,7 @@ int main()
     SomeClass                          someClass;
  
     dispatcher.add_listener<SomeEvent>(some_listener);
-    dispatcher.add_listener<SomeEvent>(boost::bind(&SomeClass::ptr_listener, &someClass, _1), cws::events::Order::FRONT);
+    dispatcher.add_listener<SomeEvent>(&SomeClass::ptr_listener, &someClass, cws::events::Order::FRONT);
 
     {
         std::shared_ptr<SomeClass> sharedSomeClass(new SomeClass());
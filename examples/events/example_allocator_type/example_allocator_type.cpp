@@ -0,0 +1,113 @@
+//==============================================================================================================================
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+// 
+// Memory arena allocating from a fixed buffer and releasing memory all at once when it is destroyed.
+// 
+class Arena
+{
+public:
+    void *allocate(std::size_t _size)
+    {
+        std::size_t const ALIGNMENT = alignof(std::max_align_t);
+
+        std::size_t const offset = (used_ + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+        if (offset + _size > sizeof(buffer_))
+            throw std::bad_alloc();
+
+        used_ = offset + _size;
+
+        return buffer_ + offset;
+    }
+
+    std::size_t used() const
+    {
+        return used_;
+    }
+
+private:
+    alignas(std::max_align_t) char buffer_[16384];
+    std::size_t                    used_ = 0;
+};
+
+
+//==============================================================================================================================
+template <typename _Type>
+struct ArenaAllocator
+{
+    typedef _Type value_type;
+
+    explicit ArenaAllocator(Arena &_arena)
+        : arena(&_arena)
+    {
+    }
+
+    template <typename _Other>
+    ArenaAllocator(ArenaAllocator<_Other> const &_other)
+        : arena(_other.arena)
+    {
+    }
+
+    _Type *allocate(std::size_t _count)
+    {
+        return static_cast<_Type *>(arena->allocate(_count * sizeof(_Type)));
+    }
+
+    void deallocate(_Type *, std::size_t)
+    {
+    }
+
+    template <typename _Other>
+    bool operator==(ArenaAllocator<_Other> const &_other) const
+    {
+        return arena == _other.arena;
+    }
+
+    template <typename _Other>
+    bool operator!=(ArenaAllocator<_Other> const &_other) const
+    {
+        return arena != _other.arena;
+    }
+
+    Arena *arena;
+};
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+    int value;
+};
+
+
+//==============================================================================================================================
+int main()
+{
+    Arena arena;
+
+    typedef cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>,
+        cws::events::AllocatorType<ArenaAllocator<char>>, cws::events::TypesList<SomeEvent>>::type  dispatcher_t;
+
+    dispatcher_t dispatcher{ ArenaAllocator<char>(arena) };
+
+    std::cout << "arena is used: " << std::boolalpha << (arena.used() != 0) << std::endl;
+
+    dispatcher.connect<SomeEvent>([](SomeEvent const &_event)
+    {
+        std::cout << "some_listener: " << _event.value << std::endl;
+    });
+
+    dispatcher.enqueue(SomeEvent{ 1 });
+    dispatcher.process();
+    dispatcher.dispatch(SomeEvent{ 2 });
+
+    std::cout << "arena is used: " << std::boolalpha << (arena.used() != 0) << std::endl;
+
+    return 0;
+}
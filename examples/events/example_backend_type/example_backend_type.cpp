@@ -0,0 +1,38 @@
+//==============================================================================================================================
+#include <iostream>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+};
+
+
+//==============================================================================================================================
+void some_listener(SomeEvent const &)
+{
+    std::cout << "some_listener" << std::endl;
+}
+
+
+//==============================================================================================================================
+void some_other_listener(SomeEvent const &)
+{
+    std::cout << "some_other_listener" << std::endl;
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>,
+        cws::events::TypesList<SomeEvent>>::type dispatcher;
+
+    dispatcher.add_listener<SomeEvent>(some_other_listener);
+    dispatcher.add_listener<SomeEvent>(0, some_listener);
+
+    dispatcher.dispatch(SomeEvent());
+
+    return 0;
+}
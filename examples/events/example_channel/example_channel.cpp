@@ -0,0 +1,67 @@
+//==============================================================================================================================
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct PriceEvent
+{
+    int price;
+};
+
+
+//==============================================================================================================================
+typedef cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>,
+                                      cws::events::TypesList<PriceEvent>>::type dispatcher_t;
+
+
+//==============================================================================================================================
+int total = 0;
+
+
+//==============================================================================================================================
+void price_listener(PriceEvent const &_event)
+{
+    total += _event.price;
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    dispatcher_t dispatcher;
+
+    dispatcher.add_listener<PriceEvent>(price_listener);
+
+    cws::events::Channel<dispatcher_t> channel(dispatcher, 64);
+
+    std::vector<std::thread> producers;
+
+    for (int i = 0; i != 4; ++i)
+    {
+        producers.emplace_back([&channel]()
+        {
+            for (int price = 1; price <= 100; ++price)
+                channel.try_post(PriceEvent{ price });
+        });
+    }
+
+    for (std::size_t dispatched = 0; dispatched != 400; )
+        dispatched += channel.drain();
+
+    for (std::thread &producer : producers)
+        producer.join();
+
+    std::cout << "Total: " << total << std::endl;
+
+    cws::events::Channel<dispatcher_t, cws::events::overflow::DropNewest> bounded(dispatcher, 2);
+
+    for (int price = 1; price <= 5; ++price)
+        std::cout << "Price " << price << (bounded.try_post(PriceEvent{ price }) ? " posted" : " dropped") << std::endl;
+
+    std::cout << "Dispatched: " << bounded.drain() << ", dropped: " << bounded.dropped() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+//==============================================================================================================================
+#include <iostream>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct PositionChanged
+{
+    int entity;
+    int x;
+    int y;
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct Coalescing<PositionChanged> :
+            CoalescedBy<int>
+        {
+            static int key(PositionChanged const &_event)
+            {
+                return _event.entity;
+            }
+        };
+    }
+}
+
+
+//==============================================================================================================================
+struct Selected
+{
+    int entity;
+};
+
+
+//==============================================================================================================================
+void on_position_changed(PositionChanged const &_event)
+{
+    std::cout << "entity " << _event.entity << " moved to (" << _event.x << ", " << _event.y << ")" << std::endl;
+}
+
+
+//==============================================================================================================================
+void on_selected(Selected const &_event)
+{
+    std::cout << "entity " << _event.entity << " selected" << std::endl;
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::Dispatcher<PositionChanged, Selected> dispatcher;
+
+    dispatcher.add_listener<PositionChanged>(on_position_changed);
+    dispatcher.add_listener<Selected>(on_selected);
+
+    for (int step = 1; step <= 100; ++step)
+    {
+        dispatcher.enqueue(PositionChanged{ 1, step, 0 });
+        dispatcher.emplace<PositionChanged>(2, 0, -step);
+
+        if (step == 50)
+            dispatcher.enqueue(Selected{ 2 });
+    }
+
+    size_t const processed = dispatcher.process();
+
+    std::cout << "processed: " << processed << std::endl;
+
+    dispatcher.enqueue(PositionChanged{ 1, 0, 0 });
+
+    size_t const rest = dispatcher.process();
+
+    std::cout << "processed: " << rest << std::endl;
+
+    return 0;
+}
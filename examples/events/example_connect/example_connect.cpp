@@ -0,0 +1,41 @@
+//==============================================================================================================================
+#include <iostream>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+};
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>,
+        cws::events::TypesList<SomeEvent>>::type dispatcher;
+
+    auto some_listener = [](SomeEvent const &) { std::cout << "some_listener" << std::endl; };
+
+    auto first  = dispatcher.connect<SomeEvent>(some_listener);
+    auto second = dispatcher.connect<SomeEvent>(some_listener);
+
+    dispatcher.dispatch(SomeEvent());
+
+    std::cout << std::endl;
+
+    dispatcher.remove_listener<SomeEvent>(first);
+
+    dispatcher.dispatch(SomeEvent());
+
+    std::cout << std::endl;
+
+    dispatcher.remove_listener<SomeEvent>(second);
+    dispatcher.remove_listener<SomeEvent>(first);
+
+    dispatcher.dispatch(SomeEvent());
+
+    std::cout << "end" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+//==============================================================================================================================
+#include <iostream>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+    int value;
+};
+
+
+//==============================================================================================================================
+void some_listener(SomeEvent const &_event)
+{
+    std::cout << __FUNCTION__ << ": " << _event.value << std::endl;
+}
+
+
+//==============================================================================================================================
+class SomeClass
+{
+public:
+    void some_method(SomeEvent const &_event)
+    {
+        std::cout << __FUNCTION__ << ": " << _event.value << std::endl;
+    }
+
+    void const_method(SomeEvent const &_event) const
+    {
+        std::cout << __FUNCTION__ << ": " << _event.value << std::endl;
+    }
+};
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::Dispatcher<SomeEvent> dispatcher;
+    SomeClass                          someClass;
+    SomeClass const                    constClass;
+
+    dispatcher.add_listener<SomeEvent>(&SomeClass::some_method, &someClass);
+    dispatcher.add_listener<SomeEvent>(&SomeClass::const_method, &constClass);
+    dispatcher.add_listener<SomeEvent>(cws::events::Delegate<SomeEvent>(some_listener));
+
+    dispatcher.dispatch(SomeEvent{ 1 });
+
+    std::cout << std::endl;
+
+    dispatcher.add_listener<SomeEvent>(&SomeClass::some_method, &someClass);
+    dispatcher.remove_listener<SomeEvent>(&SomeClass::const_method, &constClass);
+
+    dispatcher.dispatch(SomeEvent{ 2 });
+
+    std::cout << std::endl;
+
+    cws::events::Delegate<SomeEvent> const delegate(&SomeClass::some_method, &someClass);
+
+    std::cout << std::boolalpha << "equal: " << (delegate == cws::events::Delegate<SomeEvent>(&SomeClass::some_method,
+                                                                                              &someClass)) << std::endl;
+    std::cout << std::boolalpha << "equal: " << (delegate == cws::events::Delegate<SomeEvent>(some_listener)) << std::endl;
+
+    delegate(SomeEvent{ 3 });
+
+    return 0;
+}
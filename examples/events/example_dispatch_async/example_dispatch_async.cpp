@@ -0,0 +1,53 @@
+//==============================================================================================================================
+#include <exception>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+    int value;
+};
+
+
+//==============================================================================================================================
+void some_listener(SomeEvent const &_event)
+{
+    if (_event.value < 0)
+        throw _event.value;
+
+    std::cout << __FUNCTION__ << ": " << _event.value << std::endl;
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                  cws::events::ExecutorType<cws::events::executor::Pool>,
+                                  cws::events::TypesList<SomeEvent>>::type dispatcher;
+
+    dispatcher.add_listener<SomeEvent>(some_listener);
+
+    std::future<void> future = dispatcher.dispatch_async(SomeEvent{ 1 });
+
+    future.wait();
+
+    std::cout << "completed" << std::endl;
+
+    std::promise<void> completed;
+
+    dispatcher.dispatch_async(SomeEvent{ -1 }, [&completed](std::exception_ptr _error)
+    {
+        std::cout << (_error ? "failed" : "completed") << std::endl;
+
+        completed.set_value();
+    });
+
+    completed.get_future().wait();
+
+    return 0;
+}
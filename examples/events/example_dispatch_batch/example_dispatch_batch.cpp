@@ -0,0 +1,46 @@
+//==============================================================================================================================
+#include <iostream>
+#include <vector>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+    int value;
+};
+
+
+//==============================================================================================================================
+void some_listener(SomeEvent const &_event)
+{
+    std::cout << __FUNCTION__ << ": " << _event.value << std::endl;
+}
+
+
+//==============================================================================================================================
+void batch_listener(cws::events::Batch<SomeEvent> const &_batch)
+{
+    int sum = 0;
+
+    for (SomeEvent const &event : _batch)
+        sum += event.value;
+
+    std::cout << __FUNCTION__ << ": " << _batch.size() << " events, sum " << sum << std::endl;
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::Dispatcher<SomeEvent, cws::events::Batch<SomeEvent>> dispatcher;
+
+    dispatcher.add_listener<SomeEvent>(some_listener);
+    dispatcher.add_listener<cws::events::Batch<SomeEvent>>(batch_listener);
+
+    std::vector<SomeEvent> const events = { { 1 }, { 2 }, { 3 } };
+
+    dispatcher.dispatch_batch(events.data(), events.data() + events.size());
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+//==============================================================================================================================
+#include <iostream>
+#include <string>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+    std::string text;
+};
+
+
+//==============================================================================================================================
+void some_listener(SomeEvent const &_event)
+{
+    std::cout << __FUNCTION__ << ": " << _event.text << std::endl;
+}
+
+
+//==============================================================================================================================
+SomeEvent make_event(int _value)
+{
+    std::cout << __FUNCTION__ << ": " << _value << std::endl;
+
+    return SomeEvent{ "value " + std::to_string(_value) };
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::Dispatcher<SomeEvent> dispatcher;
+
+    std::cout << std::boolalpha << "has listeners: " << dispatcher.has_listeners<SomeEvent>() << std::endl;
+
+    dispatcher.dispatch_lazy<SomeEvent>([]() { return make_event(1); });
+
+    dispatcher.add_listener<SomeEvent>(some_listener);
+
+    std::cout << std::boolalpha << "has listeners: " << dispatcher.has_listeners<SomeEvent>() << std::endl;
+
+    dispatcher.dispatch_lazy<SomeEvent>([]() { return make_event(2); });
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+//==============================================================================================================================
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+    int value;
+};
+
+
+//==============================================================================================================================
+std::atomic<int> g_total(0);
+
+
+//==============================================================================================================================
+template <int _Weight>
+void weighing_listener(SomeEvent const &_event)
+{
+    g_total += _event.value * _Weight;
+}
+
+
+//==============================================================================================================================
+void total_listener(SomeEvent const &)
+{
+    std::cout << __FUNCTION__ << ": " << g_total << std::endl;
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                  cws::events::BackendType<cws::events::backend::Snapshot>,
+                                  cws::events::ExecutorType<cws::events::executor::Pool>,
+                                  cws::events::TypesList<SomeEvent>>::type dispatcher;
+
+    dispatcher.add_listener<SomeEvent>(0, weighing_listener<1>);
+    dispatcher.add_listener<SomeEvent>(0, weighing_listener<2>);
+    dispatcher.add_listener<SomeEvent>(0, weighing_listener<3>);
+    dispatcher.add_listener<SomeEvent>(0, weighing_listener<4>);
+    dispatcher.add_listener<SomeEvent>(1, total_listener);
+
+    dispatcher.dispatch_parallel(SomeEvent{ 1 });
+    dispatcher.dispatch_parallel(SomeEvent{ 10 });
+
+    return 0;
+}
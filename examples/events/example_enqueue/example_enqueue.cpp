@@ -0,0 +1,63 @@
+//==============================================================================================================================
+#include <chrono>
+#include <iostream>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+    int value;
+};
+
+
+//==============================================================================================================================
+struct SomeOtherEvent
+{
+};
+
+
+//==============================================================================================================================
+void some_listener(SomeEvent const &_event)
+{
+    std::cout << __FUNCTION__ << ": " << _event.value << std::endl;
+}
+
+
+//==============================================================================================================================
+void some_other_listener(SomeOtherEvent const &)
+{
+    std::cout << __FUNCTION__ << std::endl;
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::Dispatcher<SomeEvent, SomeOtherEvent> dispatcher;
+
+    dispatcher.add_listener<SomeEvent>(some_listener);
+    dispatcher.add_listener<SomeOtherEvent>(some_other_listener);
+
+    dispatcher.enqueue(SomeEvent{ 1 });
+    dispatcher.enqueue(SomeOtherEvent());
+    dispatcher.emplace<SomeEvent>(2);
+
+    std::cout << "enqueued" << std::endl;
+
+    size_t const processed = dispatcher.process();
+
+    std::cout << "processed: " << processed << std::endl;
+
+    dispatcher.enqueue(SomeEvent{ 3 });
+
+    size_t const postponed = dispatcher.process_for(std::chrono::seconds(0));
+
+    std::cout << "processed: " << postponed << std::endl;
+
+    size_t const rest = dispatcher.process_for(std::chrono::seconds(1));
+
+    std::cout << "processed: " << rest << std::endl;
+
+    return 0;
+}
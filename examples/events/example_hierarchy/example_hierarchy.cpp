@@ -0,0 +1,97 @@
+//==============================================================================================================================
+#include <iostream>
+#include <string>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct RequestEvent
+{
+    int id;
+};
+
+
+//==============================================================================================================================
+struct RequestFailed :
+    RequestEvent
+{
+    std::string error;
+};
+
+
+//==============================================================================================================================
+struct RequestCompleted :
+    RequestEvent
+{
+    int status;
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct Hierarchy<RequestFailed> :
+            DerivedFrom<RequestEvent>
+        {
+        };
+
+        template <>
+        struct Hierarchy<RequestCompleted> :
+            DerivedFrom<RequestEvent>
+        {
+        };
+    }
+}
+
+
+//==============================================================================================================================
+void on_request(RequestEvent const &_event)
+{
+    std::cout << "request " << _event.id << " finished" << std::endl;
+}
+
+
+//==============================================================================================================================
+void on_failure(RequestFailed const &_event)
+{
+    std::cout << "request " << _event.id << " failed: " << _event.error << std::endl;
+}
+
+
+//==============================================================================================================================
+void on_completion(RequestCompleted const &_event)
+{
+    std::cout << "request " << _event.id << " completed: " << _event.status << std::endl;
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    using namespace cws::events;
+
+    Dispatcher<RequestEvent, RequestFailed, RequestCompleted> dispatcher;
+
+    dispatcher.add_listener<RequestEvent>(on_request);
+    dispatcher.add_listener<RequestFailed>(on_failure);
+
+    RequestFailed failed;
+    failed.id    = 1;
+    failed.error = "timeout";
+
+    RequestCompleted completed;
+    completed.id     = 2;
+    completed.status = 200;
+
+    dispatcher.dispatch(failed);
+    dispatcher.dispatch(completed);
+
+    dispatcher.add_listener<RequestCompleted>(on_completion);
+
+    dispatcher.dispatch(completed);
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+//==============================================================================================================================
+#include <iostream>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+};
+
+
+//==============================================================================================================================
+enum class Priority
+{
+    LOW,
+    NORMAL,
+    HIGH
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct PriorityRange<Priority> :
+            PriorityBounds<Priority, Priority::LOW, Priority::HIGH>
+        {
+        };
+    }
+}
+
+
+//==============================================================================================================================
+void some_listener(SomeEvent const &)
+{
+    std::cout << __FUNCTION__ << std::endl;
+}
+
+
+//==============================================================================================================================
+void some_other_listener(SomeEvent const &)
+{
+    std::cout << __FUNCTION__ << std::endl;
+}
+
+
+//==============================================================================================================================
+void listener_low(SomeEvent const &)
+{
+    std::cout << __FUNCTION__ << std::endl;
+}
+
+
+//==============================================================================================================================
+void listener_normal(SomeEvent const &)
+{
+    std::cout << __FUNCTION__ << std::endl;
+}
+
+
+//==============================================================================================================================
+void listener_high(SomeEvent const &)
+{
+    std::cout << __FUNCTION__ << std::endl;
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::dispatcher::Type<cws::events::PriorityType<Priority, std::greater<Priority>>,
+        cws::events::BackendType<cws::events::backend::Flat>, cws::events::TypesList<SomeEvent>>::type dispatcher;
+
+    dispatcher.add_listener<SomeEvent>(some_other_listener);
+    dispatcher.add_listener<SomeEvent>(some_listener, cws::events::Order::FRONT);
+
+    dispatcher.add_listener<SomeEvent>(Priority::LOW,    listener_low);
+    dispatcher.add_listener<SomeEvent>(Priority::HIGH,   listener_high);
+    dispatcher.add_listener<SomeEvent>(Priority::NORMAL, listener_normal);
+
+    dispatcher.dispatch(SomeEvent());
+
+    return 0;
+}
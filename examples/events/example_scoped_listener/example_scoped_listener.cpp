@@ -0,0 +1,67 @@
+//==============================================================================================================================
+#include <iostream>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+};
+
+
+//==============================================================================================================================
+struct SomeOtherEvent
+{
+};
+
+
+//==============================================================================================================================
+typedef cws::events::Dispatcher<SomeEvent, SomeOtherEvent>  dispatcher_t;
+
+
+//==============================================================================================================================
+class SomeClass
+{
+public:
+    explicit SomeClass(dispatcher_t &_dispatcher)
+        : listener_(_dispatcher)
+    {
+        listener_.add_listener<SomeEvent>([this](SomeEvent const &) { on_some_event(); });
+        listener_.add_listener<SomeOtherEvent>([this](SomeOtherEvent const &) { on_some_other_event(); });
+    }
+
+private:
+    void on_some_event()
+    {
+        std::cout << "on_some_event" << std::endl;
+    }
+
+    void on_some_other_event()
+    {
+        std::cout << "on_some_other_event" << std::endl;
+    }
+
+private:
+    cws::events::ScopedListener<dispatcher_t> listener_;
+};
+
+
+//==============================================================================================================================
+int main()
+{
+    dispatcher_t dispatcher;
+
+    {
+        SomeClass someClass(dispatcher);
+
+        dispatcher.dispatch(SomeEvent());
+        dispatcher.dispatch(SomeOtherEvent());
+    }
+
+    dispatcher.dispatch(SomeEvent());
+    dispatcher.dispatch(SomeOtherEvent());
+
+    std::cout << "end" << std::endl;
+
+    return 0;
+}
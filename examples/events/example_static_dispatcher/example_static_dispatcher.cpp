@@ -0,0 +1,69 @@
+//==============================================================================================================================
+#include <iostream>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+    int value;
+};
+
+
+//==============================================================================================================================
+struct SomeOtherEvent
+{
+};
+
+
+//==============================================================================================================================
+void some_listener(SomeEvent const &_event)
+{
+    std::cout << __FUNCTION__ << ": " << _event.value << std::endl;
+}
+
+
+//==============================================================================================================================
+struct SomeFunctor
+{
+    void operator()(SomeEvent const &_event) const
+    {
+        std::cout << "SomeFunctor: " << _event.value << std::endl;
+    }
+
+    void operator()(SomeOtherEvent const &) const
+    {
+        std::cout << "SomeFunctor: other" << std::endl;
+    }
+};
+
+
+//==============================================================================================================================
+class SomeClass
+{
+public:
+    void some_method(SomeEvent const &_event)
+    {
+        std::cout << __FUNCTION__ << ": " << _event.value << std::endl;
+    }
+};
+
+SomeClass g_object;
+
+
+//==============================================================================================================================
+int main()
+{
+    using namespace cws::events;
+
+    StaticDispatcher<TypesList<SomeEvent, SomeOtherEvent>,
+                     static_listener::Function<void (*)(SomeEvent const &), &some_listener, 2>,
+                     static_listener::Functor<SomeFunctor, 1>,
+                     static_listener::Method<SomeClass, void (SomeClass::*)(SomeEvent const &), &SomeClass::some_method,
+                                             &g_object, 1>> dispatcher;
+
+    dispatcher.dispatch(SomeEvent{ 1 });
+    dispatcher.dispatch(SomeOtherEvent());
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+//==============================================================================================================================
+#include <iostream>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+};
+
+
+//==============================================================================================================================
+struct SomeOtherEvent
+{
+};
+
+
+//==============================================================================================================================
+void some_listener(SomeEvent const &)
+{
+}
+
+
+//==============================================================================================================================
+void some_other_listener(SomeEvent const &)
+{
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>,
+        cws::events::StatsType<cws::events::stats::Enabled>,
+        cws::events::TypesList<SomeEvent, SomeOtherEvent>>::type dispatcher;
+
+    dispatcher.add_listener<SomeEvent>(some_listener);
+    dispatcher.add_listener<SomeEvent>(some_other_listener);
+
+    for (int i = 0; i != 100; ++i)
+        dispatcher.dispatch(SomeEvent());
+
+    dispatcher.remove_listener<SomeEvent>(some_other_listener);
+    dispatcher.dispatch(SomeEvent());
+    dispatcher.dispatch(SomeOtherEvent());
+
+    for (cws::events::stats::EventStats const &event : dispatcher.stats())
+    {
+        std::cout << event.name << ": dispatches " << event.dispatches << ", invocations " << event.invocations
+                  << ", subscribes " << event.subscribes << ", unsubscribes " << event.unsubscribes
+                  << ", median latency " << (event.latency.quantile(0.5) < 1000000 ? "under" : "over") << " 1 ms"
+                  << std::endl;
+    }
+
+    return 0;
+}
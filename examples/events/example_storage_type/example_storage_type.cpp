@@ -0,0 +1,38 @@
+//==============================================================================================================================
+#include <array>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+    int value;
+};
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>, cws::events::StorageType<64>,
+        cws::events::TypesList<SomeEvent>>::type dispatcher;
+
+    std::array<int, 8>           factors = { { 1, 2, 3, 4, 5, 6, 7, 8 } };
+    std::unique_ptr<std::string> name(new std::string("move_only_listener"));
+
+    dispatcher.connect<SomeEvent>([factors](SomeEvent const &_event)
+    {
+        std::cout << "large_listener: " << _event.value * factors.back() << std::endl;
+    });
+
+    dispatcher.connect<SomeEvent>([name = std::move(name)](SomeEvent const &_event)
+    {
+        std::cout << *name << ": " << _event.value << std::endl;
+    });
+
+    dispatcher.dispatch(SomeEvent{ 2 });
+
+    return 0;
+}
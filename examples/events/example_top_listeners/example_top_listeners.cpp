@@ -0,0 +1,51 @@
+//==============================================================================================================================
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct SomeEvent
+{
+};
+
+
+//==============================================================================================================================
+void fast_listener(SomeEvent const &)
+{
+}
+
+
+//==============================================================================================================================
+void slow_listener(SomeEvent const &)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>,
+        cws::events::StatsType<cws::events::stats::Profiled>,
+        cws::events::TypesList<SomeEvent>>::type dispatcher;
+
+    dispatcher.add_listener<SomeEvent>(cws::events::stats::label("fast", fast_listener));
+    dispatcher.add_listener<SomeEvent>(cws::events::stats::label("slow", slow_listener));
+    dispatcher.add_listener<SomeEvent>(cws::events::stats::label("slower", [](SomeEvent const &)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }));
+
+    for (int i = 0; i != 10; ++i)
+        dispatcher.dispatch(SomeEvent());
+
+    for (auto const &listener : dispatcher.top_listeners(2))
+    {
+        std::cout << listener.label << ": invocations " << listener.invocations << ", longest invocation "
+                  << (listener.max < 1000000 ? "under" : "over") << " 1 ms" << std::endl;
+    }
+
+    return 0;
+}
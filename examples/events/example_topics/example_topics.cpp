@@ -0,0 +1,74 @@
+//==============================================================================================================================
+#include <iostream>
+#include <string>
+#include <cws/events.hpp>
+
+
+//==============================================================================================================================
+struct Quote
+{
+    std::string symbol;
+    double      price;
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct Routing<Quote> :
+            RoutedBy<std::string>
+        {
+            static std::string const &key(Quote const &_event)
+            {
+                return _event.symbol;
+            }
+        };
+    }
+}
+
+
+//==============================================================================================================================
+void on_quote(Quote const &_event)
+{
+    std::cout << "tape: " << _event.symbol << " " << _event.price << std::endl;
+}
+
+
+//==============================================================================================================================
+void on_apple(Quote const &_event)
+{
+    std::cout << "apple desk: " << _event.price << std::endl;
+}
+
+
+//==============================================================================================================================
+void on_alert(Quote const &_event)
+{
+    std::cout << "alert: " << _event.symbol << " " << _event.price << std::endl;
+}
+
+
+//==============================================================================================================================
+int main()
+{
+    using namespace cws::events;
+
+    Dispatcher<Quote> dispatcher;
+
+    dispatcher.add_listener<Quote>(on_quote);
+    dispatcher.add_listener<Quote>(topic("AAPL"), on_apple);
+    dispatcher.add_listener<Quote>(topic("MSFT"), on_alert, Order::FRONT);
+
+    dispatcher.dispatch(Quote{ "AAPL", 189.5 });
+    dispatcher.dispatch(Quote{ "MSFT", 410.25 });
+    dispatcher.dispatch(Quote{ "IBM", 172 });
+
+    dispatcher.remove_listener<Quote>(topic("AAPL"), on_apple);
+
+    dispatcher.dispatch(Quote{ "AAPL", 190 });
+
+    return 0;
+}
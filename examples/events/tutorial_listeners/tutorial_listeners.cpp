@@ -26,10 +26,10 @@ int main()
     cws::events::Dispatcher<HelloWorldEvent> dispatcher;
     EventsListener                           listener;
 
-    dispatcher.add_listener<HelloWorldEvent>(boost::bind(&EventsListener::hello_world, &listener, _1));
+    dispatcher.add_listener<HelloWorldEvent>(&EventsListener::hello_world, &listener);
     dispatcher.dispatch(HelloWorldEvent());
 
-    dispatcher.remove_listener<HelloWorldEvent>(boost::bind(&EventsListener::hello_world, &listener, _1));
+    dispatcher.remove_listener<HelloWorldEvent>(&EventsListener::hello_world, &listener);
     dispatcher.dispatch(HelloWorldEvent());
 
     return 0;
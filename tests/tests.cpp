@@ -391,6 +391,475 @@ TEST_CASE("Multiple events", "")
 }
 
 
+//==============================================================================================================================
+TEST_CASE("Events without listeners", "")
+{
+    cws::events::Dispatcher<EventA, EventB> dispatcher0;
+    FlatDispatcher                          dispatcher1;
+
+    auto listener = std::make_shared<Listener>();
+
+    dispatcher0.dispatch(EventA());
+    dispatcher0.dispatch(EventB());
+    dispatcher0.remove_listener<EventA>(&Listener::on_event_a, listener);
+    dispatcher0.remove_listeners<EventB>(0);
+    dispatcher0.remove_listeners();
+
+    dispatcher1.dispatch(EventA());
+    dispatcher1.dispatch(EventB());
+    dispatcher1.remove_listener<EventA>(&Listener::on_event_a, listener);
+    dispatcher1.remove_listeners<EventB>(0);
+    dispatcher1.remove_listeners();
+
+    REQUIRE(listener->occured_event_a_index() == 0);
+    REQUIRE(listener->occured_event_b_index() == 0);
+
+
+    dispatcher0.add_listener<EventB>(&Listener::on_event_b, listener);
+    dispatcher1.add_listener<EventB>(&Listener::on_event_b, listener);
+
+    cws::events::Dispatcher<EventA, EventB> movedDispatcher0(std::move(dispatcher0));
+    FlatDispatcher                          movedDispatcher1(std::move(dispatcher1));
+
+    dispatcher0.dispatch(EventB());
+    dispatcher1.dispatch(EventB());
+
+    REQUIRE(listener->occured_event_b_index() == 0);
+
+    movedDispatcher0.dispatch(EventA());
+    movedDispatcher0.dispatch(EventB());
+
+    REQUIRE(listener->occured_event_a_index() == 0);
+    REQUIRE(listener->occured_event_b_index() == 1);
+
+    movedDispatcher1.dispatch(EventA());
+    movedDispatcher1.dispatch(EventB());
+
+    REQUIRE(listener->occured_event_a_index() == 0);
+    REQUIRE(listener->occured_event_b_index() == 2);
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Flat backend priority", "")
+{
+    reset();
+
+    FlatDispatcher dispatcher;
+    Listener       listener0;
+    Listener       listener1;
+    auto           sharedListener0 = std::make_shared<Listener>();
+    auto           sharedListener1 = std::make_shared<Listener>();
+
+    dispatcher.add_listener<EventA>(on_event);
+    dispatcher.add_listener<EventA>(0, boost::bind(&Listener::on_event_a, &listener0, _1));
+    dispatcher.add_listener<EventA>(0, boost::bind(&Listener::on_event_a, &listener1, _1), cws::events::Order::FRONT);
+    dispatcher.add_listener<EventA>(1, &Listener::on_event_a, sharedListener0);
+    dispatcher.add_listener<EventA>(&Listener::on_event_a, sharedListener1, cws::events::Order::FRONT);
+
+    dispatcher.dispatch(EventA());
+
+    REQUIRE(sharedListener1->occured_event_a_index() == 1);
+    REQUIRE(listener1.occured_event_a_index       () == 2);
+    REQUIRE(listener0.occured_event_a_index       () == 3);
+    REQUIRE(sharedListener0->occured_event_a_index() == 4);
+    REQUIRE(occured_event_index                   () == 5);
+
+
+    reset();
+    listener0.reset();
+    listener1.reset();
+    sharedListener0->reset();
+    sharedListener1->reset();
+
+    dispatcher.remove_listeners<EventA>(0);
+    dispatcher.add_listener<EventA>(on_event, cws::events::Order::FRONT);
+
+    dispatcher.dispatch(EventA());
+
+    REQUIRE(listener0.occured_event_a_index       () == 0);
+    REQUIRE(listener1.occured_event_a_index       () == 0);
+    REQUIRE(occured_event_index                   () == 1);
+    REQUIRE(sharedListener1->occured_event_a_index() == 2);
+    REQUIRE(sharedListener0->occured_event_a_index() == 3);
+
+
+    reset();
+    sharedListener0->reset();
+    sharedListener1->reset();
+
+    dispatcher.remove_listener<EventA>(on_event);
+    dispatcher.remove_listener<EventA>(&Listener::on_event_a, sharedListener1);
+    sharedListener0.reset();
+
+    dispatcher.dispatch(EventA());
+
+    REQUIRE(occured_event_index                   () == 0);
+    REQUIRE(sharedListener1->occured_event_a_index() == 0);
+
+
+    dispatcher.remove_listeners();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Flat backend subscribing while dispatching", "")
+{
+    reset();
+
+    FlatDispatcher dispatcher;
+    Listener       listener;
+    Subscriber     subscriber(dispatcher, listener);
+
+    dispatcher.add_listener<EventA>(on_event);
+    dispatcher.add_listener<EventB>(subscriber, cws::events::Order::FRONT);
+    dispatcher.add_listener<EventB>(boost::bind(&Listener::on_event_b, &listener, _1));
+
+    dispatcher.dispatch(EventB());
+
+    REQUIRE(occured_event_index             () == 0);
+    REQUIRE(listener.occured_event_a_index  () == 1);
+    REQUIRE(listener.occured_event_b_index  () == 1);
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Connections", "")
+{
+    reset();
+
+    check_connections<cws::events::Dispatcher<EventA, EventB>>();
+    check_connections<FlatDispatcher>();
+    check_connections<SnapshotDispatcher>();
+
+    check_foreign_connections<FlatDispatcher>();
+    check_foreign_connections<SnapshotDispatcher>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Scoped listener", "")
+{
+    check_scoped_listener<cws::events::Dispatcher<EventA, EventB>>();
+    check_scoped_listener<FlatDispatcher>();
+    check_scoped_listener<SnapshotDispatcher>();
+
+    check_scoped_listener_throwing<cws::events::backend::Signals2>();
+    check_scoped_listener_throwing<cws::events::backend::Flat    >();
+    check_scoped_listener_throwing<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Concurrent dispatching", "")
+{
+    typedef cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                          cws::events::TypesList<EventA, EventB>>::type  LockingDispatcher;
+
+    typedef cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                          cws::events::BackendType<cws::events::backend::Flat>,
+                                          cws::events::TypesList<EventA, EventB>>::type  LockingFlatDispatcher;
+
+    typedef cws::events::dispatcher::Type<cws::events::MutexType<std::shared_timed_mutex>,
+                                          cws::events::BackendType<cws::events::backend::Flat>,
+                                          cws::events::TypesList<EventA, EventB>>::type  SharedLockingFlatDispatcher;
+
+    REQUIRE( cws::events::dispatcher::IsSharedLockable<std::shared_timed_mutex      >::value);
+    REQUIRE(!cws::events::dispatcher::IsSharedLockable<std::mutex                   >::value);
+    REQUIRE(!cws::events::dispatcher::IsSharedLockable<boost::signals2::dummy_mutex>::value);
+
+    check_concurrent_dispatching<LockingDispatcher>();
+    check_concurrent_dispatching<LockingFlatDispatcher>();
+    check_concurrent_dispatching<SharedLockingFlatDispatcher>();
+    check_concurrent_dispatching<SnapshotDispatcher>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Deferred dispatching", "")
+{
+    check_queue<cws::events::backend::Signals2>();
+    check_queue<cws::events::backend::Flat    >();
+    check_queue<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Coalescing", "")
+{
+    check_coalescing<cws::events::backend::Signals2>();
+    check_coalescing<cws::events::backend::Flat    >();
+    check_coalescing<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Topics", "")
+{
+    check_topics<cws::events::backend::Signals2>();
+    check_topics<cws::events::backend::Flat    >();
+    check_topics<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Event hierarchy", "")
+{
+    check_hierarchy<cws::events::backend::Signals2>();
+    check_hierarchy<cws::events::backend::Flat    >();
+    check_hierarchy<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Asynchronous dispatching", "")
+{
+    check_async<cws::events::backend::Signals2>();
+    check_async<cws::events::backend::Flat    >();
+    check_async<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Parallel dispatching", "")
+{
+    check_parallel<cws::events::backend::Signals2>();
+    check_parallel<cws::events::backend::Flat    >();
+    check_parallel<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Batch dispatching", "")
+{
+    check_batch<cws::events::backend::Signals2>();
+    check_batch<cws::events::backend::Flat    >();
+    check_batch<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Event copies", "")
+{
+    check_copies<cws::events::backend::Signals2>();
+    check_copies<cws::events::backend::Flat    >();
+    check_copies<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Lazy dispatching", "")
+{
+    check_lazy<cws::events::backend::Signals2>();
+    check_lazy<cws::events::backend::Flat    >();
+    check_lazy<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Delegates", "")
+{
+    check_delegates<cws::events::backend::Signals2>();
+    check_delegates<cws::events::backend::Flat    >();
+    check_delegates<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Move-only listeners", "")
+{
+    check_move_only<cws::events::backend::Signals2>();
+    check_move_only<cws::events::backend::Flat    >();
+    check_move_only<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Listener storage", "")
+{
+    using namespace cws::events;
+
+    typedef AllocatorType<CountingAllocator<char>>  allocator_t;
+
+    typedef dispatcher::Type<BackendType<backend::Flat>, allocator_t, TypesList<NumberedEvent>>::type                   narrow_t;
+    typedef dispatcher::Type<BackendType<backend::Flat>, allocator_t, StorageType<64>, TypesList<NumberedEvent>>::type  wide_t;
+
+    static_assert(narrow_t::storage_size == 4 * sizeof(void *), "The default storage size is four pointers.");
+    static_assert(wide_t::storage_size   == 64,                 "The storage size is specified by StorageType.");
+
+    auto const copyable = [](size_t &_sum)
+    {
+        std::array<size_t, 5> const state = { { 1, 2, 3, 4, 5 } };
+
+        return [state, &_sum](NumberedEvent const &_event) { _sum += _event.number * state[0]; };
+    };
+
+    auto const moveOnly = [](size_t &_sum)
+    {
+        std::unique_ptr<size_t> one(new size_t(1));
+
+        return [one = std::move(one), &_sum](NumberedEvent const &_event) { _sum += _event.number * *one; };
+    };
+
+    REQUIRE(count_subscribing_allocations<wide_t  >(copyable) == 0);
+    REQUIRE(count_subscribing_allocations<narrow_t>(copyable) == 8);
+
+    // 
+    // Move-only listeners are allocated whatever their size, since arrays of listeners can be copied.
+    // 
+    REQUIRE(count_subscribing_allocations<wide_t  >(moveOnly) == 8);
+
+    typedef dispatcher::Type<MutexType<std::mutex>, BackendType<backend::Snapshot>,
+                             TypesList<NumberedEvent>>::type  snapshot_t;
+
+    snapshot_t dispatcher;
+    size_t     copies = 0;
+
+    dispatcher.connect<NumberedEvent>(LargeListener(&copies));
+
+    REQUIRE(copies == 0);
+
+    for (size_t i = 0; i != 4; ++i)
+        dispatcher.connect<NumberedEvent>([](NumberedEvent const &) {});
+
+    dispatcher.dispatch(NumberedEvent{ 1 });
+
+    REQUIRE(copies == 0);
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Priority range", "")
+{
+    check_priority_range<cws::events::backend::Signals2>();
+    check_priority_range<cws::events::backend::Flat    >();
+    check_priority_range<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Stats", "")
+{
+    check_stats<cws::events::backend::Signals2>();
+    check_stats<cws::events::backend::Flat    >();
+    check_stats<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Histogram quantiles", "")
+{
+    using cws::events::stats::Histogram;
+
+    Histogram latency = {};
+
+    REQUIRE(latency.quantile(0.5) == 0);
+
+    // 
+    // 98 durations of 1 ns, then 10 ns, and 1000 ns as the maximum.
+    // 
+    latency.counts[Histogram::bucket(1)]    = 98;
+    latency.counts[Histogram::bucket(10)]   = 1;
+    latency.counts[Histogram::bucket(1000)] = 1;
+
+    REQUIRE(latency.quantile(0)    == 1);
+    REQUIRE(latency.quantile(0.5)  == 1);
+    REQUIRE(latency.quantile(0.98) == 1);
+    REQUIRE(latency.quantile(0.99) == Histogram::lower_bound(Histogram::bucket(10)));
+    REQUIRE(latency.quantile(1)    == Histogram::lower_bound(Histogram::bucket(1000)));
+
+    latency = {};
+
+    for (std::uint64_t i = 0; i != 100; ++i)
+        ++latency.counts[i];
+
+    REQUIRE(latency.quantile(0.07) == Histogram::lower_bound(6));
+    REQUIRE(latency.quantile(0.99) == Histogram::lower_bound(98));
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Top listeners", "")
+{
+    check_top_listeners<cws::events::backend::Signals2>();
+    check_top_listeners<cws::events::backend::Flat    >();
+    check_top_listeners<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Channel", "")
+{
+    check_channel<cws::events::backend::Signals2>();
+    check_channel<cws::events::backend::Flat    >();
+    check_channel<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Single producer channel", "")
+{
+    check_single_producer_channel<cws::events::backend::Signals2>();
+    check_single_producer_channel<cws::events::backend::Flat    >();
+    check_single_producer_channel<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Allocator", "")
+{
+    check_allocator<cws::events::backend::Signals2>();
+    check_allocator<cws::events::backend::Flat    >();
+    check_allocator<cws::events::backend::Snapshot>();
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Static dispatcher", "")
+{
+    using namespace cws::events;
+
+    typedef static_listener::Function<void (*)(NumberedEvent const &), &on_static_event<1>, 1>  first_t;
+    typedef static_listener::Function<void (*)(NumberedEvent const &), &on_static_event<2>, 0>  second_t;
+    typedef static_listener::Function<void (*)(NumberedEvent const &), &on_static_event<3>, 1>  third_t;
+    typedef static_listener::Functor<StaticFunctor, -1>                                          functor_t;
+    typedef static_listener::Method<StaticObject, void (StaticObject::*)(NumberedEvent const &), &StaticObject::on_event,
+                                    &g_staticObject, 2>  method_t;
+
+    StaticDispatcher<TypesList<NumberedEvent, EventA, EventB>, first_t, second_t, third_t, functor_t, method_t>  dispatcher;
+
+    REQUIRE( dispatcher.has_listeners<NumberedEvent>());
+    REQUIRE( dispatcher.has_listeners<EventA>());
+    REQUIRE(!dispatcher.has_listeners<EventB>());
+
+    g_staticNumbers.clear();
+
+    dispatcher.dispatch(NumberedEvent{ 5 });
+    dispatcher.dispatch(EventA());
+    dispatcher.dispatch(EventB());
+
+    REQUIRE(g_staticNumbers == std::vector<size_t>({ 905, 205, 105, 305, 805, 0 }));
+
+    g_staticNumbers.clear();
+
+    StaticDispatcher<PriorityType<int, std::greater<int>>, TypesList<NumberedEvent>, first_t, second_t, third_t, functor_t,
+                     method_t>  reversedDispatcher;
+
+    REQUIRE_THROWS_AS(reversedDispatcher.dispatch(NumberedEvent{ 0 }), size_t);
+    REQUIRE(g_staticNumbers == std::vector<size_t>({ 800 }));
+
+    g_staticNumbers.clear();
+
+    StaticDispatcher<TypesList<EventA>>  emptyDispatcher;
+
+    emptyDispatcher.dispatch(EventA());
+
+    REQUIRE(!emptyDispatcher.has_listeners<EventA>());
+    REQUIRE(std::is_empty<decltype(emptyDispatcher)>::value);
+    REQUIRE(g_staticNumbers.empty());
+}
+
+
 //==============================================================================================================================
 //==============================================================================================================================
 
@@ -402,6 +871,48 @@ TEST_CASE("Add listener example", "")
 }
 
 
+//==============================================================================================================================
+TEST_CASE("Allocator type example", "")
+{
+    do_app_test("example_allocator_type");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Backend type example", "")
+{
+    do_app_test("example_backend_type");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Channel example", "")
+{
+    do_app_test("example_channel");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Coalescing example", "")
+{
+    do_app_test("example_coalescing");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Connect example", "")
+{
+    do_app_test("example_connect");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Delegate example", "")
+{
+    do_app_test("example_delegate");
+}
+
+
 //==============================================================================================================================
 TEST_CASE("Dispatch example", "")
 {
@@ -409,6 +920,34 @@ TEST_CASE("Dispatch example", "")
 }
 
 
+//==============================================================================================================================
+TEST_CASE("Dispatch batch example", "")
+{
+    do_app_test("example_dispatch_batch");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Dispatch lazy example", "")
+{
+    do_app_test("example_dispatch_lazy");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Dispatch async example", "")
+{
+    do_app_test("example_dispatch_async");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Dispatch parallel example", "")
+{
+    do_app_test("example_dispatch_parallel");
+}
+
+
 //==============================================================================================================================
 TEST_CASE("Dispatcher type example", "")
 {
@@ -423,6 +962,20 @@ TEST_CASE("Dispatcher move and assignment", "")
 }
 
 
+//==============================================================================================================================
+TEST_CASE("Enqueue example", "")
+{
+    do_app_test("example_enqueue");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Hierarchy example", "")
+{
+    do_app_test("example_hierarchy");
+}
+
+
 //==============================================================================================================================
 TEST_CASE("Order example", "")
 {
@@ -430,6 +983,13 @@ TEST_CASE("Order example", "")
 }
 
 
+//==============================================================================================================================
+TEST_CASE("Priority range example", "")
+{
+    do_app_test("example_priority_range");
+}
+
+
 //==============================================================================================================================
 TEST_CASE("Priority type example", "")
 {
@@ -450,6 +1010,20 @@ TEST_CASE("Remove listeners example", "")
     do_app_test("example_remove_listeners");
 }
 
+//==============================================================================================================================
+TEST_CASE("Scoped listener example", "")
+{
+    do_app_test("example_scoped_listener");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Static dispatcher example", "")
+{
+    do_app_test("example_static_dispatcher");
+}
+
+
 //==============================================================================================================================
 TEST_CASE("STD swap example", "")
 {
@@ -457,6 +1031,20 @@ TEST_CASE("STD swap example", "")
 }
 
 
+//==============================================================================================================================
+TEST_CASE("Stats type example", "")
+{
+    do_app_test("example_stats_type");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Storage type example", "")
+{
+    do_app_test("example_storage_type");
+}
+
+
 //==============================================================================================================================
 TEST_CASE("Swap example", "")
 {
@@ -464,6 +1052,20 @@ TEST_CASE("Swap example", "")
 }
 
 
+//==============================================================================================================================
+TEST_CASE("Top listeners example", "")
+{
+    do_app_test("example_top_listeners");
+}
+
+
+//==============================================================================================================================
+TEST_CASE("Topics example", "")
+{
+    do_app_test("example_topics");
+}
+
+
 //==============================================================================================================================
 TEST_CASE("types list example", "")
 {
@@ -1,6 +1,20 @@
 #pragma once
 
 
+//==============================================================================================================================
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+
 //==============================================================================================================================
 #include <cws/events.hpp>
 #include <catch2/catch.hpp>
@@ -90,6 +104,41 @@ public:
 };
 
 
+//==============================================================================================================================
+typedef cws::events::dispatcher::Type<cws::events::BackendType<cws::events::backend::Flat>,
+                                      cws::events::TypesList<EventA, EventB>>::type  FlatDispatcher;
+
+typedef cws::events::dispatcher::Type<cws::events::MutexType<std::mutex>,
+                                      cws::events::BackendType<cws::events::backend::Snapshot>,
+                                      cws::events::TypesList<EventA, EventB>>::type  SnapshotDispatcher;
+
+
+//==============================================================================================================================
+class Subscriber
+{
+public:
+    //==========================================================================================================================
+    Subscriber(FlatDispatcher &_dispatcher, Listener &_listener)
+        : dispatcher_(&_dispatcher)
+        , listener_  (&_listener)
+    {
+    }
+
+    //==========================================================================================================================
+    void operator()(EventB const &);
+
+    //==========================================================================================================================
+    bool operator==(Subscriber const &_other) const
+    {
+        return dispatcher_ == _other.dispatcher_ && listener_ == _other.listener_;
+    }
+
+private:
+    FlatDispatcher *dispatcher_;
+    Listener       *listener_;
+};
+
+
 //==============================================================================================================================
 void on_event(EventA const &)
 {
@@ -110,3 +159,2180 @@ size_t occured_event_index()
 {
     return g_occuredEventIndex;
 }
+
+
+//==============================================================================================================================
+void Subscriber::operator()(EventB const &)
+{
+    dispatcher_->remove_listener<EventA>(on_event);
+    dispatcher_->add_listener<EventA>(boost::bind(&Listener::on_event_a, listener_, _1));
+    dispatcher_->dispatch(EventA());
+}
+
+
+//==============================================================================================================================
+template <typename _Dispatcher>
+void check_connections()
+{
+    _Dispatcher dispatcher;
+    size_t      count = 0;
+    auto        count_event = [&count](EventA const &) { ++count; };
+
+    auto first  = dispatcher.template connect<EventA>(count_event);
+    auto second = dispatcher.template connect<EventA>(count_event);
+
+    dispatcher.dispatch(EventA());
+
+    REQUIRE(count == 2);
+
+    dispatcher.template remove_listener<EventA>(first);
+    dispatcher.template remove_listener<EventA>(first);
+    dispatcher.dispatch(EventA());
+
+    REQUIRE(count == 3);
+
+    dispatcher.remove_listeners();
+
+    auto third = dispatcher.template add_listener<EventA>(on_event);
+
+    dispatcher.template remove_listener<EventA>(second);
+    dispatcher.dispatch(EventA());
+
+    REQUIRE(count == 3);
+    REQUIRE(occured_event_index() != 0);
+
+
+    reset();
+
+    std::vector<typename _Dispatcher::connection_t> connections;
+
+    for (int i = 0; i < 100; ++i)
+        connections.push_back(dispatcher.template connect<EventA>(i, count_event));
+
+    for (size_t i = 0; i < connections.size(); i += 2)
+        dispatcher.template remove_listener<EventA>(connections[i]);
+
+    dispatcher.template remove_listener<EventA>(third);
+    dispatcher.dispatch(EventA());
+
+    REQUIRE(count == 53);
+    REQUIRE(occured_event_index() == 0);
+
+    for (size_t i = 1; i < connections.size(); i += 2)
+        dispatcher.template remove_listener<EventA>(connections[i]);
+
+    dispatcher.dispatch(EventA());
+
+    REQUIRE(count == 53);
+}
+
+
+//==============================================================================================================================
+// 
+// Checks that connections of flat backends remove nothing when passed with another event or to another dispatcher.
+// 
+template <typename _Dispatcher>
+void check_foreign_connections()
+{
+    _Dispatcher dispatcher;
+    _Dispatcher other;
+    size_t      count = 0;
+
+    auto const connection = dispatcher.template connect<EventA>([&count](EventA const &) { ++count; });
+
+    dispatcher.template connect<EventB>([&count](EventB const &) { count += 10; });
+    other.template connect<EventA>([&count](EventA const &) { count += 100; });
+
+    dispatcher.template remove_listener<EventB>(connection);
+    other.template remove_listener<EventA>(connection);
+    dispatcher.template remove_listener<EventA>(typename _Dispatcher::connection_t());
+
+    dispatcher.dispatch(EventA());
+    dispatcher.dispatch(EventB());
+    other.dispatch(EventA());
+
+    REQUIRE(count == 111);
+
+    _Dispatcher moved(std::move(dispatcher));
+
+    dispatcher.template connect<EventA>([&count](EventA const &) { count += 1000; });
+    dispatcher.template remove_listener<EventA>(connection);
+    moved.template remove_listener<EventA>(connection);
+
+    dispatcher.dispatch(EventA());
+    moved.dispatch(EventA());
+
+    REQUIRE(count == 1111);
+}
+
+
+//==============================================================================================================================
+template <typename _Dispatcher>
+void check_scoped_listener()
+{
+    _Dispatcher dispatcher;
+    Listener    listener;
+    size_t      count = 0;
+
+    dispatcher.template add_listener<EventB>(boost::bind(&Listener::on_event_b, &listener, _1));
+
+    {
+        cws::events::ScopedListener<_Dispatcher> scopedListener(dispatcher);
+
+        scopedListener.template add_listener<EventA>([&count](EventA const &) { ++count; });
+        scopedListener.template add_listener<EventB>(0, [&count](EventB const &) { ++count; });
+
+        dispatcher.dispatch(EventA());
+        dispatcher.dispatch(EventB());
+
+        REQUIRE(count == 2);
+        REQUIRE(listener.occured_event_b_index() == 1);
+
+        cws::events::ScopedListener<_Dispatcher> movedScopedListener(std::move(scopedListener));
+
+        scopedListener.remove_listeners();
+
+        dispatcher.dispatch(EventA());
+
+        REQUIRE(count == 3);
+
+        movedScopedListener.remove_listeners();
+        movedScopedListener.template add_listener<EventA>([&count](EventA const &) { count += 10; });
+
+        dispatcher.dispatch(EventA());
+        dispatcher.dispatch(EventB());
+
+        REQUIRE(count == 13);
+        REQUIRE(listener.occured_event_b_index() == 2);
+    }
+
+    dispatcher.dispatch(EventA());
+    dispatcher.dispatch(EventB());
+
+    REQUIRE(count == 13);
+    REQUIRE(listener.occured_event_b_index() == 3);
+}
+
+
+//==============================================================================================================================
+// 
+// Mutex whose locking throws once armed.
+// 
+bool g_mutexArmed = false;
+
+struct ThrowingMutex
+{
+    void lock()
+    {
+        if (g_mutexArmed)
+        {
+            g_mutexArmed = false;
+            throw std::runtime_error("The mutex cannot be locked.");
+        }
+
+        mutex.lock();
+    }
+
+    bool try_lock()
+    {
+        return mutex.try_lock();
+    }
+
+    void unlock()
+    {
+        mutex.unlock();
+    }
+
+    std::mutex mutex;
+};
+
+
+//==============================================================================================================================
+// 
+// Checks that ScopedListener unsubscribes all its listeners when unsubscribing one of them throws.
+// 
+template <typename _Backend>
+void check_scoped_listener_throwing()
+{
+    typedef typename cws::events::dispatcher::Type<cws::events::MutexType<ThrowingMutex>,
+                                                   cws::events::BackendType<_Backend>,
+                                                   cws::events::TypesList<EventA, EventB>>::type  dispatcher_t;
+
+    dispatcher_t dispatcher;
+    size_t       count = 0;
+
+    {
+        cws::events::ScopedListener<dispatcher_t> scopedListener(dispatcher);
+
+        scopedListener.template add_listener<EventA>([&count](EventA const &) { ++count; });
+        scopedListener.template add_listener<EventB>([&count](EventB const &) { count += 10; });
+
+        g_mutexArmed = true;
+
+        REQUIRE_THROWS_AS(scopedListener.remove_listeners(), std::runtime_error const &);
+
+        dispatcher.dispatch(EventA());
+        dispatcher.dispatch(EventB());
+
+        REQUIRE(count == 1);
+
+        scopedListener.template add_listener<EventB>([&count](EventB const &) { count += 100; });
+
+        cws::events::ScopedListener<dispatcher_t> other(dispatcher);
+
+        other.template add_listener<EventA>([&count](EventA const &) { count += 1000; });
+
+        g_mutexArmed = true;
+
+        REQUIRE_THROWS_AS(other = std::move(scopedListener), std::runtime_error const &);
+
+        dispatcher.dispatch(EventB());
+
+        REQUIRE(count == 101);
+
+        other.template add_listener<EventA>([&count](EventA const &) { count += 10000; });
+
+        g_mutexArmed = true;
+    }
+
+    REQUIRE(!g_mutexArmed);
+
+    // 
+    // Listeners whose unsubscribing threw stay subscribed, others are unsubscribed.
+    // 
+    dispatcher.dispatch(EventA());
+    dispatcher.dispatch(EventB());
+
+    REQUIRE(count == 101 + 1001 + 100);
+}
+
+
+//==============================================================================================================================
+template <typename _Dispatcher>
+void check_concurrent_dispatching()
+{
+    size_t const THREADS_COUNT    = 4;
+    size_t const DISPATCHES_COUNT = 10000;
+
+    _Dispatcher              dispatcher;
+    std::atomic<size_t>      permanentCount(0);
+    std::atomic<size_t>      transientCount(0);
+    std::atomic<bool>        dispatching(true);
+    std::vector<std::thread> threads;
+
+    dispatcher.template connect<EventA>([&permanentCount](EventA const &) { ++permanentCount; });
+
+    std::thread writer([&dispatcher, &transientCount, &dispatching]()
+    {
+        std::vector<typename _Dispatcher::connection_t> connections;
+
+        while (dispatching)
+        {
+            for (int i = 0; i < 8; ++i)
+                connections.push_back(dispatcher.template connect<EventA>(i, [&transientCount](EventA const &)
+                {
+                    ++transientCount;
+                }));
+
+            for (auto const &connection : connections)
+                dispatcher.template remove_listener<EventA>(connection);
+
+            connections.clear();
+        }
+    });
+
+    for (size_t i = 0; i < THREADS_COUNT; ++i)
+    {
+        threads.emplace_back([&dispatcher]()
+        {
+            for (size_t j = 0; j < DISPATCHES_COUNT; ++j)
+                dispatcher.dispatch(EventA());
+        });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    dispatching = false;
+    writer.join();
+
+    REQUIRE(permanentCount == THREADS_COUNT * DISPATCHES_COUNT);
+
+    transientCount = 0;
+    dispatcher.dispatch(EventA());
+
+    REQUIRE(transientCount == 0);
+    REQUIRE(permanentCount == THREADS_COUNT * DISPATCHES_COUNT + 1);
+
+
+    threads.clear();
+
+    size_t enqueuedCount = 0;
+
+    dispatcher.template connect<EventB>([&enqueuedCount](EventB const &) { ++enqueuedCount; });
+
+    for (size_t i = 0; i < THREADS_COUNT; ++i)
+    {
+        threads.emplace_back([&dispatcher]()
+        {
+            for (size_t j = 0; j < DISPATCHES_COUNT; ++j)
+                dispatcher.enqueue(EventB());
+        });
+    }
+
+    size_t processedCount = 0;
+
+    while (processedCount != THREADS_COUNT * DISPATCHES_COUNT)
+        processedCount += dispatcher.process();
+
+    for (auto &thread : threads)
+        thread.join();
+
+    REQUIRE(enqueuedCount == THREADS_COUNT * DISPATCHES_COUNT);
+}
+
+
+//==============================================================================================================================
+struct NumberedEvent
+{
+    size_t number;
+};
+
+
+//==============================================================================================================================
+struct LargeEvent
+{
+    size_t number;
+    char   payload[5000];
+};
+
+
+//==============================================================================================================================
+// 
+// Counts its alive instances.
+// 
+struct CountedEvent
+{
+    CountedEvent()
+    {
+        ++aliveCount;
+    }
+
+    CountedEvent(CountedEvent const &)
+    {
+        ++aliveCount;
+    }
+
+    ~CountedEvent()
+    {
+        --aliveCount;
+    }
+
+    static int aliveCount;
+};
+
+int CountedEvent::aliveCount = 0;
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_queue()
+{
+    typedef typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>,
+                                                   cws::events::TypesList<NumberedEvent, LargeEvent,
+                                                                          CountedEvent>>::type  dispatcher_t;
+
+    std::vector<size_t> numbers;
+
+    {
+        dispatcher_t dispatcher;
+
+        dispatcher.template connect<NumberedEvent>([&numbers](NumberedEvent const &_event)
+        {
+            numbers.push_back(_event.number);
+        });
+
+        dispatcher.template connect<LargeEvent>([&numbers](LargeEvent const &_event)
+        {
+            numbers.push_back(_event.number);
+        });
+
+        REQUIRE(dispatcher.process() == 0);
+
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            if (i % 100 == 0)
+                dispatcher.enqueue(LargeEvent{ i, {} });
+            else
+                dispatcher.enqueue(NumberedEvent{ i });
+        }
+
+        REQUIRE(numbers.empty());
+        REQUIRE(dispatcher.process_for(std::chrono::seconds(0)) == 0);
+        REQUIRE(dispatcher.process() == 1000);
+        REQUIRE(numbers.size() == 1000);
+
+        for (size_t i = 0; i < numbers.size(); ++i)
+            REQUIRE(numbers[i] == i);
+
+
+        numbers.clear();
+
+        dispatcher.template connect<NumberedEvent>(0, [&dispatcher](NumberedEvent const &_event)
+        {
+            if (_event.number == 0)
+                dispatcher.enqueue(NumberedEvent{ 2 });
+            else if (_event.number == 1)
+                throw _event.number;
+        });
+
+        dispatcher.enqueue(NumberedEvent{ 0 });
+        dispatcher.enqueue(NumberedEvent{ 1 });
+        dispatcher.enqueue(CountedEvent());
+        dispatcher.enqueue(LargeEvent{ 3, {} });
+
+        REQUIRE_THROWS(dispatcher.process());
+        REQUIRE(numbers.size() == 1);
+        REQUIRE(CountedEvent::aliveCount == 1);
+
+        REQUIRE(dispatcher.process() == 3);
+        REQUIRE(numbers.size() == 3);
+        REQUIRE(numbers[1] == 3);
+        REQUIRE(numbers[2] == 2);
+        REQUIRE(CountedEvent::aliveCount == 0);
+
+        REQUIRE(dispatcher.process() == 0);
+
+        dispatcher.enqueue(CountedEvent());
+        dispatcher.enqueue(NumberedEvent{ 4 });
+
+        dispatcher_t movedDispatcher(std::move(dispatcher));
+
+        REQUIRE(dispatcher.process() == 0);
+        REQUIRE(CountedEvent::aliveCount == 1);
+
+        movedDispatcher.enqueue(CountedEvent());
+    }
+
+    REQUIRE(CountedEvent::aliveCount == 0);
+    REQUIRE(numbers.size() == 3);
+}
+
+
+//==============================================================================================================================
+// 
+// Position of an entity, where only the latest one matters.
+// 
+struct PositionEvent
+{
+    size_t entity;
+    int    x;
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct Coalescing<PositionEvent> :
+            CoalescedBy<size_t>
+        {
+            static size_t key(PositionEvent const &_event)
+            {
+                return _event.entity;
+            }
+        };
+    }
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_coalescing()
+{
+    typedef typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>,
+                                                   cws::events::TypesList<NumberedEvent, PositionEvent>>::type  dispatcher_t;
+
+    typedef std::vector<std::pair<size_t, int>>  positions_t;
+
+    positions_t         positions;
+    std::vector<size_t> numbers;
+
+    dispatcher_t dispatcher;
+
+    dispatcher.template connect<PositionEvent>([&positions, &dispatcher](PositionEvent const &_event)
+    {
+        positions.emplace_back(_event.entity, _event.x);
+
+        if (_event.x == 100)
+            dispatcher.enqueue(PositionEvent{ _event.entity, 200 });
+    });
+
+    dispatcher.template connect<NumberedEvent>([&numbers](NumberedEvent const &_event) { numbers.push_back(_event.number); });
+
+    for (int x = 0; x != 1000; ++x)
+    {
+        dispatcher.enqueue(PositionEvent{ 1, x });
+        dispatcher.template emplace<PositionEvent>(size_t(2), -x);
+
+        if (x % 250 == 0)
+            dispatcher.enqueue(NumberedEvent{ static_cast<size_t>(x) });
+    }
+
+    REQUIRE(dispatcher.process() == 6);
+    REQUIRE(positions == positions_t({ { 1, 999 }, { 2, -999 } }));
+    REQUIRE(numbers == std::vector<size_t>({ 0, 250, 500, 750 }));
+
+    positions.clear();
+
+    dispatcher.enqueue(PositionEvent{ 1, 1 });
+    dispatcher.enqueue(PositionEvent{ 1, 100 });
+
+    REQUIRE(dispatcher.process() == 1);
+    REQUIRE(dispatcher.process() == 1);
+    REQUIRE(positions == positions_t({ { 1, 100 }, { 1, 200 } }));
+
+    positions.clear();
+
+    dispatcher.enqueue(PositionEvent{ 3, 1 });
+    dispatcher.enqueue(PositionEvent{ 3, 2 });
+
+    dispatcher_t movedDispatcher(std::move(dispatcher));
+
+    movedDispatcher.enqueue(PositionEvent{ 3, 3 });
+
+    REQUIRE(dispatcher.process() == 0);
+    REQUIRE(movedDispatcher.process() == 1);
+    REQUIRE(positions == positions_t({ { 3, 3 } }));
+}
+
+
+//==============================================================================================================================
+// 
+// Event of a topic, whose listeners are subscribed to topics by their numbers.
+// 
+struct TopicEvent
+{
+    int    topic;
+    size_t number;
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct Routing<TopicEvent> :
+            RoutedBy<int>
+        {
+            static int key(TopicEvent const &_event)
+            {
+                return _event.topic;
+            }
+        };
+    }
+}
+
+
+//==============================================================================================================================
+struct TopicListener
+{
+    void on_event(TopicEvent const &_event)
+    {
+        numbers.push_back(_event.number);
+    }
+
+    std::vector<size_t> numbers;
+};
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_topics()
+{
+    using namespace cws::events;
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, TypesList<TopicEvent>>::type  dispatcher_t;
+
+    typedef std::vector<std::string>  log_t;
+
+    log_t        log;
+    dispatcher_t dispatcher;
+
+    dispatcher.template connect<TopicEvent>([&log](TopicEvent const &) { log.push_back("all"); });
+    dispatcher.template connect<TopicEvent>(topic(1), [&log](TopicEvent const &) { log.push_back("one"); });
+    dispatcher.template connect<TopicEvent>(topic(1), [&log](TopicEvent const &) { log.push_back("first one"); }, Order::FRONT);
+    dispatcher.template connect<TopicEvent>(topic(2), 0, [&log](TopicEvent const &) { log.push_back("two"); });
+    dispatcher.template connect<TopicEvent>(0, [&log](TopicEvent const &) { log.push_back("priority"); });
+
+    typename dispatcher_t::connection_t const connection =
+        dispatcher.template connect<TopicEvent>(topic(2), 1, [&log](TopicEvent const &) { log.push_back("late two"); });
+
+    dispatcher.dispatch(TopicEvent{ 1, 0 });
+    dispatcher.dispatch(TopicEvent{ 2, 0 });
+    dispatcher.dispatch(TopicEvent{ 3, 0 });
+
+    REQUIRE(log == log_t({ "first one", "priority", "all", "one",
+                           "two", "priority", "late two", "all",
+                           "priority", "all" }));
+
+    log.clear();
+
+    dispatcher.template remove_listener<TopicEvent>(connection);
+    dispatcher.dispatch(TopicEvent{ 2, 0 });
+
+    REQUIRE(log == log_t({ "two", "priority", "all" }));
+
+    dispatcher.remove_listeners();
+
+    typedef Delegate<TopicEvent>  delegate_t;
+
+    TopicListener    listener;
+    delegate_t const delegate(&TopicListener::on_event, &listener);
+
+    dispatcher.template add_listener<TopicEvent>(topic(5), delegate);
+    dispatcher.template add_listener<TopicEvent>(topic(5), delegate);
+    dispatcher.template add_listener<TopicEvent>(topic(6), delegate);
+    dispatcher.template add_listener<TopicEvent>(delegate);
+
+    for (int number = 4; number != 8; ++number)
+        dispatcher.dispatch(TopicEvent{ number, static_cast<size_t>(number) });
+
+    REQUIRE(listener.numbers == std::vector<size_t>({ 4, 5, 5, 6, 6, 7 }));
+
+    listener.numbers.clear();
+
+    dispatcher.template remove_listener<TopicEvent>(topic(5), delegate);
+    dispatcher.template remove_listener<TopicEvent>(delegate);
+
+    dispatcher.dispatch(TopicEvent{ 5, 5 });
+    dispatcher.dispatch(TopicEvent{ 6, 6 });
+
+    REQUIRE(listener.numbers == std::vector<size_t>({ 6 }));
+
+    dispatcher.remove_listeners();
+
+    std::vector<size_t>                              counts(1000);
+    std::vector<typename dispatcher_t::connection_t> connections;
+
+    for (int number = 0; number != 1000; ++number)
+    {
+        connections.push_back(dispatcher.template connect<TopicEvent>(topic(number), [&counts](TopicEvent const &_event)
+        {
+            ++counts[static_cast<size_t>(_event.topic)];
+        }));
+    }
+
+    for (size_t i = 1; i < connections.size(); i += 2)
+        dispatcher.template remove_listener<TopicEvent>(connections[i]);
+
+    for (int number = 0; number != 1000; ++number)
+        dispatcher.dispatch(TopicEvent{ number, 0 });
+
+    std::vector<TopicEvent> const events = { { 10, 0 }, { 11, 0 }, { 12, 0 }, { 10, 0 } };
+
+    dispatcher.dispatch_batch(events.data(), events.data() + events.size());
+
+    for (size_t i = 0; i != counts.size(); ++i)
+        REQUIRE(counts[i] == (i % 2 != 0 ? 0 : i == 10 ? 3 : i == 12 ? 2 : 1));
+}
+
+
+//==============================================================================================================================
+// 
+// Hierarchy of events of a request. RequestAborted derives from RequestFailed and RequestStopped, which both derive from
+// RequestEvent virtually. RequestStopped is not dispatched by the dispatcher of the test.
+// 
+struct RequestEvent
+{
+    explicit RequestEvent(size_t _id)
+        : id(_id)
+    {
+    }
+
+    size_t id;
+};
+
+
+//==============================================================================================================================
+struct RequestFailed :
+    virtual RequestEvent
+{
+    explicit RequestFailed(size_t _id)
+        : RequestEvent(_id)
+    {
+    }
+};
+
+
+//==============================================================================================================================
+struct RequestCompleted :
+    RequestEvent
+{
+    explicit RequestCompleted(size_t _id)
+        : RequestEvent(_id)
+    {
+    }
+};
+
+
+//==============================================================================================================================
+struct RequestStopped :
+    virtual RequestEvent
+{
+    explicit RequestStopped(size_t _id)
+        : RequestEvent(_id)
+    {
+    }
+};
+
+
+//==============================================================================================================================
+struct RequestAborted :
+    RequestFailed,
+    RequestStopped
+{
+    explicit RequestAborted(size_t _id)
+        : RequestEvent  (_id)
+        , RequestFailed (_id)
+        , RequestStopped(_id)
+    {
+    }
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct Hierarchy<RequestFailed> :
+            DerivedFrom<RequestEvent>
+        {
+        };
+
+        template <>
+        struct Hierarchy<RequestCompleted> :
+            DerivedFrom<RequestEvent>
+        {
+        };
+
+        template <>
+        struct Hierarchy<RequestStopped> :
+            DerivedFrom<RequestEvent>
+        {
+        };
+
+        template <>
+        struct Hierarchy<RequestAborted> :
+            DerivedFrom<RequestFailed, RequestStopped>
+        {
+        };
+    }
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_hierarchy()
+{
+    using namespace cws::events;
+
+    static_assert(std::is_same<typename dispatcher::Lineage<RequestAborted, RequestEvent, RequestFailed, RequestStopped,
+                                                            RequestAborted>::type,
+                               TypesList<RequestAborted, RequestFailed, RequestStopped, RequestEvent>>::value,
+                  "Bases must follow all types derived from them.");
+
+    typedef typename dispatcher::Type<BackendType<_Backend>,
+                                      TypesList<RequestEvent, RequestFailed, RequestCompleted, RequestAborted>>::type
+        dispatcher_t;
+
+    typedef std::vector<std::string>  log_t;
+
+    log_t        log;
+    dispatcher_t dispatcher;
+
+    REQUIRE(!dispatcher.template has_listeners<RequestCompleted>());
+
+    dispatcher.template connect<RequestEvent>([&log](RequestEvent const &_event)
+    {
+        log.push_back("event " + std::to_string(_event.id));
+    });
+
+    REQUIRE(dispatcher.template has_listeners<RequestCompleted>());
+
+    dispatcher.template connect<RequestFailed>([&log](RequestFailed const &_event)
+    {
+        log.push_back("failed " + std::to_string(_event.id));
+    });
+
+    dispatcher.template connect<RequestAborted>([&log](RequestAborted const &_event)
+    {
+        log.push_back("aborted " + std::to_string(_event.id));
+    });
+
+    dispatcher.dispatch(RequestEvent(1));
+    dispatcher.dispatch(RequestCompleted(2));
+    dispatcher.dispatch(RequestFailed(3));
+    dispatcher.dispatch(RequestAborted(4));
+
+    REQUIRE(log == log_t({ "event 1", "event 2", "failed 3", "event 3", "aborted 4", "failed 4", "event 4" }));
+
+    log.clear();
+
+    dispatcher.enqueue(RequestAborted(5));
+    dispatcher.enqueue(RequestCompleted(6));
+
+    REQUIRE(dispatcher.process() == 2);
+    REQUIRE(log == log_t({ "aborted 5", "failed 5", "event 5", "event 6" }));
+
+    log.clear();
+
+    std::vector<RequestFailed> const events = { RequestFailed(7), RequestFailed(8) };
+
+    dispatcher.dispatch_batch(events.data(), events.data() + events.size());
+
+    REQUIRE(log == log_t({ "failed 7", "event 7", "failed 8", "event 8" }));
+
+    log.clear();
+
+    dispatcher.dispatch_parallel(RequestAborted(9));
+
+    REQUIRE(log == log_t({ "aborted 9", "failed 9", "event 9" }));
+
+    log.clear();
+
+    dispatcher.template connect<RequestFailed>([](RequestFailed const &_event) { throw _event.id; });
+
+    REQUIRE_THROWS_AS(dispatcher.dispatch(RequestAborted(10)), size_t);
+    REQUIRE(log == log_t({ "aborted 10", "failed 10" }));
+}
+
+
+//==============================================================================================================================
+// 
+// Stores submitted tasks and runs them on demand.
+// 
+struct DeferringExecutor
+{
+    template <typename _Task>
+    void execute(_Task &&_task)
+    {
+        tasks.emplace_back(std::forward<_Task>(_task));
+    }
+
+    void run()
+    {
+        for (cws::events::executor::Task &task : tasks)
+            task();
+
+        tasks.clear();
+    }
+
+    std::vector<cws::events::executor::Task> tasks;
+};
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_async()
+{
+    using namespace cws::events;
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, TypesList<NumberedEvent>>::type  inline_dispatcher_t;
+
+    typedef typename dispatcher::Type<MutexType<std::mutex>, BackendType<_Backend>, ExecutorType<executor::Pool>,
+                                      TypesList<NumberedEvent>>::type  pool_dispatcher_t;
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, ExecutorType<DeferringExecutor>,
+                                      TypesList<NumberedEvent>>::type  deferring_dispatcher_t;
+
+    {
+        inline_dispatcher_t dispatcher;
+
+        size_t sum = 0;
+
+        dispatcher.template connect<NumberedEvent>([&sum](NumberedEvent const &_event)
+        {
+            if (_event.number == 0)
+                throw _event.number;
+
+            sum += _event.number;
+        });
+
+        std::future<void> future = dispatcher.dispatch_async(NumberedEvent{ 1 });
+
+        REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        REQUIRE(sum == 1);
+
+        REQUIRE_THROWS(dispatcher.dispatch_async(NumberedEvent{ 0 }).get());
+    }
+
+    {
+        std::atomic<size_t> sum(0);
+        std::atomic<size_t> completions(0);
+        std::atomic<size_t> failures(0);
+
+        {
+            pool_dispatcher_t dispatcher;
+
+            dispatcher.template connect<NumberedEvent>([&sum](NumberedEvent const &_event)
+            {
+                if (_event.number % 10 == 0)
+                    throw _event.number;
+
+                sum += _event.number;
+            });
+
+            std::vector<std::future<void>> futures;
+
+            for (size_t i = 1; i <= 100; ++i)
+                futures.push_back(dispatcher.dispatch_async(NumberedEvent{ i }));
+
+            size_t errors = 0;
+
+            for (std::future<void> &future : futures)
+            {
+                try
+                {
+                    future.get();
+                }
+                catch (size_t)
+                {
+                    ++errors;
+                }
+            }
+
+            REQUIRE(errors == 10);
+            REQUIRE(sum == 4500);
+
+            for (size_t i = 1; i <= 100; ++i)
+            {
+                dispatcher.dispatch_async(NumberedEvent{ i }, [&completions, &failures](std::exception_ptr _error)
+                {
+                    ++(_error ? failures : completions);
+                });
+            }
+        }
+
+        REQUIRE(sum == 9000);
+        REQUIRE(completions == 90);
+        REQUIRE(failures == 10);
+    }
+
+    {
+        deferring_dispatcher_t dispatcher;
+
+        std::vector<size_t> numbers;
+
+        dispatcher.template connect<NumberedEvent>([&numbers](NumberedEvent const &_event)
+        {
+            numbers.push_back(_event.number);
+        });
+
+        std::future<void> future = dispatcher.dispatch_async(NumberedEvent{ 1 });
+
+        dispatcher.dispatch_async(NumberedEvent{ 2 }, [&numbers](std::exception_ptr)
+        {
+            numbers.push_back(0);
+        });
+
+        REQUIRE(dispatcher.executor().tasks.size() == 2);
+        REQUIRE(numbers.empty());
+        REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+        dispatcher.executor().run();
+
+        REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        REQUIRE(numbers == std::vector<size_t>({ 1, 2, 0 }));
+    }
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_parallel()
+{
+    using namespace cws::events;
+
+    typedef typename dispatcher::Type<MutexType<std::mutex>, BackendType<_Backend>, ExecutorType<executor::Pool>,
+                                      TypesList<NumberedEvent>>::type  pool_dispatcher_t;
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, ExecutorType<DeferringExecutor>,
+                                      TypesList<NumberedEvent>>::type  deferring_dispatcher_t;
+
+    size_t const LISTENERS_COUNT = 100;
+
+    {
+        pool_dispatcher_t dispatcher;
+
+        std::atomic<size_t> first (0);
+        std::atomic<size_t> second(0);
+        std::atomic<size_t> last  (0);
+
+        for (size_t i = 0; i != LISTENERS_COUNT; ++i)
+        {
+            dispatcher.template connect<NumberedEvent>(0, [&first](NumberedEvent const &_event)
+            {
+                first += _event.number;
+            });
+
+            dispatcher.template connect<NumberedEvent>(1, [&first, &second, LISTENERS_COUNT](NumberedEvent const &_event)
+            {
+                if (first != LISTENERS_COUNT * _event.number || _event.number == 2)
+                    throw _event.number;
+
+                ++second;
+            });
+        }
+
+        dispatcher.template connect<NumberedEvent>([&second, &last, LISTENERS_COUNT](NumberedEvent const &)
+        {
+            if (second == LISTENERS_COUNT)
+                ++last;
+        });
+
+        dispatcher.dispatch_parallel(NumberedEvent{ 1 });
+
+        REQUIRE(first  == LISTENERS_COUNT);
+        REQUIRE(second == LISTENERS_COUNT);
+        REQUIRE(last   == 1);
+
+        first  = 0;
+        second = 0;
+
+        dispatcher.dispatch_parallel(NumberedEvent{ 0 });
+
+        REQUIRE(first  == 0);
+        REQUIRE(second == LISTENERS_COUNT);
+        REQUIRE(last   == 2);
+
+        second = 0;
+
+        REQUIRE_THROWS_AS(dispatcher.dispatch_parallel(NumberedEvent{ 2 }), size_t);
+        REQUIRE(first  == LISTENERS_COUNT * 2);
+        REQUIRE(second == 0);
+        REQUIRE(last   == 2);
+    }
+
+    {
+        deferring_dispatcher_t dispatcher;
+
+        std::vector<size_t> numbers;
+
+        dispatcher.dispatch_parallel(NumberedEvent{ 0 });
+
+        for (size_t i = 0; i != LISTENERS_COUNT; ++i)
+        {
+            dispatcher.template connect<NumberedEvent>(int(i % 2), [&numbers, i](NumberedEvent const &)
+            {
+                numbers.push_back(i);
+            });
+        }
+
+        dispatcher.dispatch_parallel(NumberedEvent{ 0 });
+
+        REQUIRE(numbers.size() == LISTENERS_COUNT);
+
+        for (size_t i = 0; i != LISTENERS_COUNT; ++i)
+            REQUIRE(numbers[i] % 2 == (i < LISTENERS_COUNT / 2 ? 0 : 1));
+
+        dispatcher.executor().run();
+
+        REQUIRE(numbers.size() == LISTENERS_COUNT);
+    }
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_batch()
+{
+    using namespace cws::events;
+
+    typedef typename dispatcher::Type<BackendType<_Backend>,
+                                      TypesList<NumberedEvent, Batch<NumberedEvent>>>::type  batch_dispatcher_t;
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, TypesList<NumberedEvent>>::type  dispatcher_t;
+
+    std::vector<NumberedEvent> const events = { { 1 }, { 2 }, { 3 } };
+
+    {
+        batch_dispatcher_t dispatcher;
+
+        std::vector<size_t> numbers;
+
+        dispatcher.template connect<NumberedEvent>([&numbers](NumberedEvent const &_event)
+        {
+            numbers.push_back(_event.number);
+        });
+
+        dispatcher.template connect<NumberedEvent>([&numbers](NumberedEvent const &_event)
+        {
+            numbers.push_back(_event.number * 10);
+        });
+
+        dispatcher.template connect<Batch<NumberedEvent>>([&numbers](Batch<NumberedEvent> const &_batch)
+        {
+            numbers.push_back(_batch.size() * 100 + _batch[0].number);
+        });
+
+        dispatcher.dispatch_batch(events.data(), events.data() + events.size());
+
+        REQUIRE(numbers == std::vector<size_t>({ 1, 10, 2, 20, 3, 30, 301 }));
+
+        numbers.clear();
+
+        dispatcher.dispatch_batch(Batch<NumberedEvent>());
+        dispatcher.dispatch_batch(Batch<NumberedEvent>(events.data() + 1, events.data() + 2));
+
+        REQUIRE(numbers == std::vector<size_t>({ 2, 20, 102 }));
+
+        numbers.clear();
+
+        dispatcher.template connect<NumberedEvent>(0, [](NumberedEvent const &_event)
+        {
+            if (_event.number == 2)
+                throw _event.number;
+        });
+
+        REQUIRE_THROWS_AS(dispatcher.dispatch_batch(events.data(), events.data() + events.size()), size_t);
+        REQUIRE(numbers == std::vector<size_t>({ 1, 10 }));
+    }
+
+    {
+        dispatcher_t dispatcher;
+
+        size_t sum = 0;
+
+        dispatcher.dispatch_batch(events.data(), events.data() + events.size());
+
+        dispatcher.template connect<NumberedEvent>([&sum](NumberedEvent const &_event)
+        {
+            sum += _event.number;
+        });
+
+        dispatcher.dispatch_batch(events.data(), events.data() + events.size());
+
+        REQUIRE(sum == 6);
+    }
+}
+
+
+//==============================================================================================================================
+// 
+// Counts its copies and moves.
+// 
+struct CopiedEvent
+{
+    explicit CopiedEvent(size_t _number)
+        : number(_number)
+    {
+    }
+
+    CopiedEvent(CopiedEvent const &_source)
+        : number(_source.number)
+    {
+        ++copiesCount;
+    }
+
+    CopiedEvent(CopiedEvent &&_source) noexcept
+        : number(_source.number)
+    {
+        ++movesCount;
+    }
+
+    static void reset()
+    {
+        copiesCount = 0;
+        movesCount  = 0;
+    }
+
+    size_t number;
+
+    static int copiesCount;
+    static int movesCount;
+};
+
+int CopiedEvent::copiesCount = 0;
+int CopiedEvent::movesCount  = 0;
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_copies()
+{
+    typedef typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>,
+                                                   cws::events::TypesList<CopiedEvent>>::type  dispatcher_t;
+
+    dispatcher_t dispatcher;
+
+    size_t sum = 0;
+
+    for (size_t i = 0; i != 3; ++i)
+    {
+        dispatcher.template connect<CopiedEvent>([&sum](CopiedEvent const &_event)
+        {
+            sum += _event.number;
+        });
+    }
+
+    CopiedEvent::reset();
+
+    dispatcher.dispatch(CopiedEvent(1));
+
+    REQUIRE(sum == 3);
+    REQUIRE(CopiedEvent::copiesCount == 0);
+    REQUIRE(CopiedEvent::movesCount  == 0);
+
+    dispatcher.template emplace<CopiedEvent>(2);
+    dispatcher.enqueue(CopiedEvent(3));
+
+    REQUIRE(dispatcher.process() == 2);
+    REQUIRE(sum == 18);
+    REQUIRE(CopiedEvent::copiesCount == 0);
+    REQUIRE(CopiedEvent::movesCount  == 1);
+
+    CopiedEvent::reset();
+
+    dispatcher.dispatch_async(CopiedEvent(4)).get();
+    dispatcher.dispatch_async(CopiedEvent(5), [](std::exception_ptr) {});
+
+    REQUIRE(sum == 45);
+    REQUIRE(CopiedEvent::copiesCount == 0);
+
+    CopiedEvent event(6);
+
+    dispatcher.enqueue(event);
+    dispatcher.dispatch_async(event);
+
+    REQUIRE(dispatcher.process() == 1);
+    REQUIRE(sum == 81);
+    REQUIRE(CopiedEvent::copiesCount == 2);
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_lazy()
+{
+    typedef typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>,
+                                                   cws::events::TypesList<NumberedEvent, EventA>>::type  dispatcher_t;
+
+    dispatcher_t dispatcher;
+
+    size_t constructed = 0;
+    size_t sum         = 0;
+
+    auto const factory = [&constructed]()
+    {
+        ++constructed;
+
+        return NumberedEvent{ constructed };
+    };
+
+    REQUIRE(!dispatcher.template has_listeners<NumberedEvent>());
+
+    dispatcher.template dispatch_lazy<NumberedEvent>(factory);
+
+    REQUIRE(constructed == 0);
+
+    auto const connection = dispatcher.template connect<NumberedEvent>([&sum](NumberedEvent const &_event)
+    {
+        sum += _event.number;
+    });
+
+    REQUIRE( dispatcher.template has_listeners<NumberedEvent>());
+    REQUIRE(!dispatcher.template has_listeners<EventA>());
+
+    dispatcher.template dispatch_lazy<NumberedEvent>(factory);
+
+    REQUIRE(constructed == 1);
+    REQUIRE(sum == 1);
+
+    dispatcher.template connect<NumberedEvent>(0, [&sum](NumberedEvent const &_event)
+    {
+        sum += _event.number;
+    });
+
+    dispatcher.template remove_listener<NumberedEvent>(connection);
+
+    REQUIRE(dispatcher.template has_listeners<NumberedEvent>());
+
+    dispatcher_t movedDispatcher(std::move(dispatcher));
+
+    REQUIRE(!dispatcher.template has_listeners<NumberedEvent>());
+    REQUIRE( movedDispatcher.template has_listeners<NumberedEvent>());
+
+    movedDispatcher.template remove_listeners<NumberedEvent>(0);
+
+    REQUIRE(!movedDispatcher.template has_listeners<NumberedEvent>());
+
+    movedDispatcher.template dispatch_lazy<NumberedEvent>(factory);
+
+    REQUIRE(constructed == 1);
+    REQUIRE(sum == 1);
+}
+
+
+//==============================================================================================================================
+struct DelegateListener
+{
+    void on_event(NumberedEvent const &_event)
+    {
+        numbers.push_back(_event.number);
+    }
+
+    void on_const_event(NumberedEvent const &_event) const
+    {
+        numbers.push_back(_event.number * 10);
+    }
+
+    mutable std::vector<size_t> numbers;
+};
+
+
+//==============================================================================================================================
+struct DerivedDelegateListener :
+    EventA,
+    DelegateListener
+{
+};
+
+
+//==============================================================================================================================
+size_t g_delegateSum = 0;
+
+
+//==============================================================================================================================
+void on_delegate_event(NumberedEvent const &_event)
+{
+    g_delegateSum += _event.number;
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_delegates()
+{
+    typedef cws::events::Delegate<NumberedEvent>  delegate_t;
+
+    static_assert(std::is_trivially_copyable<delegate_t>::value, "Delegate must be trivially copyable.");
+
+    typedef typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>,
+                                                   cws::events::TypesList<NumberedEvent>>::type  dispatcher_t;
+
+    DelegateListener        first;
+    DelegateListener        second;
+    DelegateListener const &constFirst = first;
+
+    REQUIRE(delegate_t(&DelegateListener::on_event, &first) == delegate_t(&DelegateListener::on_event, &first));
+    REQUIRE(delegate_t(&DelegateListener::on_event, &first) != delegate_t(&DelegateListener::on_event, &second));
+    REQUIRE(delegate_t(&DelegateListener::on_event, &first) != delegate_t(&DelegateListener::on_const_event, &first));
+    REQUIRE(delegate_t(&DelegateListener::on_event, &first) != delegate_t(&on_delegate_event));
+    REQUIRE(delegate_t(&on_delegate_event) == delegate_t(&on_delegate_event));
+
+    dispatcher_t dispatcher;
+
+    dispatcher.template add_listener<NumberedEvent>(&DelegateListener::on_event, &first);
+    dispatcher.template add_listener<NumberedEvent>(&DelegateListener::on_event, &first);
+    dispatcher.template add_listener<NumberedEvent>(0, &DelegateListener::on_event, &second);
+    dispatcher.template add_listener<NumberedEvent>(&DelegateListener::on_const_event, &constFirst);
+
+    dispatcher.dispatch(NumberedEvent{ 1 });
+
+    REQUIRE(first.numbers  == std::vector<size_t>({ 1, 10 }));
+    REQUIRE(second.numbers == std::vector<size_t>({ 1 }));
+
+    dispatcher.template remove_listener<NumberedEvent>(&DelegateListener::on_event, &first);
+    dispatcher.template remove_listener<NumberedEvent>(&DelegateListener::on_event, &second);
+
+    dispatcher.dispatch(NumberedEvent{ 2 });
+
+    REQUIRE(first.numbers  == std::vector<size_t>({ 1, 10, 20 }));
+    REQUIRE(second.numbers == std::vector<size_t>({ 1 }));
+
+    dispatcher.remove_listeners();
+
+    DerivedDelegateListener derived;
+
+    dispatcher.template add_listener<NumberedEvent>(&DelegateListener::on_event, &derived);
+    dispatcher.template add_listener<NumberedEvent>(delegate_t(&on_delegate_event));
+
+    g_delegateSum = 0;
+
+    dispatcher.dispatch(NumberedEvent{ 3 });
+
+    REQUIRE(derived.numbers == std::vector<size_t>({ 3 }));
+    REQUIRE(g_delegateSum == 3);
+
+    dispatcher.template remove_listener<NumberedEvent>(&DelegateListener::on_event,
+                                                       static_cast<DelegateListener *>(&derived));
+    dispatcher.template remove_listener<NumberedEvent>(delegate_t(&on_delegate_event));
+
+    dispatcher.dispatch(NumberedEvent{ 4 });
+
+    REQUIRE(derived.numbers == std::vector<size_t>({ 3 }));
+    REQUIRE(g_delegateSum == 3);
+}
+
+
+//==============================================================================================================================
+// 
+// Memory arena counting allocations and deallocations made by CountingAllocator.
+// 
+struct Arena
+{
+    size_t allocations   = 0;
+    size_t deallocations = 0;
+};
+
+
+//==============================================================================================================================
+// 
+// Stateful allocator that is not default-constructible and allocates bypassing the global operator new.
+// 
+template <typename _Type>
+struct CountingAllocator
+{
+    typedef _Type  value_type;
+
+    explicit CountingAllocator(Arena *_arena) noexcept
+        : arena(_arena)
+    {
+    }
+
+    template <typename _Other>
+    CountingAllocator(CountingAllocator<_Other> const &_other) noexcept
+        : arena(_other.arena)
+    {
+    }
+
+    _Type *allocate(size_t _count)
+    {
+        ++arena->allocations;
+
+        if (void *pointer = std::malloc(_count * sizeof(_Type)))
+            return static_cast<_Type *>(pointer);
+
+        throw std::bad_alloc();
+    }
+
+    void deallocate(_Type *_pointer, size_t) noexcept
+    {
+        ++arena->deallocations;
+
+        std::free(_pointer);
+    }
+
+    template <typename _Other>
+    bool operator==(CountingAllocator<_Other> const &_other) const noexcept
+    {
+        return arena == _other.arena;
+    }
+
+    template <typename _Other>
+    bool operator!=(CountingAllocator<_Other> const &_other) const noexcept
+    {
+        return arena != _other.arena;
+    }
+
+    Arena *arena;
+};
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_move_only()
+{
+    typedef typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>,
+                                                   cws::events::TypesList<NumberedEvent>>::type  dispatcher_t;
+
+    dispatcher_t dispatcher;
+
+    size_t                  sum = 0;
+    std::unique_ptr<size_t> tens(new size_t(10));
+    std::unique_ptr<size_t> hundreds(new size_t(100));
+
+    auto const connection = dispatcher.template connect<NumberedEvent>(
+        [tens = std::move(tens), &sum](NumberedEvent const &_event)
+    {
+        sum += _event.number * *tens;
+    });
+
+    dispatcher.template connect<NumberedEvent>(0, [hundreds = std::move(hundreds), &sum](NumberedEvent const &_event)
+    {
+        sum += _event.number * *hundreds;
+    });
+
+    dispatcher.dispatch(NumberedEvent{ 1 });
+
+    REQUIRE(sum == 110);
+
+    dispatcher.template remove_listener<NumberedEvent>(connection);
+
+    dispatcher.dispatch(NumberedEvent{ 2 });
+
+    REQUIRE(sum == 310);
+}
+
+
+//==============================================================================================================================
+// 
+// Listener that does not fit into the default storage and counts its copies.
+// 
+struct LargeListener
+{
+    LargeListener(size_t *_copies)
+        : copies(_copies)
+    {
+    }
+
+    LargeListener(LargeListener const &_other)
+        : state (_other.state)
+        , copies(_other.copies)
+    {
+        ++*copies;
+    }
+
+    LargeListener(LargeListener &&) = default;
+
+    void operator()(NumberedEvent const &) const
+    {
+    }
+
+    std::array<size_t, 6>  state = {};
+    size_t                *copies;
+};
+
+
+//==============================================================================================================================
+// 
+// Returns the number of allocations made by subscribing several listeners made by the factory and dispatching an event to
+// them, after the storage of the listeners array has been reserved by subscribing and unsubscribing as many listeners. The
+// factory takes the sum that the listener adds event numbers to. The dispatcher must allocate by CountingAllocator, which
+// counts the allocations.
+// 
+template <typename _Dispatcher, typename _Factory>
+size_t count_subscribing_allocations(_Factory const &_make)
+{
+    size_t const LISTENERS_COUNT = 8;
+
+    Arena       arena;
+    _Dispatcher dispatcher(CountingAllocator<char>{ &arena });
+    size_t      sum = 0;
+
+    for (size_t i = 0; i != LISTENERS_COUNT; ++i)
+        dispatcher.template connect<NumberedEvent>(_make(sum));
+
+    dispatcher.remove_listeners();
+
+    size_t const allocationsCount = arena.allocations;
+
+    for (size_t i = 0; i != LISTENERS_COUNT; ++i)
+        dispatcher.template connect<NumberedEvent>(_make(sum));
+
+    dispatcher.dispatch(NumberedEvent{ 1 });
+
+    REQUIRE(sum == LISTENERS_COUNT);
+
+    return arena.allocations - allocationsCount;
+}
+
+
+//==============================================================================================================================
+enum class Severity
+{
+    TRACE,
+    INFO,
+    WARNING,
+    FATAL,
+};
+
+
+//==============================================================================================================================
+namespace cws
+{
+    namespace events
+    {
+        template <>
+        struct PriorityRange<Severity> :
+            PriorityBounds<Severity, Severity::TRACE, Severity::FATAL>
+        {
+        };
+    }
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_priority_range()
+{
+    using namespace cws::events;
+
+    typedef typename dispatcher::Type<PriorityType<Severity, std::greater<Severity>>, BackendType<_Backend>,
+                                      TypesList<NumberedEvent>>::type  dispatcher_t;
+
+    static_assert(PriorityRange<Severity>::bounded, "The range of severities is declared.");
+    static_assert(!PriorityRange<int>::bounded,     "The range of integers is not declared.");
+
+    dispatcher_t dispatcher;
+
+    std::vector<size_t> numbers;
+
+    auto const listener = [&numbers](size_t _number)
+    {
+        return [&numbers, _number](NumberedEvent const &)
+        {
+            numbers.push_back(_number);
+        };
+    };
+
+    dispatcher.template connect<NumberedEvent>(listener(7));
+    dispatcher.template connect<NumberedEvent>(Severity::INFO,    listener(4));
+    dispatcher.template connect<NumberedEvent>(Severity::FATAL,   listener(2));
+    dispatcher.template connect<NumberedEvent>(listener(1), Order::FRONT);
+    dispatcher.template connect<NumberedEvent>(Severity::TRACE,   listener(6));
+    dispatcher.template connect<NumberedEvent>(Severity::WARNING, listener(3));
+    dispatcher.template connect<NumberedEvent>(Severity::INFO,    listener(5));
+
+    dispatcher.dispatch(NumberedEvent{ 0 });
+
+    REQUIRE(numbers == std::vector<size_t>({ 1, 2, 3, 4, 5, 6, 7 }));
+
+    numbers.clear();
+
+    dispatcher.template remove_listeners<NumberedEvent>(Severity::INFO);
+    dispatcher.template connect<NumberedEvent>(Severity::WARNING, listener(0), Order::FRONT);
+
+    dispatcher.dispatch(NumberedEvent{ 0 });
+
+    REQUIRE(numbers == std::vector<size_t>({ 1, 2, 0, 3, 6, 7 }));
+
+    // 
+    // boost::signals2 orders priorities by the comparator, so any priority is accepted.
+    // 
+    if (std::is_same<_Backend, backend::Signals2>::value)
+        return;
+
+    Severity const above = static_cast<Severity>(static_cast<int>(Severity::FATAL) + 1);
+    Severity const below = static_cast<Severity>(static_cast<int>(Severity::TRACE) - 1);
+
+    REQUIRE_THROWS_AS(dispatcher.template connect<NumberedEvent>(above, listener(8)), std::out_of_range const &);
+    REQUIRE_THROWS_AS(dispatcher.template connect<NumberedEvent>(below, listener(9), Order::FRONT),
+                      std::out_of_range const &);
+
+    dispatcher.template remove_listeners<NumberedEvent>(above);
+
+    numbers.clear();
+
+    dispatcher.dispatch(NumberedEvent{ 0 });
+
+    REQUIRE(numbers == std::vector<size_t>({ 1, 2, 0, 3, 6, 7 }));
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_allocator()
+{
+    typedef CountingAllocator<char>  allocator_t;
+
+    typedef typename cws::events::dispatcher::Type<cws::events::BackendType<_Backend>,
+                                                   cws::events::AllocatorType<allocator_t>,
+                                                   cws::events::TypesList<NumberedEvent>>::type  dispatcher_t;
+
+    Arena arena;
+
+    {
+        dispatcher_t dispatcher(allocator_t{ &arena });
+
+        REQUIRE(dispatcher.get_allocator() == allocator_t(&arena));
+        REQUIRE(arena.allocations == 0);
+
+        std::array<size_t, 8> large = { { 10 } };
+        size_t                sum   = 0;
+
+        dispatcher.template connect<NumberedEvent>([&sum](NumberedEvent const &_event)
+        {
+            sum += _event.number;
+        });
+
+        size_t const allocationsCount = arena.allocations;
+
+        dispatcher.template connect<NumberedEvent>([large, &sum](NumberedEvent const &_event)
+        {
+            sum += _event.number * large[0];
+        });
+
+        // 
+        // boost::signals2 allocates its connections and slots by the global operator new.
+        // 
+        if (!std::is_same<_Backend, cws::events::backend::Signals2>::value)
+            REQUIRE(arena.allocations > allocationsCount);
+
+        dispatcher.enqueue(NumberedEvent{ 1 });
+        dispatcher.process();
+        dispatcher.dispatch(NumberedEvent{ 2 });
+
+        REQUIRE(sum == 33);
+
+        dispatcher_t moved(std::move(dispatcher));
+
+        moved.dispatch(NumberedEvent{ 3 });
+        moved.remove_listeners();
+
+        REQUIRE(sum == 66);
+        REQUIRE(arena.allocations != 0);
+    }
+
+    REQUIRE(arena.allocations == arena.deallocations);
+}
+
+
+//==============================================================================================================================
+std::vector<size_t> g_staticNumbers;
+
+
+//==============================================================================================================================
+template <size_t _Tag>
+void on_static_event(NumberedEvent const &_event)
+{
+    g_staticNumbers.push_back(_Tag * 100 + _event.number);
+}
+
+
+//==============================================================================================================================
+struct StaticFunctor
+{
+    void operator()(NumberedEvent const &_event) const
+    {
+        g_staticNumbers.push_back(900 + _event.number);
+    }
+
+    void operator()(EventA const &) const
+    {
+        g_staticNumbers.push_back(0);
+    }
+};
+
+
+//==============================================================================================================================
+struct StaticObject
+{
+    void on_event(NumberedEvent const &_event)
+    {
+        g_staticNumbers.push_back(800 + _event.number);
+
+        if (_event.number == 0)
+            throw _event.number;
+    }
+};
+
+StaticObject g_staticObject;
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_stats()
+{
+    using namespace cws::events;
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, StatsType<stats::Enabled>,
+                                      TypesList<NumberedEvent, EventA>>::type  dispatcher_t;
+
+    static_assert(std::is_same<typename dispatcher_t::stats_t, stats::Enabled>::value, "Statistics are enabled.");
+    static_assert(std::is_same<typename dispatcher::Type<TypesList<EventA>>::type::stats_t, stats::Disabled>::value,
+                  "Statistics are disabled by default.");
+
+    dispatcher_t dispatcher;
+
+    size_t sum = 0;
+
+    auto const listener = [&sum](NumberedEvent const &_event) { sum += _event.number; };
+
+    typename dispatcher_t::connection_t const connection = dispatcher.template connect<NumberedEvent>(listener);
+
+    dispatcher.template connect<NumberedEvent>(listener);
+
+    dispatcher.dispatch(NumberedEvent{ 1 });
+    dispatcher.template dispatch_lazy<NumberedEvent>([]() { return NumberedEvent{ 2 }; });
+    dispatcher.template dispatch_lazy<EventA>([]() { return EventA(); });
+
+    NumberedEvent const batch[] = { { 3 }, { 4 }, { 5 } };
+
+    dispatcher.dispatch_batch(std::begin(batch), std::end(batch));
+    dispatcher.template remove_listener<NumberedEvent>(connection);
+
+    std::thread thread([&dispatcher]() { dispatcher.dispatch(NumberedEvent{ 6 }); });
+
+    thread.join();
+
+    dispatcher.dispatch(EventA());
+    dispatcher.remove_listeners();
+
+    REQUIRE(sum == 36);
+
+    std::vector<stats::EventStats> const events = dispatcher.stats();
+
+    REQUIRE(events.size() == 2);
+
+    REQUIRE(events[0].name         == "NumberedEvent");
+    REQUIRE(events[0].dispatches   == 6);
+    REQUIRE(events[0].invocations  == 11);
+    REQUIRE(events[0].subscribes   == 2);
+    REQUIRE(events[0].unsubscribes == 2);
+    REQUIRE(events[0].latency.total() == 6);
+
+    REQUIRE(events[1].name         == "EventA");
+    REQUIRE(events[1].dispatches   == 1);
+    REQUIRE(events[1].invocations  == 0);
+    REQUIRE(events[1].subscribes   == 0);
+    REQUIRE(events[1].unsubscribes == 1);
+
+    dispatcher_t moved(std::move(dispatcher));
+
+    REQUIRE(moved.stats()[0].dispatches == 6);
+    REQUIRE(dispatcher.stats()[0].dispatches == 0);
+
+    REQUIRE(stats::Histogram::bucket(0)    == 0);
+    REQUIRE(stats::Histogram::bucket(7)    == 7);
+    REQUIRE(stats::Histogram::bucket(1000) == 35);
+    REQUIRE(stats::Histogram::lower_bound(35) == 896);
+    REQUIRE(stats::Histogram::bucket(~std::uint64_t(0)) == stats::Histogram::BUCKETS_COUNT - 1);
+
+    for (std::size_t i = 0; i != stats::Histogram::BUCKETS_COUNT; ++i)
+        REQUIRE(stats::Histogram::bucket(stats::Histogram::lower_bound(i)) == i);
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, StatsType<stats::Enabled>,
+                                      AllocatorType<CountingAllocator<char>>,
+                                      TypesList<NumberedEvent, EventA>>::type  counted_t;
+
+    Arena arena;
+
+    {
+        counted_t counted(CountingAllocator<char>{ &arena });
+
+        REQUIRE(arena.allocations == 0);
+
+        counted.dispatch(EventA());
+        counted.dispatch(EventA());
+
+        REQUIRE(arena.allocations == 1);
+        REQUIRE(counted.stats()[1].dispatches == 2);
+        REQUIRE(counted.stats()[0].dispatches == 0);
+    }
+
+    REQUIRE(arena.allocations == arena.deallocations);
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_top_listeners()
+{
+    using namespace cws::events;
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, StatsType<stats::Profiled>,
+                                      TypesList<NumberedEvent, EventA>>::type  dispatcher_t;
+
+    dispatcher_t dispatcher;
+
+    size_t sum = 0;
+
+    auto const slow = [&sum](NumberedEvent const &_event)
+    {
+        auto const until = std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+
+        while (std::chrono::steady_clock::now() < until)
+        {
+        }
+
+        sum += _event.number;
+    };
+
+    DelegateListener listener;
+
+    dispatcher.template connect<NumberedEvent>(stats::label("slow", slow));
+    dispatcher.template add_listener<NumberedEvent>(&DelegateListener::on_event, &listener);
+    dispatcher.template add_listener<NumberedEvent>(&DelegateListener::on_event, &listener);
+    dispatcher.template add_listener<EventA>(stats::label("fast", [](EventA const &) {}));
+
+    dispatcher.dispatch(NumberedEvent{ 1 });
+    dispatcher.dispatch(NumberedEvent{ 2 });
+    dispatcher.dispatch(EventA());
+
+    REQUIRE(sum == 3);
+    REQUIRE(listener.numbers == std::vector<size_t>({ 1, 2 }));
+
+    std::vector<stats::ListenerStats<typename dispatcher_t::connection_t>> top = dispatcher.top_listeners(10);
+
+    REQUIRE(top.size() == 3);
+
+    REQUIRE(top[0].label       == "slow");
+    REQUIRE(top[0].event       == "NumberedEvent");
+    REQUIRE(top[0].invocations == 2);
+    REQUIRE(top[0].max         >= 200000);
+    REQUIRE(top[0].total       >= 2 * top[0].max - top[0].total);
+    REQUIRE(top[0].p99         <= top[0].max);
+
+    REQUIRE(dispatcher.top_listeners(1).size() == 1);
+    REQUIRE(dispatcher.top_listeners(1)[0].label == "slow");
+
+    dispatcher.template remove_listener<NumberedEvent>(&DelegateListener::on_event, &listener);
+    dispatcher.dispatch(NumberedEvent{ 3 });
+
+    REQUIRE(listener.numbers == std::vector<size_t>({ 1, 2 }));
+    REQUIRE(dispatcher.stats()[0].invocations == 5);
+
+    top = dispatcher.top_listeners(10);
+
+    for (auto const &profile : top)
+    {
+        if (profile.label == "slow")
+            REQUIRE(profile.invocations == 3);
+        else if (profile.label == "fast")
+            REQUIRE(profile.invocations == 1);
+        else
+            REQUIRE(profile.invocations == 2);
+    }
+
+    dispatcher.template remove_listener<NumberedEvent>(top[0].connection);
+    dispatcher.dispatch(NumberedEvent{ 4 });
+
+    REQUIRE(sum == 6);
+
+    dispatcher.remove_listeners();
+    dispatcher.template add_listener<EventA>([](EventA const &) {});
+
+    REQUIRE(dispatcher.top_listeners(10).size() == 1);
+    REQUIRE(dispatcher.top_listeners(10)[0].label.find("lambda") != std::string::npos);
+}
+
+
+//==============================================================================================================================
+// 
+// Posts numbers from 1 to 6 to a channel holding 4 events, and returns the numbers dispatched by draining it.
+// 
+template <typename _Backend, typename _Producers = cws::events::producers::Multiple, typename _Overflow>
+std::vector<size_t> post_to_full_channel(_Overflow, std::vector<bool> &_posted, std::uint64_t &_dropped)
+{
+    using namespace cws::events;
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, TypesList<NumberedEvent, EventA>>::type  dispatcher_t;
+
+    dispatcher_t        dispatcher;
+    std::vector<size_t> numbers;
+
+    dispatcher.template connect<NumberedEvent>([&numbers](NumberedEvent const &_event) { numbers.push_back(_event.number); });
+
+    Channel<dispatcher_t, _Overflow, _Producers> channel(dispatcher, 3);
+
+    REQUIRE(channel.capacity() == 4);
+
+    for (size_t i = 1; i <= 6; ++i)
+        _posted.push_back(channel.try_post(NumberedEvent{ i }));
+
+    _dropped = channel.template dropped<NumberedEvent>();
+
+    REQUIRE(channel.template dropped<EventA>() == 0);
+    REQUIRE(channel.dropped() == _dropped);
+    REQUIRE(channel.drain() == 4);
+    REQUIRE(channel.drain() == 0);
+
+    return numbers;
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_channel()
+{
+    using namespace cws::events;
+
+    std::vector<bool> posted;
+    std::uint64_t     dropped = 0;
+
+    REQUIRE(post_to_full_channel<_Backend>(overflow::DropNewest(), posted, dropped) == std::vector<size_t>({ 1, 2, 3, 4 }));
+    REQUIRE(posted == std::vector<bool>({ true, true, true, true, false, false }));
+    REQUIRE(dropped == 2);
+
+    posted.clear();
+
+    REQUIRE(post_to_full_channel<_Backend>(overflow::DropOldest(), posted, dropped) == std::vector<size_t>({ 3, 4, 5, 6 }));
+    REQUIRE(posted == std::vector<bool>(6, true));
+    REQUIRE(dropped == 2);
+
+    posted.clear();
+
+    REQUIRE(post_to_full_channel<_Backend>(overflow::Overwrite(), posted, dropped) == std::vector<size_t>({ 1, 2, 3, 6 }));
+    REQUIRE(posted == std::vector<bool>(6, true));
+    REQUIRE(dropped == 2);
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, TypesList<NumberedEvent, EventA>>::type  dispatcher_t;
+
+    dispatcher_t dispatcher;
+
+    size_t sum    = 0;
+    size_t events = 0;
+
+    dispatcher.template connect<NumberedEvent>([&sum](NumberedEvent const &_event) { sum += _event.number; });
+    dispatcher.template connect<EventA>([&events](EventA const &) { ++events; });
+
+    {
+        Channel<dispatcher_t> channel(dispatcher, 16);
+
+        size_t const PRODUCERS_COUNT = 4;
+        size_t const POSTS_COUNT     = 10000;
+
+        std::vector<std::thread> producers;
+
+        for (size_t i = 0; i != PRODUCERS_COUNT; ++i)
+        {
+            producers.emplace_back([&channel, POSTS_COUNT]()
+            {
+                for (size_t j = 1; j <= POSTS_COUNT; ++j)
+                {
+                    channel.try_post(NumberedEvent{ j });
+                    channel.try_post(EventA());
+                }
+            });
+        }
+
+        size_t drained = 0;
+
+        while (drained != 2 * PRODUCERS_COUNT * POSTS_COUNT)
+            drained += channel.drain(100);
+
+        for (auto &producer : producers)
+            producer.join();
+
+        REQUIRE(sum    == PRODUCERS_COUNT * POSTS_COUNT * (POSTS_COUNT + 1) / 2);
+        REQUIRE(events == PRODUCERS_COUNT * POSTS_COUNT);
+        REQUIRE(channel.dropped() == 0);
+
+        channel.try_post(EventA());
+    }
+
+    REQUIRE(events == 40000);
+
+    auto const tracker = std::make_shared<int>(0);
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, TypesList<std::shared_ptr<int>>>::type  pointers_t;
+
+    pointers_t pointers;
+
+    {
+        Channel<pointers_t, overflow::DropOldest> channel(pointers, 2);
+
+        for (size_t i = 0; i != 3; ++i)
+            channel.try_post(tracker);
+
+        REQUIRE(tracker.use_count() == 3);
+    }
+
+    REQUIRE(tracker.use_count() == 1);
+}
+
+
+//==============================================================================================================================
+template <typename _Backend>
+void check_single_producer_channel()
+{
+    using namespace cws::events;
+
+    std::vector<bool> posted;
+    std::uint64_t     dropped = 0;
+
+    std::vector<size_t> const numbers = post_to_full_channel<_Backend, producers::Single>(overflow::DropNewest(),
+                                                                                           posted,
+                                                                                           dropped);
+
+    REQUIRE(numbers == std::vector<size_t>({ 1, 2, 3, 4 }));
+    REQUIRE(posted == std::vector<bool>({ true, true, true, true, false, false }));
+    REQUIRE(dropped == 2);
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, TypesList<NumberedEvent, EventA>>::type  dispatcher_t;
+
+    dispatcher_t dispatcher;
+
+    size_t sum    = 0;
+    size_t events = 0;
+
+    dispatcher.template connect<NumberedEvent>([&sum](NumberedEvent const &_event) { sum += _event.number; });
+    dispatcher.template connect<EventA>([&events](EventA const &) { ++events; });
+
+    {
+        Channel<dispatcher_t, overflow::Block, producers::Single> channel(dispatcher, 16);
+
+        size_t const POSTS_COUNT = 40000;
+
+        std::thread producer([&channel, POSTS_COUNT]()
+        {
+            for (size_t i = 1; i <= POSTS_COUNT; ++i)
+            {
+                channel.try_post(NumberedEvent{ i });
+                channel.try_post(EventA());
+            }
+        });
+
+        size_t drained = 0;
+
+        while (drained != 2 * POSTS_COUNT)
+            drained += channel.drain(100);
+
+        producer.join();
+
+        REQUIRE(sum    == POSTS_COUNT * (POSTS_COUNT + 1) / 2);
+        REQUIRE(events == POSTS_COUNT);
+        REQUIRE(channel.dropped() == 0);
+    }
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, TypesList<NumberedEvent>>::type  numbers_t;
+
+    numbers_t           dispatcherOfNumbers;
+    std::vector<size_t> received;
+
+    dispatcherOfNumbers.template connect<NumberedEvent>([&received](NumberedEvent const &_event)
+    {
+        if (_event.number == 2)
+            throw _event.number;
+
+        received.push_back(_event.number);
+    });
+
+    auto const tracker = std::make_shared<int>(0);
+
+    typedef typename dispatcher::Type<BackendType<_Backend>, TypesList<std::shared_ptr<int>>>::type  pointers_t;
+
+    pointers_t pointers;
+
+    {
+        Channel<numbers_t, overflow::Block, producers::Single> channel(dispatcherOfNumbers, 4);
+
+        for (size_t i = 1; i <= 4; ++i)
+            REQUIRE(channel.try_post(NumberedEvent{ i }));
+
+        REQUIRE_THROWS_AS(channel.drain(), size_t);
+        REQUIRE(received == std::vector<size_t>({ 1 }));
+
+        REQUIRE(channel.try_post(NumberedEvent{ 5 }));
+        REQUIRE(channel.try_post(NumberedEvent{ 6 }));
+        REQUIRE(channel.drain() == 4);
+        REQUIRE(received == std::vector<size_t>({ 1, 3, 4, 5, 6 }));
+
+        Channel<pointers_t, overflow::DropNewest, producers::Single> pending(pointers, 2);
+
+        for (size_t i = 0; i != 3; ++i)
+            pending.try_post(tracker);
+
+        REQUIRE(tracker.use_count() == 3);
+    }
+
+    REQUIRE(tracker.use_count() == 1);
+}